@@ -249,7 +249,7 @@ TAnimModel::TAnimModel( scene::node_data const &Nodedata ) : basic_node( Nodedat
     m_lightopacities.fill( 1.f );
 }
 
-bool TAnimModel::Init(std::string const &asName, std::string const &asReplacableTexture)
+bool TAnimModel::Init(std::string const &asName, std::string const &asReplacableTexture, bool const Loadnow)
 {
     if( asReplacableTexture.substr( 0, 1 ) == "*" ) {
         // od gwiazdki zaczynają się teksty na wyświetlaczach
@@ -262,7 +262,7 @@ bool TAnimModel::Init(std::string const &asName, std::string const &asReplacable
 // TODO: redo the random timer initialization
 //    fBlinkTimer = Random() * ( fOnTime + fOffTime );
 
-    pModel = TModelsManager::GetModel( asName );
+    pModel = TModelsManager::GetModel( asName, false, true, 0, Loadnow );
     return ( pModel != nullptr );
 }
 
@@ -276,13 +276,13 @@ TAnimModel::is_keyword( std::string const &Token ) const {
         || ( Token == "notransition" );
 }
 
-bool TAnimModel::Load(cParser *parser, bool ter)
+bool TAnimModel::Load(cParser *parser, bool ter, bool const Loadnow)
 { // rozpoznanie wpisu modelu i ustawienie świateł
 	std::string name = parser->getToken<std::string>();
 	std::string texture = parser->getToken<std::string>(false);
     replace_slashes( name );
     replace_slashes( texture );
-    if (!Init( name, texture ))
+    if (!Init( name, texture, Loadnow ))
     {
         if (name != "notload")
         { // gdy brak modelu
@@ -302,26 +302,8 @@ bool TAnimModel::Load(cParser *parser, bool ter)
     }
     else
     { // wiązanie świateł, o ile model wczytany
-        LightsOn[0] = pModel->GetFromName("Light_On00");
-        LightsOn[1] = pModel->GetFromName("Light_On01");
-        LightsOn[2] = pModel->GetFromName("Light_On02");
-        LightsOn[3] = pModel->GetFromName("Light_On03");
-        LightsOn[4] = pModel->GetFromName("Light_On04");
-        LightsOn[5] = pModel->GetFromName("Light_On05");
-        LightsOn[6] = pModel->GetFromName("Light_On06");
-        LightsOn[7] = pModel->GetFromName("Light_On07");
-        LightsOff[0] = pModel->GetFromName("Light_Off00");
-        LightsOff[1] = pModel->GetFromName("Light_Off01");
-        LightsOff[2] = pModel->GetFromName("Light_Off02");
-        LightsOff[3] = pModel->GetFromName("Light_Off03");
-        LightsOff[4] = pModel->GetFromName("Light_Off04");
-        LightsOff[5] = pModel->GetFromName("Light_Off05");
-        LightsOff[6] = pModel->GetFromName("Light_Off06");
-        LightsOff[7] = pModel->GetFromName("Light_Off07");
+        BindLights();
     }
-    for (int i = 0; i < iMaxNumLights; ++i)
-        if (LightsOn[i] || LightsOff[i]) // Ra: zlikwidowałem wymóg istnienia obu
-            iNumLights = i + 1;
 
     std::string token;
     do {
@@ -375,6 +357,35 @@ bool TAnimModel::Load(cParser *parser, bool ter)
     return true;
 }
 
+// binds instance lights to light submodels of the model
+void TAnimModel::BindLights()
+{
+    if( ( pModel == nullptr )
+     || ( true == pModel->is_loading() ) ) {
+        return;
+    }
+    LightsOn[0] = pModel->GetFromName("Light_On00");
+    LightsOn[1] = pModel->GetFromName("Light_On01");
+    LightsOn[2] = pModel->GetFromName("Light_On02");
+    LightsOn[3] = pModel->GetFromName("Light_On03");
+    LightsOn[4] = pModel->GetFromName("Light_On04");
+    LightsOn[5] = pModel->GetFromName("Light_On05");
+    LightsOn[6] = pModel->GetFromName("Light_On06");
+    LightsOn[7] = pModel->GetFromName("Light_On07");
+    LightsOff[0] = pModel->GetFromName("Light_Off00");
+    LightsOff[1] = pModel->GetFromName("Light_Off01");
+    LightsOff[2] = pModel->GetFromName("Light_Off02");
+    LightsOff[3] = pModel->GetFromName("Light_Off03");
+    LightsOff[4] = pModel->GetFromName("Light_Off04");
+    LightsOff[5] = pModel->GetFromName("Light_Off05");
+    LightsOff[6] = pModel->GetFromName("Light_Off06");
+    LightsOff[7] = pModel->GetFromName("Light_Off07");
+
+    for (int i = 0; i < iMaxNumLights; ++i)
+        if (LightsOn[i] || LightsOff[i]) // Ra: zlikwidowałem wymóg istnienia obu
+            iNumLights = i + 1;
+}
+
 std::shared_ptr<TAnimContainer> TAnimModel::AddContainer(std::string const &Name)
 { // dodanie sterowania submodelem dla egzemplarza
     if (!pModel)
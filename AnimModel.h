@@ -112,8 +112,10 @@ public:
     explicit TAnimModel( scene::node_data const &Nodedata );
 // methods
     static void AnimUpdate( double dt );
-    bool Init(std::string const &asName, std::string const &asReplacableTexture);
-    bool Load(cParser *parser, bool ter = false);
+    bool Init(std::string const &asName, std::string const &asReplacableTexture, bool const Loadnow = true);
+    bool Load(cParser *parser, bool ter = false, bool const Loadnow = true);
+    // binds instance lights to light submodels of the model. NOTE: models loaded in the background need it done once they're ready
+    void BindLights();
 	std::shared_ptr<TAnimContainer> AddContainer(std::string const &Name);
 	std::shared_ptr<TAnimContainer> GetContainer(std::string const &Name = "");
 	void LightSet( int const n, float const v );
@@ -44,6 +44,7 @@ class train_table;
 struct light_array;
 class particle_manager;
 struct dictionary_source;
+struct dictionary_layout;
 class trainset_desc;
 class scenery_desc;
 
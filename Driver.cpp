@@ -287,6 +287,11 @@ void TSpeedPos::CommandCheck()
         // potentially it can invalidate shunt semaphor used to transmit timetable or similar command
         iFlags &= ~(spShuntSemaphor | spPassengerStopPoint | spStopOnSBL);
     }
+    // remember the outcome, so the check can be skipped until something changes
+    m_checkedrevision = evEvent->input_revision();
+    m_checkedflags = iFlags;
+    m_checkedvelocity = fVelNext;
+    m_checkedsectiondist = fSectionVelocityDist;
 };
 
 bool TSpeedPos::Update()
@@ -338,9 +343,14 @@ bool TSpeedPos::Update()
         if( ( ( iFlags & spElapsed ) == 0 )
          || ( fVelNext == 0.0 ) ) {
             // ignore already passed signals, but keep an eye on overrun stops
-            // odczyt komórki pamięci najlepiej by było zrobić jako notyfikację,
-            // czyli zmiana komórki wywoła jakąś podaną funkcję
-            CommandCheck(); // sprawdzenie typu komendy w evencie i określenie prędkości
+            // the memory cell content is read again only if the cell was changed since the last check,
+            // or if the entry was modified by the controller in the meantime
+            if( ( evEvent->input_revision() != m_checkedrevision )
+             || ( iFlags != m_checkedflags )
+             || ( fVelNext != m_checkedvelocity )
+             || ( fSectionVelocityDist != m_checkedsectiondist ) ) {
+                CommandCheck(); // sprawdzenie typu komendy w evencie i określenie prędkości
+            }
         }
     }
     return false;
@@ -498,6 +508,98 @@ bool TController::TableNotFound(basic_event const *Event, double const Distance
      || ( Distance - lookup->fDist > 100.0 ) );
 };
 
+namespace {
+
+// stretch of plain track pieces, which route scans can pass without inspecting each piece individually.
+// plain piece is a straight, ordinary track without events for the scan direction, special properties or change of speed limit
+struct track_run {
+
+    struct run_member {
+        TTrack *track;
+        double direction; // scan direction on the piece
+        double distance; // distance from start of the run to start of the piece
+    };
+
+    std::vector<run_member> members;
+};
+
+// shared collection of track runs, keyed by first piece and scan direction
+class track_run_cache {
+
+public:
+// methods
+    // provides run beginning with specified piece, scanned in specified direction. returns: run, empty if the piece isn't plain
+    track_run const &
+        find( TTrack *Track, double const Direction );
+
+private:
+// methods
+    // checks whether specified piece of the path graph can be passed by the scan without adding anything to the speed table
+    static
+    bool
+        is_plain( path_graph const &Graph, std::int32_t const Id, double const Direction, double const Velocity );
+// members
+    std::unordered_map<std::uintptr_t, track_run> m_runs;
+    std::uint32_t m_revision { 0 }; // revision of track data the runs were built for
+};
+
+std::size_t const trackrunmaxsize { 128 }; // limit for number of pieces in single run
+
+track_run const &
+track_run_cache::find( TTrack *Track, double const Direction ) {
+
+    if( m_revision != TTrack::scan_revision() ) {
+        // connections, speed limits or events were changed since the runs were built
+        m_runs.clear();
+        m_revision = TTrack::scan_revision();
+    }
+
+    auto const key { reinterpret_cast<std::uintptr_t>( Track ) | ( Direction > 0 ? 1 : 0 ) };
+    auto lookup { m_runs.find( key ) };
+    if( lookup != m_runs.end() ) {
+        return lookup->second;
+    }
+
+    auto &run { m_runs[ key ] };
+    // runs are traced through compiled path graph, pieces outside of it are treated as not plain
+    auto const &graph { simulation::Paths.graph() };
+    auto const velocity { Track->VelocityGet() };
+    auto const first { graph.id( Track ) };
+    auto id { first };
+    auto direction { Direction };
+    auto distance { 0.0 };
+    while( ( id != path_graph::none )
+        && ( run.members.size() < trackrunmaxsize )
+        && ( true == is_plain( graph, id, direction, velocity ) ) ) {
+
+        run.members.push_back( { graph.path( id ), direction, distance } );
+        distance += graph.length( id );
+        id = graph.connected( id, direction );
+        if( id == first ) {
+            // looped track
+            break;
+        }
+    }
+    return run;
+}
+
+bool
+track_run_cache::is_plain( path_graph const &Graph, std::int32_t const Id, double const Direction, double const Velocity ) {
+
+    auto const flags { Graph.flags( Id ) };
+    if( ( ( flags & ( path_graph::normal | path_graph::straight | path_graph::action ) ) != ( path_graph::normal | path_graph::straight ) )
+     || ( ( flags & ( Direction > 0 ? path_graph::events2 : path_graph::events1 ) ) != 0 ) ) {
+        return false;
+    }
+    auto const pathvelocity { Graph.path( Id )->VelocityGet() };
+    return ( ( pathvelocity != 0.0 )
+          && ( pathvelocity == Velocity ) );
+}
+
+track_run_cache TrackRuns;
+
+} // namespace
+
 void TController::TableTraceRoute(double fDistance, TDynamicObject *pVehicle)
 { // skanowanie trajektorii na odległość (fDistance) od (pVehicle) w kierunku przodu składu i
     // uzupełnianie tabelki
@@ -591,6 +693,29 @@ void TController::TableTraceRoute(double fDistance, TDynamicObject *pVehicle)
     {
         if (pTrack != tLast) // ostatni zapisany w tabelce nie był jeszcze sprawdzony
         { // jeśli tor nie był jeszcze sprawdzany
+            if( ( false == TestFlag( Global.iWriteLogEnabled, 8 ) )
+             && ( pTrack->VelocityGet() == fLastVel )
+             && ( ( tLast == nullptr )
+               || ( tLast->fRadius == 0.0 ) ) ) {
+                // pass a stretch of plain track in one step, up to the last piece the scan would reach.
+                // the last piece is left for regular processing, as it may connect to something significant
+                auto const &run { TrackRuns.find( pTrack, fLastDir ) };
+                if( run.members.size() > 1 ) {
+                    auto const last { std::prev(
+                        std::lower_bound(
+                            std::next( std::begin( run.members ) ), std::end( run.members ),
+                            fDistance - fCurrentDistance,
+                            []( track_run::run_member const &Member, double const Distance ) {
+                                return Member.distance < Distance; } ) ) };
+                    if( last != std::begin( run.members ) ) {
+                        tLast = std::prev( last )->track;
+                        pTrack = last->track;
+                        fLastDir = last->direction;
+                        fCurrentDistance += last->distance;
+                        fTrackLength = pTrack->Length();
+                    }
+                }
+            }
             if( Global.iWriteLogEnabled & 8 ) {
                 WriteLog( "Speed table for " + OwnerName() + " tracing through track " + pTrack->name() );
             }
@@ -5407,23 +5532,26 @@ TTrack * TController::BackwardTraceRoute(double &fDistance, double &fDirection,
         fDistance = s; // to na tym torze stoimy
         return Track;
     }
+    // the scan follows compiled path graph, pieces created after its compilation are resolved through the paths themselves
+    auto const &graph { simulation::Paths.graph() };
+    auto trackid { graph.id( Track ) };
     TTrack *pTrackFrom; // odcinek poprzedni, do znajdywania końca dróg
     while (s < fDistance)
     {
         // Track->ScannedFlag=true; //do pokazywania przeskanowanych torów
         pTrackFrom = Track; // zapamiętanie aktualnego odcinka
         s += fCurrentDistance; // doliczenie kolejnego odcinka do przeskanowanej długości
-        if (fDirection > 0)
-        { // jeśli szukanie od Point1 w kierunku Point2
-            if (Track->iNextDirection)
-                fDirection = -fDirection;
-            Track = Track->CurrentNext(); // może być NULL
-        }
-        else // if (fDirection<0)
-        { // jeśli szukanie od Point2 w kierunku Point1
-            if (!Track->iPrevDirection)
-                fDirection = -fDirection;
-            Track = Track->CurrentPrev(); // może być NULL
+        auto const direction { fDirection };
+        if( trackid != path_graph::none ) {
+            trackid = graph.connected( trackid, fDirection );
+        }
+        if( trackid != path_graph::none ) {
+            Track = graph.path( trackid );
+        }
+        else {
+            fDirection = direction;
+            Track = Track->Connected( ( fDirection > 0 ? 1 : -1 ), fDirection ); // może być NULL
+            trackid = graph.id( Track );
         }
         if (Track == pTrackFrom)
             Track = nullptr; // koniec, tak jak dla torów
@@ -5443,7 +5571,7 @@ TTrack * TController::BackwardTraceRoute(double &fDistance, double &fDirection,
             fDistance = s;
             return nullptr;
         }
-        fCurrentDistance = Track->Length();
+        fCurrentDistance = ( trackid != path_graph::none ? graph.length( trackid ) : Track->Length() );
         if ((Event = CheckTrackEventBackward(fDirection, Track, Vehicle, Eventdirection, End)) != nullptr)
         { // znaleziony tor z eventem
             fDistance = s;
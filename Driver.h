@@ -162,6 +162,13 @@ class TSpeedPos
     };
     void CommandCheck();
 
+  private:
+    // state of the entry after last command check, re-check is needed only if either the input or the entry changed since
+    std::uint32_t m_checkedrevision{ 0 };
+    int m_checkedflags{ spNone };
+    double m_checkedvelocity{ -1.0 };
+    double m_checkedsectiondist{ 0.0 };
+
   public:
     TSpeedPos(TTrack *track, double dist, int flag);
     TSpeedPos(basic_event *event, double dist, double length, TOrders order);
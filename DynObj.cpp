@@ -23,6 +23,7 @@ http://mozilla.org/MPL/2.0/.
 #include "Globals.h"
 #include "Timer.h"
 #include "Logs.h"
+#include "sn_utils.h"
 #include "Console.h"
 #include "Traction.h"
 #include "sound.h"
@@ -177,7 +178,7 @@ material_data::assign( std::string const &Replacableskin ) {
         int skinindex = 0;
         std::string texturename; nameparser >> texturename;
         while( ( texturename != "" ) && ( skinindex < 4 ) ) {
-            replacable_skins[ skinindex + 1 ] = GfxRenderer->Fetch_Material( texturename );
+            replacable_skins[ skinindex + 1 ] = GfxRenderer->Fetch_Material( texturename, false );
             ++skinindex;
             texturename = ""; nameparser >> texturename;
         }
@@ -192,18 +193,18 @@ material_data::assign( std::string const &Replacableskin ) {
             auto const material { TextureTest( ToLower( Replacableskin + "," + std::to_string( skinindex + 1 ) ) ) };
             if( true == material.empty() ) { break; }
 
-            replacable_skins[ skinindex + 1 ] = GfxRenderer->Fetch_Material( material );
+            replacable_skins[ skinindex + 1 ] = GfxRenderer->Fetch_Material( material, false );
             ++skinindex;
         } while( skinindex < 4 );
         multi_textures = skinindex;
         if( multi_textures == 0 ) {
             // zestaw nie zadziałał, próbujemy normanie
-            replacable_skins[ 1 ] = GfxRenderer->Fetch_Material( Replacableskin );
+            replacable_skins[ 1 ] = GfxRenderer->Fetch_Material( Replacableskin, false );
         }
     }
     if( replacable_skins[ 1 ] == null_handle ) {
         // last ditch attempt, check for single replacable skin texture
-        replacable_skins[ 1 ] = GfxRenderer->Fetch_Material( Replacableskin );
+        replacable_skins[ 1 ] = GfxRenderer->Fetch_Material( Replacableskin, false );
     }
 
     // BUGS! it's not entierly designed whether opacity is property of material or submodel,
@@ -1489,6 +1490,9 @@ int TDynamicObject::Dettach(int dir)
             d = d->Next(); // i w drugą stronę
         }
     }
+    if( MoverParameters->Neighbours[ dir ].vehicle != nullptr ) {
+        MoverParameters->Neighbours[ dir ].vehicle->wake();
+    }
     if( MoverParameters->Couplers[ dir ].CouplingFlag ) {
         // odczepianie, o ile coś podłączone
         MoverParameters->Dettach( dir );
@@ -1515,6 +1519,7 @@ TDynamicObject::couple( int const Side ) {
     auto const &coupler { MoverParameters->Couplers[ Side ] };
     auto *othervehicle { neighbour.vehicle };
     auto *othervehicleparams{ othervehicle->MoverParameters };
+    othervehicle->wake();
     auto const &othercoupler { othervehicleparams->Couplers[ neighbour.vehicle_end ] };
 
     if( coupler.CouplingFlag == coupling::faux ) {
@@ -1656,7 +1661,8 @@ TDynamicObject::attach_coupler_adapter( int const Side, bool const Enforce ) {
     coupler.adapter_height = adapterdata.position.y;
     // audio flag, visuals update
     coupler.sounds |= sound::attachadapter;
-    m_coupleradapters[ Side ] = TModelsManager::GetModel( adapterdata.model );
+    // the adapter is a plain model, so it can be shown whenever it's done loading
+    m_coupleradapters[ Side ] = TModelsManager::GetModel( adapterdata.model, false, true, 0, false );
 
     return true;
 }
@@ -2472,120 +2478,124 @@ void TDynamicObject::Move(double fDistance)
         bEnabled &= Axle0.Move(fDistance, iAxleFirst == 0); // oś z przodu pojazdu
     }
     if (fDistance != 0.0) // nie liczyć ponownie, jeśli stoi
-    { // liczenie pozycji pojazdu tutaj, bo jest używane w wielu miejscach
-        vPosition = 0.5 * (Axle1.pPosition + Axle0.pPosition); //środek między skrajnymi osiami
-        vFront = Axle0.pPosition - Axle1.pPosition; // wektor pomiędzy skrajnymi osiami
-        // Ra 2F1J: to nie jest stabilne (powoduje rzucanie taborem) i wymaga
-        // dopracowania
-        fAdjustment = vFront.Length() - fAxleDist; // na łuku będzie ujemny
-        // if (fabs(fAdjustment)>0.02) //jeśli jest zbyt dużo, to rozłożyć na kilka przeliczeń (wygasza drgania?)
-        //{//parę centymetrów trzeba by już skorygować; te błędy mogą się też
-        // generować na ostrych łukach
-        // fAdjustment*=0.5; //w jednym kroku korygowany jest ułamek błędu
-        //}
-        // else
-        // fAdjustment=0.0;
-        vFront = Normalize(vFront); // kierunek ustawienia pojazdu (wektor jednostkowy)
-        vLeft = Normalize(CrossProduct(vWorldUp, vFront)); // wektor poziomy w lewo,
-        // normalizacja potrzebna z powodu pochylenia (vFront)
-        vUp = CrossProduct(vFront, vLeft); // wektor w górę, będzie jednostkowy
-        modelRot.z = atan2(-vFront.x, vFront.z); // kąt obrotu pojazdu [rad]; z ABuBogies()
-        auto const roll { Roll() }; // suma przechyłek
-        if (roll != 0.0)
-        { // wyznaczanie przechylenia tylko jeśli jest przechyłka
-            // można by pobrać wektory normalne z toru...
-            mMatrix.Identity(); // ta macierz jest potrzebna głównie do wyświetlania
-            mMatrix.Rotation(roll * 0.5, vFront); // obrót wzdłuż osi o przechyłkę
-            vUp = mMatrix * vUp; // wektor w górę pojazdu (przekręcenie na przechyłce)
-            // vLeft=mMatrix*DynamicObject->vLeft;
-            // vUp=CrossProduct(vFront,vLeft); //wektor w górę
-            // vLeft=Normalize(CrossProduct(vWorldUp,vFront)); //wektor w lewo
-            vLeft = Normalize(CrossProduct(vUp, vFront)); // wektor w lewo
-            // vUp=CrossProduct(vFront,vLeft); //wektor w górę
-        }
-        mMatrix.Identity(); // to też można by od razu policzyć, ale potrzebne jest do wyświetlania
-        mMatrix.BasisChange(vLeft, vUp, vFront); // przesuwanie jest jednak rzadziej niż renderowanie
-        mMatrix = Inverse(mMatrix); // wyliczenie macierzy dla pojazdu (potrzebna tylko do wyświetlania?)
-        // if (MoverParameters->CategoryFlag&2)
-        { // przesunięcia są używane po wyrzuceniu pociągu z toru
-            vPosition.x += MoverParameters->OffsetTrackH * vLeft.x; // dodanie przesunięcia w bok
-            vPosition.z += MoverParameters->OffsetTrackH * vLeft.z; // vLeft jest wektorem poprzecznym
-            // if () na przechyłce będzie dodatkowo zmiana wysokości samochodu
-            vPosition.y += MoverParameters->OffsetTrackV; // te offsety są liczone przez moverparam
-        }
-        // obliczanie pozycji sprzęgów do liczenia zderzeń
-        auto dir = (0.5 * MoverParameters->Dim.L) * vFront; // wektor sprzęgu
-        vCoulpler[end::front] = vPosition + dir; // współrzędne sprzęgu na początku
-        vCoulpler[end::rear] = vPosition - dir; // współrzędne sprzęgu na końcu
-        // bCameraNear=
-        // if (bCameraNear) //jeśli istotne są szczegóły (blisko kamery)
-        { // przeliczenie cienia
-            TTrack *t0 = Axle0.GetTrack(); // już po przesunięciu
-            TTrack *t1 = Axle1.GetTrack();
-            if ((t0->eEnvironment == e_flat) && (t1->eEnvironment == e_flat)) // może być e_bridge...
-                fShade = 0.0; // standardowe oświetlenie
-            else
-            { // jeżeli te tory mają niestandardowy stopień zacienienia
-                // (e_canyon, e_tunnel)
-                if (t0->eEnvironment == t1->eEnvironment)
-                {
-                    switch (t0->eEnvironment)
-                    { // typ zmiany oświetlenia
-                    case e_canyon:
-                        fShade = 0.65f;
-                        break; // zacienienie w kanionie
-                    case e_tunnel:
-                        fShade = 0.20f;
-                        break; // zacienienie w tunelu
-                    }
-                }
-                else // dwa różne
-                { // liczymy proporcję
-                    double d = Axle0.GetTranslation(); // aktualne położenie na torze
-                    if (Axle0.GetDirection() < 0)
-                        d = t0->Length() - d; // od drugiej strony liczona długość
-                    d /= fAxleDist; // rozsataw osi procentowe znajdowanie się na torze
-
-                    float shadefrom = 1.0f, shadeto = 1.0f;
-                    // NOTE, TODO: calculating brightness level is used enough times to warrant encapsulation into a function
-                    switch( t0->eEnvironment ) {
-                        case e_canyon: { shadeto = 0.65f; break; }
-                        case e_tunnel: { shadeto = 0.2f; break; }
-                        default: {break; }
-                    }
-                    switch( t1->eEnvironment ) {
-                        case e_canyon: { shadefrom = 0.65f; break; }
-                        case e_tunnel: { shadefrom = 0.2f; break; }
-                        default: {break; }
-                    }
-                    fShade = interpolate( shadefrom, shadeto, static_cast<float>( d ) );
+        update_placement(); // liczenie pozycji pojazdu tutaj, bo jest używane w wielu miejscach
+};
+
+// calculates vehicle placement and orientation from current location of its axles
+void TDynamicObject::update_placement()
+{
+    vPosition = 0.5 * (Axle1.pPosition + Axle0.pPosition); //środek między skrajnymi osiami
+    vFront = Axle0.pPosition - Axle1.pPosition; // wektor pomiędzy skrajnymi osiami
+    // Ra 2F1J: to nie jest stabilne (powoduje rzucanie taborem) i wymaga
+    // dopracowania
+    fAdjustment = vFront.Length() - fAxleDist; // na łuku będzie ujemny
+    // if (fabs(fAdjustment)>0.02) //jeśli jest zbyt dużo, to rozłożyć na kilka przeliczeń (wygasza drgania?)
+    //{//parę centymetrów trzeba by już skorygować; te błędy mogą się też
+    // generować na ostrych łukach
+    // fAdjustment*=0.5; //w jednym kroku korygowany jest ułamek błędu
+    //}
+    // else
+    // fAdjustment=0.0;
+    vFront = Normalize(vFront); // kierunek ustawienia pojazdu (wektor jednostkowy)
+    vLeft = Normalize(CrossProduct(vWorldUp, vFront)); // wektor poziomy w lewo,
+    // normalizacja potrzebna z powodu pochylenia (vFront)
+    vUp = CrossProduct(vFront, vLeft); // wektor w górę, będzie jednostkowy
+    modelRot.z = atan2(-vFront.x, vFront.z); // kąt obrotu pojazdu [rad]; z ABuBogies()
+    auto const roll { Roll() }; // suma przechyłek
+    if (roll != 0.0)
+    { // wyznaczanie przechylenia tylko jeśli jest przechyłka
+        // można by pobrać wektory normalne z toru...
+        mMatrix.Identity(); // ta macierz jest potrzebna głównie do wyświetlania
+        mMatrix.Rotation(roll * 0.5, vFront); // obrót wzdłuż osi o przechyłkę
+        vUp = mMatrix * vUp; // wektor w górę pojazdu (przekręcenie na przechyłce)
+        // vLeft=mMatrix*DynamicObject->vLeft;
+        // vUp=CrossProduct(vFront,vLeft); //wektor w górę
+        // vLeft=Normalize(CrossProduct(vWorldUp,vFront)); //wektor w lewo
+        vLeft = Normalize(CrossProduct(vUp, vFront)); // wektor w lewo
+        // vUp=CrossProduct(vFront,vLeft); //wektor w górę
+    }
+    mMatrix.Identity(); // to też można by od razu policzyć, ale potrzebne jest do wyświetlania
+    mMatrix.BasisChange(vLeft, vUp, vFront); // przesuwanie jest jednak rzadziej niż renderowanie
+    mMatrix = Inverse(mMatrix); // wyliczenie macierzy dla pojazdu (potrzebna tylko do wyświetlania?)
+    // if (MoverParameters->CategoryFlag&2)
+    { // przesunięcia są używane po wyrzuceniu pociągu z toru
+        vPosition.x += MoverParameters->OffsetTrackH * vLeft.x; // dodanie przesunięcia w bok
+        vPosition.z += MoverParameters->OffsetTrackH * vLeft.z; // vLeft jest wektorem poprzecznym
+        // if () na przechyłce będzie dodatkowo zmiana wysokości samochodu
+        vPosition.y += MoverParameters->OffsetTrackV; // te offsety są liczone przez moverparam
+    }
+    // obliczanie pozycji sprzęgów do liczenia zderzeń
+    auto dir = (0.5 * MoverParameters->Dim.L) * vFront; // wektor sprzęgu
+    vCoulpler[end::front] = vPosition + dir; // współrzędne sprzęgu na początku
+    vCoulpler[end::rear] = vPosition - dir; // współrzędne sprzęgu na końcu
+    // bCameraNear=
+    // if (bCameraNear) //jeśli istotne są szczegóły (blisko kamery)
+    { // przeliczenie cienia
+        TTrack *t0 = Axle0.GetTrack(); // już po przesunięciu
+        TTrack *t1 = Axle1.GetTrack();
+        if ((t0->eEnvironment == e_flat) && (t1->eEnvironment == e_flat)) // może być e_bridge...
+            fShade = 0.0; // standardowe oświetlenie
+        else
+        { // jeżeli te tory mają niestandardowy stopień zacienienia
+            // (e_canyon, e_tunnel)
+            if (t0->eEnvironment == t1->eEnvironment)
+            {
+                switch (t0->eEnvironment)
+                { // typ zmiany oświetlenia
+                case e_canyon:
+                    fShade = 0.65f;
+                    break; // zacienienie w kanionie
+                case e_tunnel:
+                    fShade = 0.20f;
+                    break; // zacienienie w tunelu
+                }
+            }
+            else // dwa różne
+            { // liczymy proporcję
+                double d = Axle0.GetTranslation(); // aktualne położenie na torze
+                if (Axle0.GetDirection() < 0)
+                    d = t0->Length() - d; // od drugiej strony liczona długość
+                d /= fAxleDist; // rozsataw osi procentowe znajdowanie się na torze
+
+                float shadefrom = 1.0f, shadeto = 1.0f;
+                // NOTE, TODO: calculating brightness level is used enough times to warrant encapsulation into a function
+                switch( t0->eEnvironment ) {
+                    case e_canyon: { shadeto = 0.65f; break; }
+                    case e_tunnel: { shadeto = 0.2f; break; }
+                    default: {break; }
+                }
+                switch( t1->eEnvironment ) {
+                    case e_canyon: { shadefrom = 0.65f; break; }
+                    case e_tunnel: { shadefrom = 0.2f; break; }
+                    default: {break; }
+                }
+                fShade = interpolate( shadefrom, shadeto, static_cast<float>( d ) );
 /*
-                    switch (t0->eEnvironment)
-                    { // typ zmiany oświetlenia - zakładam, że
-                    // drugi tor ma e_flat
-                    case e_canyon:
-                        fShade = (d * 0.65) + (1.0 - d);
-                        break; // zacienienie w kanionie
-                    case e_tunnel:
-                        fShade = (d * 0.20) + (1.0 - d);
-                        break; // zacienienie w tunelu
-                    }
-                    switch (t1->eEnvironment)
-                    { // typ zmiany oświetlenia - zakładam, że
-                    // pierwszy tor ma e_flat
-                    case e_canyon:
-                        fShade = d + (1.0 - d) * 0.65;
-                        break; // zacienienie w kanionie
-                    case e_tunnel:
-                        fShade = d + (1.0 - d) * 0.20;
-                        break; // zacienienie w tunelu
-                    }
-*/
+                switch (t0->eEnvironment)
+                { // typ zmiany oświetlenia - zakładam, że
+                // drugi tor ma e_flat
+                case e_canyon:
+                    fShade = (d * 0.65) + (1.0 - d);
+                    break; // zacienienie w kanionie
+                case e_tunnel:
+                    fShade = (d * 0.20) + (1.0 - d);
+                    break; // zacienienie w tunelu
+                }
+                switch (t1->eEnvironment)
+                { // typ zmiany oświetlenia - zakładam, że
+                // pierwszy tor ma e_flat
+                case e_canyon:
+                    fShade = d + (1.0 - d) * 0.65;
+                    break; // zacienienie w kanionie
+                case e_tunnel:
+                    fShade = d + (1.0 - d) * 0.20;
+                    break; // zacienienie w tunelu
                 }
+*/
             }
         }
     }
-};
+}
 
 void TDynamicObject::AttachNext(TDynamicObject *Object, int iType)
 { // Ra: doczepia Object na końcu składu (nazwa funkcji może być myląca)
@@ -2638,6 +2648,9 @@ bool TDynamicObject::UpdateForce(double dt)
 {
     if (!bEnabled)
         return false;
+    if( m_dormant ) {
+        return true;
+    }
     if( dt > 0 ) {
         // wywalenie WS zależy od ustawienia kierunku
         MoverParameters->ComputeTotalForce( dt );
@@ -2810,7 +2823,15 @@ void TDynamicObject::LoadUpdate() {
         MoverParameters->LoadTypeChange = false;
         // bieżąca ścieżka do tekstur to dynamic/...
         Global.asCurrentTexturePath = asBaseDir;
-        mdLoad = LoadMMediaFile_mdload( MoverParameters->LoadType.name );
+        // the simulation is already running, so the model is retrieved in the background if it isn't loaded yet
+        mdLoad = LoadMMediaFile_mdload( MoverParameters->LoadType.name, false );
+        m_pendingload = nullptr;
+        if( ( mdLoad != nullptr )
+         && ( true == mdLoad->is_loading() ) ) {
+            // binding load chunks requires submodel lookups, so the new load stays hidden until its model is ready
+            m_pendingload = mdLoad;
+            mdLoad = nullptr;
+        }
         // TODO: discern from vehicle component which merely uses vehicle directory and has no animations, so it can be initialized outright
         // and actual vehicles which get their initialization after their animations are set up
         if( mdLoad != nullptr ) {
@@ -2823,9 +2844,35 @@ void TDynamicObject::LoadUpdate() {
     }
 }
 
+// completes setup of load model retrieved in the background, once it's ready
+void
+TDynamicObject::update_pending_load() {
+
+    if( ( m_pendingload == nullptr )
+     || ( true == m_pendingload->is_loading() ) ) {
+        return;
+    }
+    // models which failed to load stay empty
+    if( m_pendingload->GetSMRoot() != nullptr ) {
+        mdLoad = m_pendingload;
+        mdLoad->GetSMRoot()->WillBeAnimated();
+        mdLoad->Init();
+    }
+    m_pendingload = nullptr;
+    // completion time depends on the loader, so it can't draw from the simulation random sequence
+    update_load_sections( Global.local_random_engine );
+    update_load_visibility();
+}
+
 void
 TDynamicObject::update_load_sections() {
 
+    update_load_sections( Global.random_engine );
+}
+
+void
+TDynamicObject::update_load_sections( std::mt19937 &Randomengine ) {
+
     SectionLoadOrder.clear();
 
     for( auto &section : Sections ) {
@@ -2845,7 +2892,7 @@ TDynamicObject::update_load_sections() {
             }
         }
     }
-    shuffle_load_order();
+    shuffle_load_order( Randomengine );
 }
 
 void
@@ -2885,9 +2932,9 @@ TDynamicObject::update_load_offset() {
 }
 
 void
-TDynamicObject::shuffle_load_order() {
+TDynamicObject::shuffle_load_order( std::mt19937 &Randomengine ) {
 
-    std::shuffle( std::begin( SectionLoadOrder ), std::end( SectionLoadOrder ), Global.random_engine );
+    std::shuffle( std::begin( SectionLoadOrder ), std::end( SectionLoadOrder ), Randomengine );
     // shift chunks assigned to corridors to the end of the list, so they show up last
     std::stable_partition(
         std::begin( SectionLoadOrder ), std::end( SectionLoadOrder ),
@@ -2944,6 +2991,9 @@ bool TDynamicObject::Update(double dt, double dt1)
         return false; // pojazdy postawione na torach portalowych mają MyTrack==NULL
     if (!bEnabled)
         return false; // a normalnie powinny mieć bEnabled==false
+    if( m_dormant ) {
+        return true; // parked vehicle, nothing to update
+    }
 
     double dDOMoveLen;
     // McZapkie: parametry powinny byc pobierane z toru
@@ -4016,7 +4066,9 @@ bool TDynamicObject::FastUpdate(double dt)
 
     if (!bEnabled)
         return false;
-
+    if( m_dormant ) {
+        return true;
+    }
     // NOTE: coordinate system swap
     // TODO: replace with regular glm vectors
     TLocation const l {
@@ -6763,7 +6815,7 @@ void TDynamicObject::LoadMMediaFile( std::string const &TypeName, std::string co
 }
 
 TModel3d *
-TDynamicObject::LoadMMediaFile_mdload( std::string const &Name ) const {
+TDynamicObject::LoadMMediaFile_mdload( std::string const &Name, bool const Loadnow ) const {
 
     auto const loadname { ( Name.empty() ? "none" : Name ) };
     TModel3d *loadmodel { nullptr };
@@ -6773,7 +6825,7 @@ TDynamicObject::LoadMMediaFile_mdload( std::string const &Name ) const {
     {
         auto const lookup { LoadModelOverrides.find( loadname ) };
         if( lookup != LoadModelOverrides.end() ) {
-            loadmodel = TModelsManager::GetModel( asBaseDir + lookup->second, true );
+            loadmodel = TModelsManager::GetModel( asBaseDir + lookup->second, true, true, 0, Loadnow );
         }
     }
     // regular routine if there's no override or it couldn't be loaded
@@ -6781,17 +6833,19 @@ TDynamicObject::LoadMMediaFile_mdload( std::string const &Name ) const {
     if ( loadmodel == nullptr )
     {
         auto const specializedloadfilename { asBaseDir + MoverParameters->TypeName + "_" + loadname };
-        loadmodel = TModelsManager::GetModel( specializedloadfilename, true, false );
+        loadmodel = TModelsManager::GetModel( specializedloadfilename, true, false, 0, Loadnow );
     }
     // try generic version of the load model next, loadname
     if ( loadmodel == nullptr )
     {
         auto const genericloadfilename { asBaseDir + loadname };
-        loadmodel = TModelsManager::GetModel( genericloadfilename, true, false );
+        loadmodel = TModelsManager::GetModel( genericloadfilename, true, false, 0, Loadnow );
     }
 
-    if ( loadmodel != nullptr )
+    if( ( loadmodel != nullptr )
+     && ( false == loadmodel->is_loading() ) ) {
         loadmodel->GetSMRoot()->WillBeAnimated();
+    }
 
     return loadmodel;
 }
@@ -7128,6 +7182,395 @@ TDynamicObject::update_neighbours() {
     }
 }
 
+// checks whether vehicle state allows it to be excluded from simulation updates
+bool
+TDynamicObject::can_sleep() const {
+
+    if( false == Global.DormantVehicles ) { return false; }
+    if( ( false == bEnabled ) || ( MyTrack == nullptr ) ) { return false; }
+    // vehicles with crew or under control of a driver are always simulated
+    if( ( Mechanik != nullptr ) || ( ctOwner != nullptr ) || ( true == MechInside ) ) { return false; }
+    if( ( simulation::Train != nullptr ) && ( simulation::Train->Dynamic() == this ) ) { return false; }
+
+    auto const *mover { MoverParameters };
+    // the vehicle and its neighbours should be already considered at rest by the physics
+    if( true == mover->PhysicActivation ) { return false; }
+    if( ( mover->Vel > 0.0001 ) || ( std::abs( mover->AccS ) > 0.0001 ) ) { return false; }
+    if( false == mover->CommandIn.Command.empty() ) { return false; }
+    if( ( m_exchange.unload_count >= 0.01 ) || ( m_exchange.load_count >= 0.01 ) ) { return false; }
+    // the vehicle should be held in place by its brakes, or lack air which could change their state
+    auto const isbraked {
+        ( mover->BrakePress > 0.1 )
+     || ( mover->ManualBrakePos > 0 )
+     || ( true == mover->SpringBrake.IsActive )
+     || ( ( mover->PipePress < 0.1 ) && ( mover->ScndPipePress < 0.1 ) ) };
+    if( false == isbraked ) { return false; }
+    // no load on the couplers
+    for( auto const &coupler : mover->Couplers ) {
+        if( std::abs( coupler.CForce ) > 1.0 ) { return false; }
+    }
+    return true;
+}
+
+// checks whether dormant vehicle was disturbed and should resume simulation updates
+bool
+TDynamicObject::disturbed() const {
+
+    // vehicles scheduled for removal have to go through regular processing
+    if( false == bEnabled ) { return true; }
+    // driver assigned or an order received
+    if( ( Mechanik != nullptr ) || ( ctOwner != nullptr ) || ( true == MechInside ) ) { return true; }
+    if( ( simulation::Train != nullptr ) && ( simulation::Train->Dynamic() == this ) ) { return true; }
+    if( false == MoverParameters->CommandIn.Command.empty() ) { return true; }
+    // brakes operated directly, e.g. handbrake released by an event, or air fed from outside of the consist
+    if( true == m_dormantbrakes.differs( *MoverParameters ) ) { return true; }
+    // changes caused by other vehicles are reported by them through wake_neighbours()
+    return false;
+}
+
+void
+TDynamicObject::brake_state::capture( TMoverParameters const &Mover ) {
+
+    brakepress = Mover.BrakePress;
+    pipepress = Mover.PipePress;
+    scndpipepress = Mover.ScndPipePress;
+    manualbrakepos = Mover.ManualBrakePos;
+    brakectrlpos = Mover.BrakeCtrlPos;
+    localbrakepos = Mover.LocalBrakePosA;
+    springbrake = Mover.SpringBrake.IsActive;
+}
+
+bool
+TDynamicObject::brake_state::differs( TMoverParameters const &Mover ) const {
+
+    // small tolerance for pressures, which can drift slightly without meaningful change of the brake state
+    return ( std::abs( Mover.BrakePress - brakepress ) > 0.01 )
+        || ( std::abs( Mover.PipePress - pipepress ) > 0.01 )
+        || ( std::abs( Mover.ScndPipePress - scndpipepress ) > 0.01 )
+        || ( Mover.ManualBrakePos != manualbrakepos )
+        || ( Mover.BrakeCtrlPos != brakectrlpos )
+        || ( Mover.LocalBrakePosA != localbrakepos )
+        || ( Mover.SpringBrake.IsActive != springbrake );
+}
+
+// updates dormancy state based on current vehicle state
+void
+TDynamicObject::update_dormancy( double const Deltatime ) {
+
+    if( true == m_dormant ) { return; }
+
+    auto cansleep { can_sleep() };
+    if( true == cansleep ) {
+        // coupled vehicles share air and controls, so they can only go dormant together
+        for( int end = end::front; end <= end::rear; ++end ) {
+            auto const *neighbour { MoverParameters->Neighbours[ end ].vehicle };
+            if( ( neighbour != nullptr )
+             && ( MoverParameters->Couplers[ end ].CouplingFlag != coupling::faux )
+             && ( false == neighbour->is_dormant() )
+             && ( false == neighbour->can_sleep() ) ) {
+                cansleep = false;
+                break;
+            }
+        }
+    }
+    if( false == cansleep ) {
+        m_dormancytimer = 0.0;
+        return;
+    }
+    // small delay to let the vehicle settle down and avoid state flapping
+    m_dormancytimer += Deltatime;
+    if( m_dormancytimer > 5.0 ) {
+        m_dormant = true;
+        m_dormantbrakes.capture( *MoverParameters );
+    }
+}
+
+// brings dormant vehicle back to full simulation updates
+void
+TDynamicObject::wake() {
+
+    m_dormancytimer = 0.0;
+    if( false == m_dormant ) { return; }
+
+    m_dormant = false;
+    // give the physics chance to process whatever disturbed the vehicle
+    MoverParameters->switch_physics( true );
+}
+
+// wakes up dormant vehicles which can be affected by this vehicle
+void
+TDynamicObject::wake_neighbours() {
+
+    auto const ismoving {
+        ( MoverParameters->Vel > 0.0001 )
+     || ( std::abs( MoverParameters->AccS ) > 0.0001 ) };
+    auto const isactive {
+        ismoving
+     || ( false == can_sleep() ) };
+
+    for( int end = end::front; end <= end::rear; ++end ) {
+        auto *neighbour { MoverParameters->Neighbours[ end ].vehicle };
+        if( ( neighbour == nullptr )
+         || ( false == neighbour->is_dormant() ) ) {
+            continue;
+        }
+        // moving vehicle can collide with the neighbour, active one can affect it through the couplers
+        if( ( true == ismoving )
+         || ( ( true == isactive )
+           && ( MoverParameters->Couplers[ end ].CouplingFlag != coupling::faux ) ) ) {
+            neighbour->wake();
+        }
+    }
+}
+
+// stores current placement as the starting point of render interpolation
+void
+TDynamicObject::store_render_state() {
+
+    // if the interpolated state is still applied, the stored state would be out of sync with the physics
+    restore_render_state();
+    capture_render_state( m_previousstate );
+    m_previousstatevalid = true;
+}
+
+// replaces vehicle placement with state interpolated between stored and current physics state
+void
+TDynamicObject::interpolate_render_state( double const Alpha ) {
+
+    if( ( false == m_previousstatevalid )
+     || ( true == m_interpolated ) ) {
+        return;
+    }
+    // parked vehicles and vehicles which didn't move since the last physics update don't need any work
+    if( ( m_previousstate.position == vPosition )
+     && ( m_previousstate.front == vFront )
+     && ( m_previousstate.up == vUp ) ) {
+        return;
+    }
+    // relocated vehicles, e.g. by portals or vehicle placement commands, snap to the new position
+    if( SquareMagnitude( vPosition - m_previousstate.position ) > 10.0 * 10.0 ) {
+        return;
+    }
+
+    capture_render_state( m_physicsstate );
+
+    auto const alpha { clamp( Alpha, 0.0, 1.0 ) };
+    auto const &previous { m_previousstate };
+    auto const &current { m_physicsstate };
+    auto const interpolate_angle {
+        []( double const First, double const Second, double const Factor ) {
+            // pick the shorter way around, headings can wrap between -pi and pi
+            return First + std::remainder( Second - First, 2 * M_PI ) * Factor; } };
+
+    render_state state;
+    state.position = interpolate( previous.position, current.position, alpha );
+    state.front = Normalize( interpolate( previous.front, current.front, alpha ) );
+    state.up = Normalize( CrossProduct( state.front, Normalize( interpolate( previous.left, current.left, alpha ) ) ) );
+    state.left = Normalize( CrossProduct( state.up, state.front ) );
+    state.matrix.Identity();
+    state.matrix.BasisChange( state.left, state.up, state.front );
+    state.matrix = Inverse( state.matrix );
+    state.rotation = interpolate_angle( previous.rotation, current.rotation, alpha );
+    for( int idx = 0; idx < 2; ++idx ) {
+        state.bogierotations[ idx ] = interpolate_angle( previous.bogierotations[ idx ], current.bogierotations[ idx ], alpha );
+    }
+    state.pantographs = current.pantographs;
+    if( previous.pantographs.size() == current.pantographs.size() ) {
+        for( std::size_t idx = 0; idx < current.pantographs.size(); ++idx ) {
+            state.pantographs[ idx ] = interpolate( previous.pantographs[ idx ], current.pantographs[ idx ], alpha );
+        }
+    }
+
+    apply_render_state( state );
+    m_interpolated = true;
+}
+
+// brings back actual physics state, replaced by the render interpolation
+void
+TDynamicObject::restore_render_state() {
+
+    if( false == m_interpolated ) { return; }
+
+    apply_render_state( m_physicsstate );
+    m_interpolated = false;
+}
+
+// sends state required to resume simulation of the vehicle to provided stream
+// NOTE: covers placement, motion, air system and basic controls. internal state of the driver brake handles and AI isn't included
+void
+TDynamicObject::serialize_state( std::ostream &Output ) const {
+
+    Axle0.serialize_state( Output );
+    Axle1.serialize_state( Output );
+    sn_utils::ls_int32( Output, iAxleFirst );
+    sn_utils::s_str( Output, ( MyTrack != nullptr ? MyTrack->name() : "" ) );
+    sn_utils::s_bool( Output, m_dormant );
+    sn_utils::ls_float64( Output, m_dormancytimer );
+
+    auto const &mover { *MoverParameters };
+    // motion
+    for( auto const value : {
+        mover.V, mover.Vel, mover.AccS, mover.AccN, mover.AccVert,
+        mover.nrot, mover.nrot_eps, mover.DistCounter, mover.WheelFlat } ) {
+        sn_utils::ls_float64( Output, value );
+    }
+    sn_utils::s_bool( Output, mover.SlippingWheels );
+    sn_utils::s_bool( Output, mover.SandDose );
+    // air system
+    for( auto const value : {
+        mover.ScndPipePress, mover.BrakePress, mover.LocBrakePress, mover.PipeBrakePress,
+        mover.PipePress, mover.EqvtPipePress, mover.Volume, mover.CompressedVolume,
+        mover.PantVolume, mover.Compressor } ) {
+        sn_utils::ls_float64( Output, value );
+    }
+    for( auto const flag : {
+        mover.CompressorFlag, mover.CompressorAllow, mover.CompressorGovernorLock,
+        mover.ConverterFlag, mover.ConverterAllow } ) {
+        sn_utils::s_bool( Output, flag );
+    }
+    mover.Pipe->serialize_state( Output );
+    mover.Pipe2->serialize_state( Output );
+    mover.Hamulec->serialize_state( Output );
+    // controls
+    for( auto const value : {
+        mover.BrakeCtrlPosR, mover.BrakeCtrlPos2, mover.fBrakeCtrlPos,
+        mover.LocalBrakePosA, mover.LocalBrakePosAEIM } ) {
+        sn_utils::ls_float64( Output, value );
+    }
+    for( auto const value : {
+        mover.BrakeCtrlPos, mover.ManualBrakePos, mover.BrakeDelayFlag, mover.BrakeOpModeFlag,
+        mover.MainCtrlPos, mover.MainCtrlActualPos, mover.ScndCtrlPos, mover.ScndCtrlActualPos,
+        mover.DirActive, mover.DirAbsolute, mover.LightsPos } ) {
+        sn_utils::ls_int32( Output, value );
+    }
+    for( auto const flag : {
+        mover.AlarmChainFlag, mover.RadioStopFlag, mover.LockPipe, mover.DynamicBrakeFlag,
+        mover.Mains, mover.Battery, mover.SpringBrake.IsActive, mover.PhysicActivation } ) {
+        sn_utils::s_bool( Output, flag );
+    }
+}
+
+// restores vehicle state from provided stream. returns: true on success
+bool
+TDynamicObject::deserialize_state( std::istream &Input ) {
+
+    // interpolated placement would be written back over the restored one
+    restore_render_state();
+    m_previousstatevalid = false;
+
+    if( ( false == Axle0.deserialize_state( Input ) )
+     || ( false == Axle1.deserialize_state( Input ) ) ) {
+        return false;
+    }
+    iAxleFirst = sn_utils::ld_int32( Input );
+    auto const trackname { sn_utils::d_str( Input ) };
+    auto *track { (
+        trackname.empty() ?
+            nullptr :
+            simulation::Paths.find( trackname ) ) };
+    if( track != MyTrack ) {
+        if( MyTrack != nullptr ) {
+            MyTrack->RemoveDynamicObject( this );
+        }
+        if( track != nullptr ) {
+            track->AddDynamicObject( this );
+        }
+    }
+    m_dormant = sn_utils::d_bool( Input );
+    m_dormancytimer = sn_utils::ld_float64( Input );
+
+    auto &mover { *MoverParameters };
+    // motion
+    for( auto *value : {
+        &mover.V, &mover.Vel, &mover.AccS, &mover.AccN, &mover.AccVert,
+        &mover.nrot, &mover.nrot_eps, &mover.DistCounter, &mover.WheelFlat } ) {
+        *value = sn_utils::ld_float64( Input );
+    }
+    mover.SlippingWheels = sn_utils::d_bool( Input );
+    mover.SandDose = sn_utils::d_bool( Input );
+    // air system
+    for( auto *value : {
+        &mover.ScndPipePress, &mover.BrakePress, &mover.LocBrakePress, &mover.PipeBrakePress,
+        &mover.PipePress, &mover.EqvtPipePress, &mover.Volume, &mover.CompressedVolume,
+        &mover.PantVolume, &mover.Compressor } ) {
+        *value = sn_utils::ld_float64( Input );
+    }
+    for( auto *flag : {
+        &mover.CompressorFlag, &mover.CompressorAllow, &mover.CompressorGovernorLock,
+        &mover.ConverterFlag, &mover.ConverterAllow } ) {
+        *flag = sn_utils::d_bool( Input );
+    }
+    mover.Pipe->deserialize_state( Input );
+    mover.Pipe2->deserialize_state( Input );
+    mover.Hamulec->deserialize_state( Input );
+    // controls
+    for( auto *value : {
+        &mover.BrakeCtrlPosR, &mover.BrakeCtrlPos2, &mover.fBrakeCtrlPos,
+        &mover.LocalBrakePosA, &mover.LocalBrakePosAEIM } ) {
+        *value = sn_utils::ld_float64( Input );
+    }
+    for( auto *value : {
+        &mover.BrakeCtrlPos, &mover.ManualBrakePos, &mover.BrakeDelayFlag, &mover.BrakeOpModeFlag,
+        &mover.MainCtrlPos, &mover.MainCtrlActualPos, &mover.ScndCtrlPos, &mover.ScndCtrlActualPos,
+        &mover.DirActive, &mover.DirAbsolute, &mover.LightsPos } ) {
+        *value = sn_utils::ld_int32( Input );
+    }
+    for( auto *flag : {
+        &mover.AlarmChainFlag, &mover.RadioStopFlag, &mover.LockPipe, &mover.DynamicBrakeFlag,
+        &mover.Mains, &mover.Battery, &mover.SpringBrake.IsActive, &mover.PhysicActivation } ) {
+        *flag = sn_utils::d_bool( Input );
+    }
+    if( false == Input.good() ) {
+        return false;
+    }
+    if( true == m_dormant ) {
+        // the reference point has to match the restored state, or the vehicle would be woken up right away
+        m_dormantbrakes.capture( mover );
+    }
+    update_placement();
+
+    return true;
+}
+
+// copies current vehicle placement into provided container
+void
+TDynamicObject::capture_render_state( render_state &State ) const {
+
+    State.position = vPosition;
+    State.front = vFront;
+    State.up = vUp;
+    State.left = vLeft;
+    State.matrix = mMatrix;
+    State.rotation = modelRot.z;
+    State.bogierotations[ 0 ] = Axle0.vAngles.z;
+    State.bogierotations[ 1 ] = Axle1.vAngles.z;
+    State.pantographs.clear();
+    for( int idx = 0; idx < iAnimType[ ANIM_PANTS ]; ++idx ) {
+        auto const *pantograph { pants[ idx ].fParamPants };
+        State.pantographs.emplace_back( pantograph->fAngleL, pantograph->fAngleU );
+    }
+}
+
+// replaces current vehicle placement with provided state
+void
+TDynamicObject::apply_render_state( render_state const &State ) {
+
+    vPosition = State.position;
+    vFront = State.front;
+    vUp = State.up;
+    vLeft = State.left;
+    mMatrix = State.matrix;
+    modelRot.z = State.rotation;
+    Axle0.vAngles.z = State.bogierotations[ 0 ];
+    Axle1.vAngles.z = State.bogierotations[ 1 ];
+    auto const pantographcount { std::min<int>( iAnimType[ ANIM_PANTS ], State.pantographs.size() ) };
+    for( int idx = 0; idx < pantographcount; ++idx ) {
+        auto *pantograph { pants[ idx ].fParamPants };
+        pantograph->fAngleL = State.pantographs[ idx ].x;
+        pantograph->fAngleU = State.pantographs[ idx ].y;
+    }
+}
+
 // locates potential collision source within specified range, scanning track in specified direction. returns: true if neighbour was located, false otherwise
 // NOTE: reuses legacy code. TBD, TODO: review, refactor?
 std::tuple<TDynamicObject *, int, double, bool>
@@ -8134,8 +8577,20 @@ vehicle_table::update( double Deltatime, int Iterationcount ) {
     //    na którą by się zapisywały wszystkie pojazdy będące w ruchu
     //    pojazdy stojące nie potrzebują aktualizacji, chyba że np. ktoś im zmieni nastawę hamulca
     //    oddzielną listę można by zrobić na pojazdy z napędem, najlepiej posortowaną wg typu napędu
+    // parked vehicles are excluded from updates until something disturbs them
+    for( auto *vehicle : m_items ) {
+        // load models retrieved in the background are bound whenever they're ready, dormant or not
+        vehicle->update_pending_load();
+        if( false == vehicle->is_dormant() ) {
+            vehicle->wake_neighbours();
+        }
+        else if( true == vehicle->disturbed() ) {
+            vehicle->wake();
+        }
+    }
     for( auto *vehicle : m_items ) {
         if( false == vehicle->bEnabled ) { continue; }
+        if( true == vehicle->is_dormant() ) { continue; }
         // Ra: zmienić warunek na sprawdzanie pantografów w jednej zmiennej: czy pantografy i czy podniesione
         if( vehicle->MoverParameters->EnginePowerSource.SourceType == TPowerSource::CurrentCollector ) {
             update_traction( vehicle );
@@ -8143,19 +8598,36 @@ vehicle_table::update( double Deltatime, int Iterationcount ) {
         vehicle->MoverParameters->ComputeConstans();
         vehicle->update_neighbours();
     }
-    if( Iterationcount > 1 ) {
-        // ABu: ponizsze wykonujemy tylko jesli wiecej niz jedna iteracja
+    if( true == Global.ParallelPhysics ) {
+        // force calculation involves only the vehicle and its neighbours, so independent groups can be handled by separate workers
+        // movement changes shared state of tracks and event queue, so it's always done in sequence, in the same order as the serial path
+        if( m_workers.size() == 0 ) {
+            m_workers.start( Global.PhysicsThreads );
+        }
+        update_groups( Deltatime * Iterationcount );
         for( int iteration = 0; iteration < ( Iterationcount - 1 ); ++iteration ) {
-            for( auto *vehicle : m_items ) {
-                vehicle->UpdateForce( Deltatime );
-            }
+            update_forces_parallel( Deltatime );
             for( auto *vehicle : m_items ) {
                 vehicle->FastUpdate( Deltatime );
             }
         }
+        update_forces_parallel( Deltatime );
     }
-    for( auto *vehicle : m_items ) {
-        vehicle->UpdateForce( Deltatime );
+    else {
+        if( Iterationcount > 1 ) {
+            // ABu: ponizsze wykonujemy tylko jesli wiecej niz jedna iteracja
+            for( int iteration = 0; iteration < ( Iterationcount - 1 ); ++iteration ) {
+                for( auto *vehicle : m_items ) {
+                    vehicle->UpdateForce( Deltatime );
+                }
+                for( auto *vehicle : m_items ) {
+                    vehicle->FastUpdate( Deltatime );
+                }
+            }
+        }
+        for( auto *vehicle : m_items ) {
+            vehicle->UpdateForce( Deltatime );
+        }
     }
 
     auto const totaltime { Deltatime * Iterationcount }; // całkowity czas
@@ -8163,12 +8635,93 @@ vehicle_table::update( double Deltatime, int Iterationcount ) {
     for( auto *vehicle : m_items ) {
         // Ra 2015-01: tylko tu przelicza sieć trakcyjną
         vehicle->Update( Deltatime, totaltime );
+        vehicle->update_dormancy( totaltime );
     }
 
     // jeśli jest coś do usunięcia z listy, to trzeba na końcu
     erase_disabled();
 }
 
+// splits vehicles into groups which don't interact with each other during force calculation
+void
+vehicle_table::update_groups( double const Timespan ) {
+    // vehicles linked through couplers or potential collisions end up in the same group
+    // NOTE: neighbours are updated only once per frame, so the groups remain valid for all sub-steps of the frame
+    std::unordered_map<TDynamicObject const *, std::size_t> indices;
+    indices.reserve( m_items.size() );
+    std::vector<std::size_t> parents;
+    parents.reserve( m_items.size() );
+    for( auto const *vehicle : m_items ) {
+        if( vehicle == nullptr ) { continue; }
+        indices.emplace( vehicle, parents.size() );
+        parents.emplace_back( parents.size() );
+    }
+    auto const root = [ &parents ]( std::size_t Index ) {
+        while( parents[ Index ] != Index ) {
+            parents[ Index ] = parents[ parents[ Index ] ];
+            Index = parents[ Index ];
+        }
+        return Index; };
+
+    for( auto const *vehicle : m_items ) {
+        if( vehicle == nullptr ) { continue; }
+        auto const vehicleroot { root( indices[ vehicle ] ) };
+        for( auto const &neighbour : vehicle->MoverParameters->Neighbours ) {
+            if( neighbour.vehicle == nullptr ) { continue; }
+            auto const lookup { indices.find( neighbour.vehicle ) };
+            if( lookup == indices.end() ) { continue; }
+            parents[ root( lookup->second ) ] = root( vehicleroot );
+        }
+    }
+    // gather the groups, retaining order of vehicles from the main list
+    m_groups.clear();
+    std::vector<std::size_t> groupindices( parents.size(), std::numeric_limits<std::size_t>::max() );
+    for( auto *vehicle : m_items ) {
+        if( vehicle == nullptr ) { continue; }
+        auto &groupindex { groupindices[ root( indices[ vehicle ] ) ] };
+        if( groupindex == std::numeric_limits<std::size_t>::max() ) {
+            groupindex = m_groups.size();
+            m_groups.emplace_back();
+        }
+        auto &group { m_groups[ groupindex ] };
+        group.vehicles.emplace_back( vehicle );
+        // overstretched couplers can break at random. the draws have to be made in the same order as in the serial path,
+        // so groups which can reach the check during this frame are calculated by the main thread
+        if( true == Global.crash_damage ) {
+            for( auto const &coupler : vehicle->MoverParameters->Couplers ) {
+                if( coupler.stretch_duration + Timespan > 1.f ) {
+                    group.serial = true;
+                }
+            }
+        }
+    }
+    m_serialvehicles.clear();
+    for( auto *vehicle : m_items ) {
+        if( vehicle == nullptr ) { continue; }
+        if( true == m_groups[ groupindices[ root( indices[ vehicle ] ) ] ].serial ) {
+            m_serialvehicles.emplace_back( vehicle );
+        }
+    }
+}
+
+// calculates forces acting on vehicles, using worker threads for groups which permit it
+void
+vehicle_table::update_forces_parallel( double const Deltatime ) {
+
+    m_workers.parallel_for(
+        m_groups.size(),
+        [ this, Deltatime ]( std::size_t const Index ) {
+            auto const &group { m_groups[ Index ] };
+            if( true == group.serial ) { return; }
+            for( auto *vehicle : group.vehicles ) {
+                vehicle->UpdateForce( Deltatime );
+            } } );
+    // vehicles which can draw random numbers are processed afterwards, in order of the main list
+    for( auto *vehicle : m_serialvehicles ) {
+        vehicle->UpdateForce( Deltatime );
+    }
+}
+
 // legacy method, checks for presence and height of traction wire for specified vehicle
 void
 vehicle_table::update_traction( TDynamicObject *Vehicle ) {
@@ -8279,6 +8832,33 @@ vehicle_table::DynamicList( bool const Onlycontrolled ) const {
     multiplayer::WyslijString( "none", 6 );
 }
 
+// stores current vehicle placements as starting points of render interpolation
+void
+vehicle_table::store_render_state() {
+
+    for( auto *vehicle : m_items ) {
+        vehicle->store_render_state();
+    }
+}
+
+// applies vehicle placements interpolated between stored and current physics state, with specified weight of the current state
+void
+vehicle_table::interpolate_render_state( double const Alpha ) {
+
+    for( auto *vehicle : m_items ) {
+        vehicle->interpolate_render_state( Alpha );
+    }
+}
+
+// brings back actual physics state of vehicles, before the next simulation update
+void
+vehicle_table::restore_render_state() {
+
+    for( auto *vehicle : m_items ) {
+        vehicle->restore_render_state();
+    }
+}
+
 // maintenance; removes from tracks consists with vehicles marked as disabled
 bool
 vehicle_table::erase_disabled() {
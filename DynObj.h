@@ -21,6 +21,7 @@ http://mozilla.org/MPL/2.0/.
 #include "Texture.h"
 #include "sound.h"
 #include "Spring.h"
+#include "utilities.h"
 
 #define EU07_SOUND_BOGIESOUNDS
 
@@ -367,6 +368,32 @@ private:
         sound_source unloading { sound_placement::general };
     };
 
+    // vehicle placement and animation state used by the renderer, captured from physics state
+    struct render_state {
+        Math3D::vector3 position;
+        Math3D::vector3 front;
+        Math3D::vector3 up;
+        Math3D::vector3 left;
+        Math3D::matrix4x4 matrix;
+        double rotation { 0.0 }; // modelRot.z
+        double bogierotations[ 2 ] { 0.0, 0.0 }; // axle headings, used to calculate bogie rotations
+        std::vector<glm::dvec2> pantographs; // lower and upper arm angles
+    };
+
+    // brake related state of parked vehicle, changes to it bring the vehicle out of dormancy
+    struct brake_state {
+        double brakepress { 0.0 };
+        double pipepress { 0.0 };
+        double scndpipepress { 0.0 };
+        int manualbrakepos { 0 };
+        int brakectrlpos { 0 };
+        double localbrakepos { 0.0 };
+        bool springbrake { false };
+
+        void capture( TMoverParameters const &Mover );
+        bool differs( TMoverParameters const &Mover ) const;
+    };
+
     struct axle_sounds {
         double distance; // distance to rail joint
         double offset; // axle offset from centre of the vehicle
@@ -438,6 +465,12 @@ private:
     void TurnOff();
     // update state of load exchange operation
     void update_exchange( double const Deltatime );
+    // copies current vehicle placement into provided container
+    void capture_render_state( render_state &State ) const;
+    // replaces current vehicle placement with provided state
+    void apply_render_state( render_state const &State );
+    // recalculates vehicle placement and couplers from current state of the axles
+    void update_placement();
 
 // members
     AirCoupler btCoupler1; // sprzegi
@@ -534,6 +567,14 @@ private:
     sound_source rsDerailment { sound_placement::external, 2 * EU07_SOUND_RUNNINGNOISECUTOFFRANGE }; // McZapkie-051202
 
     exchange_data m_exchange; // state of active load exchange procedure, if any
+    TModel3d *m_pendingload { nullptr }; // load model retrieved in the background, replaces mdLoad once it's ready
+    bool m_dormant { false }; // parked vehicle excluded from simulation updates until disturbed
+    double m_dormancytimer { 0.0 }; // time spent meeting dormancy conditions
+    brake_state m_dormantbrakes; // brake state at the moment the vehicle went dormant
+    render_state m_previousstate; // placement from before the most recent physics update
+    render_state m_physicsstate; // actual placement, preserved while interpolated state is applied
+    bool m_previousstatevalid { false };
+    bool m_interpolated { false }; // interpolated placement is currently applied
     exchange_sounds m_exchangesounds; // sounds associated with the load exchange
 
     std::vector<doorspeaker_sounds> m_doorspeakers;
@@ -637,10 +678,13 @@ private:
     // calculates current load exchange factor, where 1 = nominal rate, higher = faster
     float LoadExchangeSpeed() const; // TODO: make private when cleaning up
     void LoadUpdate();
+    // completes setup of load model retrieved in the background, once it's ready
+    void update_pending_load();
     void update_load_sections();
+    void update_load_sections( std::mt19937 &Randomengine );
     void update_load_visibility();
     void update_load_offset();
-    void shuffle_load_order();
+    void shuffle_load_order( std::mt19937 &Randomengine );
     void update_destinations();
     bool Update(double dt, double dt1);
     bool FastUpdate(double dt);
@@ -702,7 +746,8 @@ private:
 
     // McZapkie-260202
     void LoadMMediaFile(std::string const &TypeName, std::string const &ReplacableSkin);
-    TModel3d *LoadMMediaFile_mdload( std::string const &Name ) const;
+    // NOTE: with Loadnow == false the returned model can be still loading in the background
+    TModel3d *LoadMMediaFile_mdload( std::string const &Name, bool const Loadnow = true ) const;
 
     inline double ABuGetDirection() const { // ABu.
         return (Axle1.GetTrack() == MyTrack ? Axle1.GetDirection() : Axle0.GetDirection()); };
@@ -747,6 +792,28 @@ private:
     TDynamicObject * Neighbour(int &dir);
     // updates potential collision sources
     void update_neighbours();
+    // checks whether vehicle state allows it to be excluded from simulation updates
+    bool can_sleep() const;
+    // checks whether dormant vehicle was disturbed and should resume simulation updates
+    bool disturbed() const;
+    // updates dormancy state based on current vehicle state
+    void update_dormancy( double const Deltatime );
+    // brings dormant vehicle back to full simulation updates
+    void wake();
+    // wakes up dormant vehicles which can be affected by this vehicle
+    void wake_neighbours();
+    bool is_dormant() const {
+        return m_dormant; }
+    // stores current placement as the starting point of render interpolation
+    void store_render_state();
+    // replaces vehicle placement with state interpolated between stored and current physics state
+    void interpolate_render_state( double const Alpha );
+    // brings back actual physics state, replaced by the render interpolation
+    void restore_render_state();
+    // sends state required to resume simulation of the vehicle to provided stream
+    void serialize_state( std::ostream &Output ) const;
+    // restores vehicle state from provided stream. returns: true on success
+    bool deserialize_state( std::istream &Input );
     // locates potential collision source within specified range, scanning its route in specified direction
     auto find_vehicle( int const Direction, double const Range ) const -> std::tuple<TDynamicObject *, int, double, bool>;
     // locates potential vehicle connected with specific coupling type and satisfying supplied predicate
@@ -828,11 +895,36 @@ public:
     // legacy method, sends list of vehicles over network
     void
         DynamicList( bool const Onlycontrolled = false ) const;
+    // stores current vehicle placements as starting points of render interpolation
+    void
+        store_render_state();
+    // applies vehicle placements interpolated between stored and current physics state, with specified weight of the current state
+    void
+        interpolate_render_state( double const Alpha );
+    // brings back actual physics state of vehicles, before the next simulation update
+    void
+        restore_render_state();
 
 private:
+// types
+    struct vehicle_group {
+        std::vector<TDynamicObject *> vehicles;
+        bool serial { false }; // force calculation may draw from the shared random generator
+    };
+// methods
     // maintenance; removes from tracks consists with vehicles marked as disabled
     bool
         erase_disabled();
+    // splits vehicles into groups which don't interact with each other during force calculation
+    void
+        update_groups( double const Timespan );
+    // calculates forces acting on vehicles, using worker threads for groups which permit it
+    void
+        update_forces_parallel( double const Deltatime );
+// members
+    std::vector<vehicle_group> m_groups; // sets of coupled or potentially colliding vehicles
+    std::vector<TDynamicObject *> m_serialvehicles; // members of groups calculated by the main thread, in order of the main list
+    threading::worker_pool m_workers; // physics calculation workers
 };
 
 
@@ -197,16 +197,16 @@ bool TEventLauncher::check_activation() {
     }
     else {
         // jeśli nie cykliczny, to sprawdzić czas
-        if( simulation::Time.data().wHour == iHour ) {
-            if( simulation::Time.data().wMinute == iMinute ) {
-                // zgodność czasu uruchomienia
-                if( UpdatedTime < 10 ) {
-                    UpdatedTime = 20; // czas do kolejnego wyzwolenia?
-                    bCond = true;
-                }
+        if( ( simulation::Time.data().wHour == iHour )
+         && ( simulation::Time.data().wMinute == iMinute ) ) {
+            // zgodność czasu uruchomienia
+            if( UpdatedTime < 10 ) {
+                UpdatedTime = 20; // czas do kolejnego wyzwolenia?
+                bCond = true;
             }
         }
         else {
+            // re-arm the launcher once its activation time passes
             UpdatedTime = 1;
         }
     }
@@ -216,15 +216,18 @@ bool TEventLauncher::check_activation() {
 
 bool TEventLauncher::check_conditions() {
 
-    auto bCond { true };
-
-    if( ( iCheckMask != 0 )
-     && ( MemCell != nullptr ) ) {
+    if( ( iCheckMask == 0 )
+     || ( MemCell == nullptr ) ) {
+        return true;
+    }
+    if( true == m_conditionschanged ) {
         // sprawdzanie warunku na komórce pamięci
-        bCond = MemCell->Compare( szText, fVal1, fVal2, iCheckMask );
+        // the cell notifies us about changes of its content, so the comparison is done only when it can give different result
+        m_conditionsmet = MemCell->Compare( szText, fVal1, fVal2, iCheckMask );
+        m_conditionschanged = false;
     }
 
-    return bCond; // sprawdzanie dRadius w Ground.cpp
+    return m_conditionsmet; // sprawdzanie dRadius w Ground.cpp
 }
 
 // sprawdzenie, czy jest globalnym wyzwalaczem czasu
@@ -241,6 +244,34 @@ bool TEventLauncher::IsRadioActivated() const {
     return ( iKey < 0 );
 }
 
+bool TEventLauncher::IsKeyActivated() const {
+
+    return ( iKey > 0 );
+}
+
+// returns: true if the launcher is activated periodically, or once after scenario start
+bool TEventLauncher::IsPeriodic() const {
+
+    return ( DeltaTime > 0 );
+}
+
+// returns: true if the launcher can't be activated by time anymore
+bool TEventLauncher::IsSpent() const {
+
+    // single activation launchers are done after their first activation
+    return ( ( DeltaTime == 10000.0 )
+          && ( UpdatedTime != 0.0 ) );
+}
+
+// returns: time of day the launcher is activated at, in minutes, or -1 if it isn't activated at specific time
+int TEventLauncher::activation_minute() const {
+
+    return (
+        ( ( DeltaTime == 0 ) && ( iHour >= 0 ) && ( iMinute >= 0 ) ) ?
+            iHour * 60 + iMinute :
+            -1 );
+}
+
 // radius() subclass details, calculates node's bounding radius
 float
 TEventLauncher::radius_() {
@@ -326,4 +357,51 @@ TEventLauncher::export_as_text_( std::ostream &Output ) const {
         << "\n";
 }
 
+
+
+namespace {
+
+// helper, orders launchers by their time of day activation
+struct activation_order {
+    bool operator()( TEventLauncher const *Left, int const Right ) const {
+        return Left->activation_minute() < Right; }
+    bool operator()( int const Left, TEventLauncher const *Right ) const {
+        return Left < Right->activation_minute(); }
+};
+
+} // namespace
+
+// adds provided launcher to the schedule
+void
+launcher_schedule::insert( TEventLauncher *Launcher ) {
+
+    auto const minute { Launcher->activation_minute() };
+    if( minute < 0 ) { return; }
+
+    m_launchers.emplace(
+        std::upper_bound( std::begin( m_launchers ), std::end( m_launchers ), minute, activation_order() ),
+        Launcher );
+}
+
+// returns launchers due at specified time of day. launchers from previously checked minute are re-armed
+launcher_schedule::launcher_range
+launcher_schedule::due( int const Minute ) {
+
+    if( Minute != m_minute ) {
+        // launchers which were due until now won't be checked until next day, let them know their time has passed
+        auto const previous { range( m_minute ) };
+        for( auto launcher { previous.first }; launcher != previous.second; ++launcher ) {
+            ( *launcher )->check_activation();
+        }
+        m_minute = Minute;
+    }
+    return range( Minute );
+}
+
+launcher_schedule::launcher_range
+launcher_schedule::range( int const Minute ) const {
+
+    return std::equal_range( std::cbegin( m_launchers ), std::cend( m_launchers ), Minute, activation_order() );
+}
+
 //---------------------------------------------------------------------------
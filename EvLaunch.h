@@ -34,11 +34,22 @@ public:
     bool check_activation();
     // checks conditions associated with the event. returns: true if the conditions are met
     bool check_conditions();
+    // marks conditions associated with the event for re-evaluation
+    inline
+    void conditions_changed() {
+        m_conditionschanged = true; }
     inline
     auto key() const {
         return iKey; }
     bool IsGlobal() const;
     bool IsRadioActivated() const;
+    bool IsKeyActivated() const;
+    // returns: true if the launcher is activated periodically, or once after scenario start
+    bool IsPeriodic() const;
+    // returns: true if the launcher can't be activated by time anymore
+    bool IsSpent() const;
+    // returns: time of day the launcher is activated at, in minutes, or -1 if it isn't activated at specific time
+    int activation_minute() const;
 // members
     std::string asEvent1Name;
     std::string asEvent2Name;
@@ -70,6 +81,35 @@ private:
     std::string szText;
     int iHour { -1 };
     int iMinute { -1 }; // minuta uruchomienia
+    bool m_conditionschanged { true }; // memory cell content changed since last check of the conditions
+    bool m_conditionsmet { true }; // cached result of the last check of the conditions
+};
+
+// collection of event launchers activated at specific time of day, ordered by their activation time
+class launcher_schedule {
+
+public:
+// types
+    using launcher_sequence = std::vector<TEventLauncher *>;
+    using launcher_range = std::pair<launcher_sequence::const_iterator, launcher_sequence::const_iterator>;
+// methods
+    // adds provided launcher to the schedule
+    void
+        insert( TEventLauncher *Launcher );
+    // returns launchers due at specified time of day. launchers from previously checked minute are re-armed
+    launcher_range
+        due( int const Minute );
+    bool
+        empty() const {
+            return m_launchers.empty(); }
+
+private:
+// methods
+    launcher_range
+        range( int const Minute ) const;
+// members
+    launcher_sequence m_launchers;
+    int m_minute { -1 }; // time of day of the last check, in minutes
 };
 
 //---------------------------------------------------------------------------
@@ -32,6 +32,7 @@ http://mozilla.org/MPL/2.0/.
 #include "renderer.h"
 #include "Timer.h"
 #include "Logs.h"
+#include "sn_utils.h"
 #include "widgets/map_objects.h"
 
 void
@@ -336,7 +337,9 @@ void
 basic_event::run() {
 
     WriteLog( "EVENT LAUNCHED" + ( m_activator ? ( " by " + m_activator->asName ) : "" ) + ": " + m_name );
+    m_running = true;
     run_();
+    m_running = false;
 }
 
 // sends basic content of the class in legacy (text) format to provided stream
@@ -439,6 +442,12 @@ basic_event::input_location() const {
     return glm::dvec3( 0, 0, 0 );
 };
 
+std::uint32_t
+basic_event::input_revision() const {
+    // dane wejściowe eventu są stałe
+    return 0;
+};
+
 bool
 basic_event::is_keyword( std::string const &Token ) {
     // TODO: convert to array lookup if keyword list gets longer
@@ -680,6 +689,12 @@ getvalues_event::input_location() const {
     return m_input.data_cell()->location(); // współrzędne podłączonej komórki pamięci
 }
 
+std::uint32_t
+getvalues_event::input_revision() const {
+
+    return m_input.data_cell()->revision(); // licznik zmian podłączonej komórki pamięci
+}
+
 
 
 // prepares event for use
@@ -1829,6 +1844,7 @@ switch_event::init() {
         if( targettrack->iAction == 0 ) {
             // jeśli nie jest zwrotnicą ani obrotnicą to będzie się zmieniał stan uszkodzenia
             targettrack->iAction |= 0x100;
+            simulation::Paths.graph().update( targettrack );
         }
         if( ( m_switchstate == 0 )
             && ( m_switchmovedelay >= 0.0 ) ) {
@@ -1918,6 +1934,7 @@ track_event::init() {
         if( targettrack == nullptr ) { continue; }
         // flaga zmiany prędkości toru jest istotna dla skanowania
         targettrack->iAction |= 0x200;
+        simulation::Paths.graph().update( targettrack );
     }
 }
 
@@ -2243,11 +2260,25 @@ event_manager::~event_manager() {
     }
 }
 
+// removes provided event launcher from the collection
+void
+event_manager::purge( TEventLauncher *Launcher ) {
+
+    if( Launcher->MemCell != nullptr ) {
+        Launcher->MemCell->unsubscribe( Launcher );
+    }
+    m_radiodrivenlaunchers.purge( Launcher );
+    m_inputdrivenlaunchers.purge( Launcher );
+}
+
 // adds specified event launcher to the list of global launchers
 void
 event_manager::queue( TEventLauncher *Launcher ) {
 
-    m_launcherqueue.emplace_back( Launcher );
+    m_launcherqueue.insert( Launcher );
+    if( true == Launcher->IsKeyActivated() ) {
+        m_launcherkeyqueue.emplace_back( Launcher );
+    }
 }
 
 // inserts in the event query events assigned to event launchers capable of receiving specified radio message sent from specified location
@@ -2273,7 +2304,11 @@ event_manager::update() {
     // process currently queued events
     CheckQuery();
     // test list of global events for possible new additions to the queue
-    for( auto *launcher : m_launcherqueue ) {
+    // global launchers are activated at specific time of day, so only the ones scheduled for current minute are tested
+    auto const &time { simulation::Time.data() };
+    auto const duelaunchers { m_launcherqueue.due( time.wHour * 60 + time.wMinute ) };
+    for( auto launcheriter { duelaunchers.first }; launcheriter != duelaunchers.second; ++launcheriter ) {
+        auto *launcher { *launcheriter };
 		if (launcher->check_conditions() && launcher->Event1) {
 			// NOTE: we're presuming global events aren't going to use event2
 
@@ -2281,6 +2316,10 @@ event_manager::update() {
 				WriteLog( "Eventlauncher: " + launcher->name() );
 				AddToQuery( launcher->Event1, nullptr );
 			}
+		}
+    }
+    for( auto *launcher : m_launcherkeyqueue ) {
+		if (launcher->check_conditions() && launcher->Event1) {
 
 			if (launcher->check_activation_key()) {
 				WriteLog( "Eventlauncher: " + launcher->name() );
@@ -2424,37 +2463,9 @@ event_manager::AddToQuery( basic_event *Event, TDynamicObject const *Owner, doub
         }
         // NOTE: sanity check, as departure-based delay math can potentially produce negative overall delay
         Event->m_launchtime = std::max( Event->m_launchtime, 0.0 );
-        if( QueryRootEvent != nullptr ) {
-            basic_event *target { QueryRootEvent };
-            basic_event *previous { nullptr };
-            while( ( Event->m_launchtime >= target->m_launchtime )
-                && ( target->m_next != nullptr ) ) {
-                previous = target;
-                target = target->m_next;
-            }
-            // the new event will be either before or after the one we located
-            if( Event->m_launchtime >= target->m_launchtime ) {
-                assert( target->m_next == nullptr );
-                target->m_next = Event;
-                // if we have resurrected event land at the end of list, the link from previous run could potentially "add" unwanted events to the queue
-                Event->m_next = nullptr;
-            }
-            else {
-                if( previous != nullptr ) {
-                    previous->m_next = Event;
-                    Event->m_next = target;
-                }
-                else {
-                    // special case, we're inserting our event at the very start
-                    Event->m_next = QueryRootEvent;
-                    QueryRootEvent = Event;
-                }
-            }
-        }
-        else {
-            QueryRootEvent = Event;
-            QueryRootEvent->m_next = nullptr;
-        }
+        // kolejka eventów jest posortowana względem czasu wykonania, a przy równym czasie względem kolejności dodania
+        m_eventqueue.push_back( { Event->m_launchtime, m_eventqueuecounter++, Event } );
+        std::push_heap( std::begin( m_eventqueue ), std::end( m_eventqueue ) );
     }
 
     return true;
@@ -2464,21 +2475,23 @@ event_manager::AddToQuery( basic_event *Event, TDynamicObject const *Owner, doub
 bool
 event_manager::CheckQuery() {
 
-    while( ( QueryRootEvent != nullptr )
-        && ( QueryRootEvent->m_launchtime < Timer::GetTime() ) )
+    while( ( false == m_eventqueue.empty() )
+        && ( m_eventqueue.front().launchtime < Timer::GetTime() ) )
     { // eventy są posortowana wg czasu wykonania
-        m_workevent = QueryRootEvent; // wyjęcie eventu z kolejki
-        if (QueryRootEvent->m_sibling) // jeśli jest kolejny o takiej samej nazwie
+        std::pop_heap( std::begin( m_eventqueue ), std::end( m_eventqueue ) );
+        auto const entry { m_eventqueue.back() };
+        m_eventqueue.pop_back();
+        m_workevent = entry.event; // wyjęcie eventu z kolejki
+        if( m_workevent->m_sibling ) // jeśli jest kolejny o takiej samej nazwie
         { // to teraz on będzie następny do wykonania
-            QueryRootEvent = QueryRootEvent->m_sibling; // następny będzie ten doczepiony
-            QueryRootEvent->m_next = m_workevent->m_next; // pamiętając o następnym z kolejki
-            QueryRootEvent->m_launchtime = m_workevent->m_launchtime; // czas musi być ten sam, bo nie jest aktualizowany
-            QueryRootEvent->m_activator = m_workevent->m_activator; // pojazd aktywujący
-            QueryRootEvent->m_inqueue = 1;
-            // w sumie można by go dodać normalnie do kolejki, ale trzeba te połączone posortować wg czasu wykonania
-        }
-        else // a jak nazwa jest unikalna, to kolejka idzie dalej
-            QueryRootEvent = QueryRootEvent->m_next; // NULL w skrajnym przypadku
+            auto *sibling { m_workevent->m_sibling }; // następny będzie ten doczepiony
+            sibling->m_launchtime = m_workevent->m_launchtime; // czas musi być ten sam, bo nie jest aktualizowany
+            sibling->m_activator = m_workevent->m_activator; // pojazd aktywujący
+            sibling->m_inqueue = 1;
+            // reusing the key of the processed entry places the sibling back at the top of the queue
+            m_eventqueue.push_back( { entry.launchtime, entry.order, sibling } );
+            std::push_heap( std::begin( m_eventqueue ), std::end( m_eventqueue ) );
+        }
         if( ( false == m_workevent->m_ignored ) && ( false == m_workevent->m_passive ) ) {
             // w zasadzie te wyłączone są skanowane i nie powinny się nigdy w kolejce znaleźć
             --(m_workevent->m_inqueue); // teraz moze być ponownie dodany do kolejki
@@ -2488,6 +2501,92 @@ event_manager::CheckQuery() {
     return true;
 }
 
+// returns queued events, in order of their execution
+std::vector<basic_event *>
+event_manager::queued() const {
+
+    auto queue { m_eventqueue };
+    // heap entries put the earliest event at the top, so the reverse of their order is the execution order
+    std::sort( std::rbegin( queue ), std::rend( queue ) );
+
+    std::vector<basic_event *> events;
+    events.reserve( queue.size() );
+    for( auto const &entry : queue ) {
+        events.emplace_back( entry.event );
+    }
+    return events;
+}
+
+// sends content of the event query to provided stream
+void
+event_manager::serialize_queue( std::ostream &Output ) const {
+
+    // events are identified by their position in the event table, which is the same for each load of given scenario
+    std::unordered_map<basic_event const *, std::uint32_t> eventindices;
+    for( std::size_t idx = 0; idx < m_events.size(); ++idx ) {
+        eventindices.emplace( m_events[ idx ], static_cast<std::uint32_t>( idx ) );
+    }
+    sn_utils::ls_uint64( Output, m_eventqueuecounter );
+    sn_utils::ls_uint32( Output, static_cast<std::uint32_t>( m_eventqueue.size() ) );
+    // heap layout is preserved as is, so the restored query doesn't need to be rebuilt
+    for( auto const &entry : m_eventqueue ) {
+        sn_utils::ls_uint32( Output, eventindices.at( entry.event ) );
+        sn_utils::ls_float64( Output, entry.launchtime );
+        sn_utils::ls_uint64( Output, entry.order );
+        sn_utils::ls_int32( Output, entry.event->m_inqueue );
+        sn_utils::s_str( Output, ( entry.event->m_activator != nullptr ? entry.event->m_activator->name() : "" ) );
+    }
+}
+
+// retrieves content of the event query from provided stream. returns: query data, or nothing on failure
+auto
+event_manager::read_queue( std::istream &Input ) -> std::optional<queue_state> {
+
+    queue_state state;
+    state.counter = sn_utils::ld_uint64( Input );
+    auto const queuesize { sn_utils::ld_uint32( Input ) };
+    for( std::uint32_t idx = 0; ( idx < queuesize ) && ( true == Input.good() ); ++idx ) {
+        auto const eventindex { sn_utils::ld_uint32( Input ) };
+        queue_state::entry entry;
+        entry.launchtime = sn_utils::ld_float64( Input );
+        entry.order = sn_utils::ld_uint64( Input );
+        entry.inqueue = sn_utils::ld_int32( Input );
+        auto const activatorname { sn_utils::d_str( Input ) };
+
+        entry.event = FindEventById( eventindex );
+        if( entry.event == nullptr ) {
+            ErrorLog( "Bad state: event query references unknown event #" + std::to_string( eventindex ) );
+            return std::nullopt;
+        }
+        entry.activator = (
+            activatorname.empty() ?
+                nullptr :
+                simulation::Vehicles.find( activatorname ) );
+        state.entries.emplace_back( entry );
+    }
+    if( false == Input.good() ) {
+        return std::nullopt;
+    }
+    return state;
+}
+
+// replaces content of the event query with provided data
+void
+event_manager::apply_queue( queue_state const &State ) {
+
+    for( auto *event : m_events ) {
+        event->m_inqueue = 0;
+    }
+    m_eventqueue.clear();
+    m_eventqueuecounter = State.counter;
+    for( auto const &entry : State.entries ) {
+        entry.event->m_inqueue = entry.inqueue;
+        entry.event->m_launchtime = entry.launchtime;
+        entry.event->m_activator = entry.activator;
+        m_eventqueue.push_back( { entry.launchtime, entry.order, entry.event } );
+    }
+}
+
 // legacy method, initializes events after deserialization from scenario file
 void
 event_manager::InitEvents() {
@@ -2517,6 +2616,9 @@ event_manager::InitLaunchers() {
                     if( launcher->MemCell == nullptr ) {
                         ErrorLog( "Bad scenario: event launcher \"" + launcher->name() + "\" can't find memcell \"" + launcher->asMemCellName + "\"" );
                     }
+                    else {
+                        launcher->MemCell->subscribe( launcher );
+                    }
                 }
                 else {
                     launcher->MemCell = nullptr;
@@ -83,11 +83,14 @@ public:
     virtual TCommandType input_command() const;
     virtual double input_value( int Index ) const;
     virtual glm::dvec3 input_location() const;
+    // returns: change counter of the input data, stays the same for events with fixed input
+    virtual std::uint32_t input_revision() const;
     void group( scene::group_handle Group );
     scene::group_handle group() const;
 	std::string const &name() const { return m_name; }
+    // returns: true while the event is being executed
+    bool is_running() const { return m_running; }
 // members
-    basic_event *m_next { nullptr }; // następny w kolejce // TODO: replace with event list in the manager
     basic_event *m_sibling { nullptr }; // kolejny event z tą samą nazwą - od wersji 378
     std::string m_name;
     bool m_ignored { false }; // replacement for tp_ignored
@@ -149,6 +152,7 @@ private:
     virtual void export_as_text_( std::ostream &Output ) const = 0;
 // members
     scene::group_handle m_group { null_handle }; // group this event belongs to, if any
+    bool m_running { false }; // set for duration of run()
 };
 
 
@@ -241,6 +245,7 @@ public:
     TCommandType input_command() const override;
     double input_value( int Index ) const override;
     glm::dvec3 input_location() const override;
+    std::uint32_t input_revision() const override;
 
 private:
 // methods
@@ -636,6 +641,19 @@ make_event( cParser &Input, scene::scratch_data &Scratchpad );
 class event_manager {
 
 public:
+// types
+    // content of the event query, in form which can be restored later
+    struct queue_state {
+        struct entry {
+            basic_event *event;
+            double launchtime;
+            std::uint64_t order;
+            int inqueue;
+            TDynamicObject const *activator;
+        };
+        std::uint64_t counter { 0 };
+        std::vector<entry> entries;
+    };
 // constructors
     event_manager() = default;
 // destructor
@@ -661,14 +679,25 @@ public:
                 Launcher->IsRadioActivated() ?
                     m_radiodrivenlaunchers.insert( Launcher ) :
                     m_inputdrivenlaunchers.insert( Launcher ) ); }
-    inline void purge (TEventLauncher *Launcher) {
-		m_radiodrivenlaunchers.purge(Launcher);
-		m_inputdrivenlaunchers.purge(Launcher); }
-    // returns first event in the queue
-    inline
-    basic_event *
-        begin() {
-            return QueryRootEvent; }
+    // removes provided event launcher from the collection
+    void
+        purge( TEventLauncher *Launcher );
+    // returns queued events, in order of their execution
+    std::vector<basic_event *>
+        queued() const;
+    // returns true if the scenario uses global launchers. their activation state isn't part of the serialized state
+    bool
+        has_global_launchers() const {
+            return ( false == m_launcherqueue.empty() ); }
+    // sends content of the event query to provided stream
+    void
+        serialize_queue( std::ostream &Output ) const;
+    // retrieves content of the event query from provided stream. returns: query data, or nothing on failure
+    auto
+        read_queue( std::istream &Input ) -> std::optional<queue_state>;
+    // replaces content of the event query with provided data
+    void
+        apply_queue( queue_state const &State );
 
 	basic_event*
 	    FindEventById(uint32_t id);
@@ -706,19 +735,29 @@ private:
     using event_sequence = std::deque<basic_event *>;
     using event_map = std::unordered_map<std::string, std::size_t>;
     using eventlauncher_sequence = std::vector<TEventLauncher *>;
+    // event query entry. events due at the same time are executed in order of their addition to the query
+    struct queued_event {
+        double launchtime;
+        std::uint64_t order;
+        basic_event *event;
+        // heap ordering; puts earliest entry at the top
+        bool operator<( queued_event const &Right ) const {
+            return (
+                launchtime != Right.launchtime ?
+                    launchtime > Right.launchtime :
+                    order > Right.order ); }
+    };
+    using event_queue = std::vector<queued_event>;
 // members
     event_sequence m_events;
-/*
-    // NOTE: disabled until event class refactoring
-    event_sequence m_eventqueue;
-*/
-    // legacy version of the above
-    basic_event *QueryRootEvent { nullptr };
+    event_queue m_eventqueue; // binary heap of events scheduled for execution
+    std::uint64_t m_eventqueuecounter { 0 }; // source of insertion order for queued events
     basic_event *m_workevent { nullptr };
     event_map m_eventmap;
     basic_table<TEventLauncher> m_inputdrivenlaunchers;
     basic_table<TEventLauncher> m_radiodrivenlaunchers;
-    eventlauncher_sequence m_launcherqueue;
+    launcher_schedule m_launcherqueue; // global launchers, ordered by activation time
+    eventlauncher_sequence m_launcherkeyqueue; // global launchers which can be also activated by key press
 	command_relay m_relay;
 };
 
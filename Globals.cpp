@@ -191,6 +191,22 @@ global_settings::ConfigParse(cParser &Parser) {
             Parser.getTokens();
             Parser >> FullPhysics;
         }
+        else if (token == "physics.parallel")
+        {
+            Parser.getTokens();
+            Parser >> ParallelPhysics;
+        }
+        else if (token == "physics.threads")
+        {
+            Parser.getTokens();
+            Parser >> PhysicsThreads;
+            PhysicsThreads = clamp( PhysicsThreads, 0, 64 );
+        }
+        else if (token == "physics.dormancy")
+        {
+            Parser.getTokens();
+            Parser >> DormantVehicles;
+        }
         else if (token == "debuglog")
         {
             // McZapkie-300402 - wylaczanie log.txt
@@ -852,6 +868,12 @@ global_settings::ConfigParse(cParser &Parser) {
 			Parser.getTokens(1);
 			Parser >> python_uploadmain;
 		}
+		else if (token == "python.workers")
+		{
+			Parser.getTokens(1);
+			Parser >> python_workers;
+			python_workers = clamp(python_workers, 1, 8);
+		}
 		else if (token == "python.fpslimit")
 		{
 			Parser.getTokens(1);
@@ -960,6 +982,11 @@ global_settings::ConfigParse(cParser &Parser) {
 			Parser >> network_client->first;
 			Parser >> network_client->second;
 		}
+		else if (token == "network.record")
+		{
+			Parser.getTokens(1, false);
+			Parser >> network_recording;
+		}
 		else if (token == "execonexit") {
 			Parser.getTokens(1);
 			Parser >> exec_on_exit;
@@ -1148,6 +1175,28 @@ global_settings::ConfigParse_gfx( cParser &Parser, std::string_view const Token
         Parser.getTokens(1);
         Parser >> gfx_shadergamma;
     }
+    else if (Token == "gfx.texture.asyncdecode")
+    {
+        Parser.getTokens(1);
+        Parser >> gfx_texture_asyncdecode;
+    }
+    else if (Token == "gfx.texture.uploadbudget")
+    {
+        Parser.getTokens(1);
+        Parser >> gfx_texture_uploadbudget;
+        gfx_texture_uploadbudget = std::max(gfx_texture_uploadbudget, 0.f);
+    }
+    else if (Token == "gfx.model.asyncload")
+    {
+        Parser.getTokens(1);
+        Parser >> gfx_model_asyncload;
+    }
+    else if (Token == "gfx.model.uploadbudget")
+    {
+        Parser.getTokens(1);
+        Parser >> gfx_model_uploadbudget;
+        gfx_model_uploadbudget = std::max(gfx_model_uploadbudget, 0.f);
+    }
     else if (Token == "gfx.drawrange.factor.max")
     {
         Parser.getTokens(1);
@@ -1214,6 +1263,9 @@ global_settings::export_as_text( std::ostream &Output ) const {
     export_as_text( Output, "sound.volume.ambient", EnvironmentAmbientVolume );
     export_as_text( Output, "physicslog", WriteLogFlag );
     export_as_text( Output, "fullphysics", FullPhysics );
+    export_as_text( Output, "physics.parallel", ParallelPhysics );
+    export_as_text( Output, "physics.threads", PhysicsThreads );
+    export_as_text( Output, "physics.dormancy", DormantVehicles );
     export_as_text( Output, "debuglog", iWriteLogEnabled );
     export_as_text( Output, "multiplelogs", MultipleLogs );
     export_as_text( Output, "logs.filter", DisabledLogTypes );
@@ -1390,11 +1442,16 @@ global_settings::export_as_text( std::ostream &Output ) const {
     export_as_text( Output, "gfx.skippipeline", gfx_skippipeline );
     export_as_text( Output, "gfx.extraeffects", gfx_extraeffects );
     export_as_text( Output, "gfx.shadergamma", gfx_shadergamma );
+    export_as_text( Output, "gfx.texture.asyncdecode", gfx_texture_asyncdecode );
+    export_as_text( Output, "gfx.texture.uploadbudget", gfx_texture_uploadbudget );
+    export_as_text( Output, "gfx.model.asyncload", gfx_model_asyncload );
+    export_as_text( Output, "gfx.model.uploadbudget", gfx_model_uploadbudget );
     export_as_text( Output, "gfx.shadow.angle.min", gfx_shadow_angle_min );
     export_as_text( Output, "gfx.shadow.rank.cutoff", gfx_shadow_rank_cutoff );
     export_as_text( Output, "python.enabled", python_enabled );
     export_as_text( Output, "python.threadedupload", python_threadedupload );
     export_as_text( Output, "python.uploadmain", python_uploadmain );
+    export_as_text( Output, "python.workers", python_workers );
     export_as_text( Output, "python.mipmaps", python_mipmaps );
     for( auto const &server : network_servers ) {
         Output
@@ -1406,6 +1463,7 @@ global_settings::export_as_text( std::ostream &Output ) const {
             << "network.client "
             << network_client->first << " " << network_client->second << "\n";
     }
+    export_as_text( Output, "network.record", network_recording );
     export_as_text( Output, "execonexit", exec_on_exit );
 }
 
@@ -90,6 +90,9 @@ struct global_settings {
     std::string Weather{ "cloudy:" }; // current weather
     std::string Period{}; // time of the day, based on sun position
     bool FullPhysics{ true }; // full calculations performed for each simulation step
+    bool ParallelPhysics{ false }; // independent consists are calculated by worker threads
+    int PhysicsThreads{ 0 }; // number of physics worker threads, 0 picks count based on available hardware
+    bool DormantVehicles{ true }; // parked vehicles are excluded from simulation updates until disturbed
     bool bnewAirCouplers{ true };
     float fMoveLight{ 0.f }; // numer dnia w roku albo -1
     bool FakeLight{ false }; // toggle between fixed and dynamic daylight
@@ -236,6 +239,7 @@ struct global_settings {
 	bool python_vsync = true;
 	bool python_sharectx = true;
 	bool python_uploadmain = true;
+	int python_workers = 1; // number of threads executing python screen renderers
 	std::chrono::duration<float> python_minframetime {0.01f};
 
     bool gfx_skiprendering = false;
@@ -255,6 +259,10 @@ struct global_settings {
     bool gfx_usegles = false;
     std::string gfx_angleplatform;
     bool gfx_gldebug = false;
+    bool gfx_texture_asyncdecode { true }; // textures requested without immediate load are decoded by worker threads
+    float gfx_texture_uploadbudget { 2.f }; // time allotted per frame to upload of textures decoded in the background, in milliseconds
+    bool gfx_model_asyncload { true }; // models added to running simulation are loaded by worker threads
+    float gfx_model_uploadbudget { 2.f }; // time allotted per frame to setup of models loaded in the background, in milliseconds
     bool vr = false;
     std::string vr_backend;
 
@@ -311,6 +319,7 @@ struct global_settings {
 
 	std::vector<std::pair<std::string, std::string>> network_servers;
 	std::optional<std::pair<std::string, std::string>> network_client;
+	std::string network_recording; // session recording file, written by the server
 	float desync = 0.0f;
 
 	std::unordered_map<int, std::string> trainset_overrides;
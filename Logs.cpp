@@ -23,6 +23,7 @@ char logbuffer[ 256 ];
 char endstring[10] = "\n";
 
 std::deque<std::string> log_scrollback;
+std::mutex logmutex; // log entries can be sent from worker threads
 
 std::string filename_date() {
     ::SYSTEMTIME st;
@@ -73,6 +74,8 @@ void WriteLog( const char *str, logtype const Type ) {
     if( str == nullptr ) { return; }
     if( true == TestFlag( Global.DisabledLogTypes, static_cast<unsigned int>( Type ) ) ) { return; }
 
+    std::lock_guard<std::mutex> lock( logmutex );
+
     if (Global.iWriteLogEnabled & 1) {
         if( !output.is_open() ) {
 
@@ -103,6 +106,13 @@ void WriteLog( const char *str, logtype const Type ) {
     }
 }
 
+std::deque<std::string> LogScrollback() {
+
+    std::lock_guard<std::mutex> lock( logmutex );
+
+    return log_scrollback;
+}
+
 void ErrorLog( const char *str, logtype const Type ) {
 
     if( str == nullptr ) { return; }
@@ -111,6 +121,8 @@ void ErrorLog( const char *str, logtype const Type ) {
     if (!(Global.iWriteLogEnabled & 1))
         return;
 
+    std::lock_guard<std::mutex> lock( logmutex );
+
     if (!errors.is_open()) {
 
         std::string const filename =
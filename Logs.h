@@ -32,4 +32,5 @@ void WriteLog( const std::string &str, logtype const Type = logtype::generic );
 void CommLog( const char *str );
 void CommLog( const std::string &str );
 
-extern std::deque<std::string> log_scrollback;
+// returns copy of recent log entries, safe to use while worker threads keep logging
+std::deque<std::string> LogScrollback();
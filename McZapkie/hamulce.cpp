@@ -17,6 +17,7 @@ Copyright (C) 2007-2014 Maciej Cierniak
 #include <typeinfo>
 #include "MOVER.h"
 #include "utilities.h"
+#include "sn_utils.h"
 
 //---FUNKCJE OGOLNE---
 
@@ -174,6 +175,20 @@ void TReservoir::CreatePress(double Press)
     dVol = 0;
 }
 
+// sends runtime state of the reservoir to provided stream
+void TReservoir::serialize_state( std::ostream &Output ) const
+{
+    sn_utils::ls_float64( Output, Vol );
+    sn_utils::ls_float64( Output, dVol );
+}
+
+// restores runtime state of the reservoir from provided stream
+void TReservoir::deserialize_state( std::istream &Input )
+{
+    Vol = sn_utils::ld_float64( Input );
+    dVol = sn_utils::ld_float64( Input );
+}
+
 //---SILOWNIK---
 double TBrakeCyl::pa()
 // var VtoC: real;
@@ -417,6 +432,28 @@ void TBrake::SetASBP( double const Press )
     ASBP = Press;
 }
 
+// sends runtime state of the brake to provided stream
+void TBrake::serialize_state( std::ostream &Output ) const
+{
+    BrakeCyl->serialize_state( Output );
+    BrakeRes->serialize_state( Output );
+    ValveRes->serialize_state( Output );
+    sn_utils::ls_int32( Output, BrakeDelayFlag );
+    sn_utils::ls_int32( Output, BrakeStatus );
+    sn_utils::ls_int32( Output, UniversalFlag );
+}
+
+// restores runtime state of the brake from provided stream
+void TBrake::deserialize_state( std::istream &Input )
+{
+    BrakeCyl->deserialize_state( Input );
+    BrakeRes->deserialize_state( Input );
+    ValveRes->deserialize_state( Input );
+    BrakeDelayFlag = sn_utils::ld_int32( Input );
+    BrakeStatus = sn_utils::ld_int32( Input );
+    UniversalFlag = sn_utils::ld_int32( Input );
+}
+
 void TBrake::ForceEmptiness()
 {
     ValveRes->CreatePress(0);
@@ -805,6 +842,18 @@ void TESt::ForceEmptiness() {
     CntrlRes->Act();
 }
 
+void TESt::serialize_state( std::ostream &Output ) const
+{
+    TBrake::serialize_state( Output );
+    CntrlRes->serialize_state( Output );
+}
+
+void TESt::deserialize_state( std::istream &Input )
+{
+    TBrake::deserialize_state( Input );
+    CntrlRes->deserialize_state( Input );
+}
+
 //---EP2---
 
 void TEStEP2::Init( double const PP, double const HPP, double const LPP, double const BP, int const BDF )
@@ -1146,6 +1195,22 @@ void TESt4R::Init( double const PP, double const HPP, double const LPP, double c
     BrakeDelayFlag = bdelay_R;
 }
 
+void TESt4R::serialize_state( std::ostream &Output ) const
+{
+    TESt::serialize_state( Output );
+    ImplsRes->serialize_state( Output );
+    sn_utils::s_bool( Output, RapidStatus );
+    sn_utils::ls_float64( Output, RapidTemp );
+}
+
+void TESt4R::deserialize_state( std::istream &Input )
+{
+    TESt::deserialize_state( Input );
+    ImplsRes->deserialize_state( Input );
+    RapidStatus = sn_utils::d_bool( Input );
+    RapidTemp = sn_utils::ld_float64( Input );
+}
+
 //---EST3/AL2---
 
 double TESt3AL2::GetPF( double const PP, double const dt, double const Vel )
@@ -1246,6 +1311,18 @@ void TESt3AL2::SetLP( double const TM, double const LM, double const TBP )
     TareBP = TBP;
 }
 
+void TESt3AL2::serialize_state( std::ostream &Output ) const
+{
+    TESt3::serialize_state( Output );
+    ImplsRes->serialize_state( Output );
+}
+
+void TESt3AL2::deserialize_state( std::istream &Input )
+{
+    TESt3::deserialize_state( Input );
+    ImplsRes->deserialize_state( Input );
+}
+
 void TESt3AL2::Init( double const PP, double const HPP, double const LPP, double const  BP, int const BDF )
 {
     TESt::Init(PP, HPP, LPP, BP, BDF);
@@ -1685,6 +1762,22 @@ void TEStED::SetLP( double const TM, double const LM, double const TBP )
     TareBP = TBP;
 }
 
+void TEStED::serialize_state( std::ostream &Output ) const
+{
+    TLSt::serialize_state( Output );
+    Miedzypoj->serialize_state( Output );
+    sn_utils::s_bool( Output, Zamykajacy );
+    sn_utils::s_bool( Output, Przys_blok );
+}
+
+void TEStED::deserialize_state( std::istream &Input )
+{
+    TLSt::deserialize_state( Input );
+    Miedzypoj->deserialize_state( Input );
+    Zamykajacy = sn_utils::d_bool( Input );
+    Przys_blok = sn_utils::d_bool( Input );
+}
+
 //---DAKO CV1---
 
 void TCV1::CheckState( double const BCP, double &dV1 )
@@ -1846,6 +1939,18 @@ void TCV1::ForceEmptiness() {
     CntrlRes->Act();
 }
 
+void TCV1::serialize_state( std::ostream &Output ) const
+{
+    TBrake::serialize_state( Output );
+    CntrlRes->serialize_state( Output );
+}
+
+void TCV1::deserialize_state( std::istream &Input )
+{
+    TBrake::deserialize_state( Input );
+    CntrlRes->deserialize_state( Input );
+}
+
 //---CV1-L-TR---
 
 void TCV1L_TR::SetLBP( double const P )
@@ -1863,6 +1968,18 @@ double TCV1L_TR::GetHPFlow( double const HP, double const dt )
     return dv;
 }
 
+void TCV1L_TR::serialize_state( std::ostream &Output ) const
+{
+    TCV1::serialize_state( Output );
+    ImplsRes->serialize_state( Output );
+}
+
+void TCV1L_TR::deserialize_state( std::istream &Input )
+{
+    TCV1::deserialize_state( Input );
+    ImplsRes->deserialize_state( Input );
+}
+
 void TCV1L_TR::Init( double const PP, double const HPP, double const LPP, double const BP, int const BDF )
 {
     TCV1::Init(PP, HPP, LPP, BP, BDF);
@@ -2260,6 +2377,24 @@ void TKE::ForceEmptiness() {
     Brak2Res->Act();
 }
 
+void TKE::serialize_state( std::ostream &Output ) const
+{
+    TBrake::serialize_state( Output );
+    ImplsRes->serialize_state( Output );
+    CntrlRes->serialize_state( Output );
+    Brak2Res->serialize_state( Output );
+    sn_utils::s_bool( Output, RapidStatus );
+}
+
+void TKE::deserialize_state( std::istream &Input )
+{
+    TBrake::deserialize_state( Input );
+    ImplsRes->deserialize_state( Input );
+    CntrlRes->deserialize_state( Input );
+    Brak2Res->deserialize_state( Input );
+    RapidStatus = sn_utils::d_bool( Input );
+}
+
 //---KRANY---
 
 double TDriverHandle::GetPF(double const i_bcp, double PP, double HP, double dt, double ep)
@@ -157,6 +157,10 @@ protected:
     virtual double P();
     void Flow(double dv);
     void Act();
+    // sends runtime state of the reservoir to provided stream
+    void serialize_state( std::ostream &Output ) const;
+    // restores runtime state of the reservoir from provided stream
+    void deserialize_state( std::istream &Input );
 
 		TReservoir() = default;
 };
@@ -232,6 +236,10 @@ class TBrake {
     void SetBrakeStatus( int const Status ) { BrakeStatus = Status; }
     virtual void SetED( double const EDstate ) {}; //stan hamulca ED do luzowania
 	virtual void SetUniversalFlag(int flag) { UniversalFlag = flag; } //przycisk uniwersalny
+    // sends runtime state of the brake to provided stream
+    virtual void serialize_state( std::ostream &Output ) const;
+    // restores runtime state of the brake from provided stream
+    virtual void deserialize_state( std::istream &Input );
 };
 
 class TWest : public TBrake {
@@ -277,6 +285,8 @@ class TESt : public TBrake {
 		double CVs(double BP);      //napelniacz sterujacego
 		double BVs(double BCP);     //napelniacz pomocniczego
         void ForceEmptiness() /*override*/; // wymuszenie bycia pustym
+        void serialize_state( std::ostream &Output ) const /*override*/;
+        void deserialize_state( std::istream &Input ) /*override*/;
 
 		inline TESt(double i_mbp, double i_bcr, double i_bcd, double i_brc, int i_bcn, int i_BD, int i_mat, int i_ba, int i_nbpa) :
              TBrake(       i_mbp,        i_bcr,        i_bcd,        i_brc,     i_bcn,     i_BD,     i_mat,     i_ba,     i_nbpa)
@@ -312,6 +322,8 @@ class TESt3AL2 : public TESt3 {
       double GetPF( double const PP, double const dt, double const Vel )/*override*/;      //przeplyw miedzy komora wstepna i PG
 		void PLC(double const mass);  //wspolczynnik cisnienia przystawki wazacej
 		void SetLP(double const TM, double const LM, double const TBP);  //parametry przystawki wazacej
+        void serialize_state( std::ostream &Output ) const /*override*/;
+        void deserialize_state( std::istream &Input ) /*override*/;
 
 		inline TESt3AL2(double i_mbp, double i_bcr, double i_bcd, double i_brc, int i_bcn, int i_BD, int i_mat, int i_ba, int i_nbpa) :
                   TESt3(       i_mbp,        i_bcr,        i_bcd,        i_brc,     i_bcn,     i_BD,     i_mat,     i_ba,     i_nbpa)
@@ -332,6 +344,8 @@ class TESt4R : public TESt {
   public:
       void Init( double const PP, double const HPP, double const LPP, double const BP, int const BDF )/*override*/;
       double GetPF( double const PP, double const dt, double const Vel )/*override*/;      //przeplyw miedzy komora wstepna i PG
+      void serialize_state( std::ostream &Output ) const /*override*/;
+      void deserialize_state( std::istream &Input ) /*override*/;
 
 		inline TESt4R(double i_mbp, double i_bcr, double i_bcd, double i_brc, int i_bcn, int i_BD, int i_mat, int i_ba, int i_nbpa) :
                  TESt(       i_mbp,        i_bcr,        i_bcd,        i_brc,     i_bcn,     i_BD,     i_mat,     i_ba,     i_nbpa)
@@ -383,6 +397,8 @@ class TEStED : public TLSt {  //zawor z EP09 - Est4 z oddzielnym przekladnikiem,
 		double GetEDBCP()/*override*/;    //cisnienie tylko z hamulca zasadniczego, uzywane do hamulca ED
 		void PLC(double const mass);  //wspolczynnik cisnienia przystawki wazacej
         void SetLP( double const TM, double const LM, double const TBP );  //parametry przystawki wazacej        
+        void serialize_state( std::ostream &Output ) const /*override*/;
+        void deserialize_state( std::istream &Input ) /*override*/;
 
 		inline TEStED(double i_mbp, double i_bcr, double i_bcd, double i_brc, int i_bcn, int i_BD, int i_mat, int i_ba, int i_nbpa) :
                  TLSt(       i_mbp,        i_bcr,        i_bcd,        i_brc,     i_bcn,     i_BD,     i_mat,     i_ba,     i_nbpa)
@@ -440,6 +456,8 @@ public:
     double CVs( double const BP );
     double BVs( double const BCP );
     void ForceEmptiness() /*override*/; // wymuszenie bycia pustym
+    void serialize_state( std::ostream &Output ) const /*override*/;
+    void deserialize_state( std::istream &Input ) /*override*/;
 
 		inline TCV1(double i_mbp, double i_bcr, double i_bcd, double i_brc, int i_bcn, int i_BD, int i_mat, int i_ba, int i_nbpa) :
              TBrake(       i_mbp,        i_bcr,        i_bcd,        i_brc,     i_bcn,     i_BD,     i_mat,     i_ba,     i_nbpa)
@@ -476,6 +494,8 @@ public:
     double GetPF( double const PP, double const dt, double const Vel )/*override*/;      //przeplyw miedzy komora wstepna i PG
     void SetLBP( double const P );   //cisnienie z hamulca pomocniczego
     double GetHPFlow( double const HP, double const dt )/*override*/;  //przeplyw - 8 bar
+    void serialize_state( std::ostream &Output ) const /*override*/;
+    void deserialize_state( std::istream &Input ) /*override*/;
 
     inline TCV1L_TR(double i_mbp, double i_bcr, double i_bcd, double i_brc, int i_bcn, int i_BD, int i_mat, int i_ba, int i_nbpa) :
                TCV1(       i_mbp,        i_bcr,        i_bcd,        i_brc,     i_bcn,     i_BD,     i_mat,     i_ba,     i_nbpa)
@@ -513,6 +533,8 @@ class TKE : public TBrake { //Knorr Einheitsbauart — jeden do wszystkiego
         void SetLP( double const TM, double const LM, double const TBP );  //parametry przystawki wazacej
         void SetLBP( double const P );   //cisnienie z hamulca pomocniczego
         void ForceEmptiness() /*override*/; // wymuszenie bycia pustym
+        void serialize_state( std::ostream &Output ) const /*override*/;
+        void deserialize_state( std::istream &Input ) /*override*/;
 
 		inline TKE(double i_mbp, double i_bcr, double i_bcd, double i_brc, int i_bcn, int i_BD, int i_mat, int i_ba, int i_nbpa) :
             TBrake(       i_mbp,        i_bcr,        i_bcd,        i_brc,     i_bcn,     i_BD,     i_mat,     i_ba,     i_nbpa)
@@ -39,6 +39,8 @@ TMdlContainer::LoadModel(std::string const &Name, bool const Dynamic) {
 
 TModelsManager::modelcontainer_sequence TModelsManager::m_models { 1, TMdlContainer{} };
 TModelsManager::stringmodelcontainerindex_map TModelsManager::m_modelsmap;
+TModelsManager::pendingmodel_sequence TModelsManager::m_pendingmodels;
+threading::worker_pool TModelsManager::m_loaders;
 
 // wczytanie modelu do tablicy
 TModel3d *
@@ -56,8 +58,116 @@ TModelsManager::LoadModel(std::string const &Name, std::string const &virtualNam
     return model;
 }
 
+// utworzenie pustego modelu, wczytywanego w tle
 TModel3d *
-TModelsManager::GetModel(std::string const &Name, bool const Dynamic, bool const Logerrors, int uid )
+TModelsManager::RequestModel(std::string const &Name, std::string const &virtualName, bool dynamic) {
+
+    if( m_loaders.size() == 0 ) {
+        m_loaders.start( 1 );
+    }
+    m_models.emplace_back();
+    auto &container { m_models.back() };
+    container.Model = std::make_shared<TModel3d>();
+    container.Model->NameSet( Name );
+    container.Model->is_loading( true );
+    container.m_name = Name;
+    m_modelsmap.emplace( virtualName, m_models.size() - 1 );
+
+    auto request { std::make_shared<std::packaged_task<std::shared_ptr<TModel3d>()>>(
+        [=]() {
+            auto data { std::make_shared<TModel3d>() };
+            data->LoadDataFromBinFile( Name + ".e3d" );
+            return data; } ) };
+    m_pendingmodels.push_back( {
+        container.Model.get(),
+        request->get_future(),
+        nullptr,
+        Global.asCurrentTexturePath,
+        dynamic } );
+    m_loaders.push( [=]() { ( *request )(); } );
+
+    return container.Model.get();
+}
+
+// continues setup of provided model until specified deadline. returns: true if the model is complete
+bool
+TModelsManager::finalize( pending_model &Model, std::chrono::steady_clock::time_point const Deadline ) {
+
+    if( Model.data == nullptr ) {
+        try {
+            Model.data = Model.request.get();
+        }
+        catch( std::exception const &Error ) {
+            ErrorLog( "Bad model: failed to load 3d model \"" + Model.model->NameGet() + "\" (" + Error.what() + ")" );
+            // the placeholder stays empty
+            Model.model->is_loading( false );
+            return true;
+        }
+    }
+    // material lookups performed during setup rely on the texture path
+    std::string const texturepath { Global.asCurrentTexturePath };
+    Global.asCurrentTexturePath = Model.texturepath;
+
+    auto &data { *Model.data };
+    while( Model.submodelindex < data.SubModelsCount() ) {
+        data.init_submodel( Model.submodelindex++, Model.dynamic );
+        if( std::chrono::steady_clock::now() >= Deadline ) { break; }
+    }
+    auto const iscomplete { Model.submodelindex >= data.SubModelsCount() };
+    if( true == iscomplete ) {
+        data.Init();
+        Model.model->swap( data );
+        if( Model.model->SubModelsCount() == 0 ) {
+            ErrorLog( "Bad model: failed to load 3d model \"" + Model.model->NameGet() + "\"" );
+        }
+    }
+
+    Global.asCurrentTexturePath = texturepath;
+    return iscomplete;
+}
+
+// completes setup of specified model right away
+void
+TModelsManager::complete( TModel3d const *Model ) {
+
+    auto lookup {
+        std::find_if(
+            std::begin( m_pendingmodels ), std::end( m_pendingmodels ),
+            [=]( pending_model const &Pending ) {
+                return Pending.model == Model; } ) };
+    if( lookup == std::end( m_pendingmodels ) ) { return; }
+
+    finalize( *lookup, std::chrono::steady_clock::time_point::max() );
+    m_pendingmodels.erase( lookup );
+}
+
+// completes setup of models loaded in the background, within per-frame time budget
+void
+TModelsManager::update() {
+
+    if( m_pendingmodels.empty() ) { return; }
+
+    auto const deadline {
+        std::chrono::steady_clock::now()
+        + std::chrono::duration_cast<std::chrono::steady_clock::duration>( std::chrono::duration<float, std::milli>( Global.gfx_model_uploadbudget ) ) };
+
+    auto pending { std::begin( m_pendingmodels ) };
+    while( ( pending != std::end( m_pendingmodels ) )
+        && ( std::chrono::steady_clock::now() < deadline ) ) {
+        // models are set up in order of completion of their data retrieval
+        if( ( pending->data == nullptr )
+         && ( pending->request.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready ) ) {
+            ++pending;
+            continue;
+        }
+        if( true == finalize( *pending, deadline ) ) {
+            pending = m_pendingmodels.erase( pending );
+        }
+    }
+}
+
+TModel3d *
+TModelsManager::GetModel(std::string const &Name, bool const Dynamic, bool const Logerrors, int uid, bool const Loadnow )
 { // model może być we wpisie "node...model" albo "node...dynamic", a także być dodatkowym w dynamic
     // (kabina, wnętrze, ładunek)
     // dla "node...dynamic" mamy podaną ścieżkę w "\dynamic\" i musi być co najmniej 1 poziom, zwkle
@@ -98,6 +208,12 @@ TModelsManager::GetModel(std::string const &Name, bool const Dynamic, bool const
 	auto banklookup { find_in_databank( filename + postfix ) };
     TModel3d *model { banklookup.second };
     if( true == banklookup.first ) {
+        if( ( true == Loadnow )
+         && ( model != nullptr )
+         && ( true == model->is_loading() ) ) {
+            // the caller can't wait for the model loaded in the background
+            complete( model );
+        }
         Global.asCurrentTexturePath = buftp;
         return model;
     }
@@ -106,7 +222,15 @@ TModelsManager::GetModel(std::string const &Name, bool const Dynamic, bool const
     std::string disklookup { find_on_disk( filename ) };
 
     if( false == disklookup.empty() ) {
-		model = LoadModel( disklookup, disklookup + postfix, Dynamic ); // model nie znaleziony, to wczytać
+        if( ( false == Loadnow )
+         && ( true == Global.gfx_model_asyncload )
+         && ( true == FileExists( disklookup + ".e3d" ) ) ) {
+            // only binary models can be loaded in the background, text models request materials as they're parsed
+            model = RequestModel( disklookup, disklookup + postfix, Dynamic );
+        }
+        else {
+		    model = LoadModel( disklookup, disklookup + postfix, Dynamic ); // model nie znaleziony, to wczytać
+        }
     }
     else {
         // there's nothing matching in the databank nor on the disk, report failure...
@@ -9,6 +9,7 @@ http://mozilla.org/MPL/2.0/.
 #pragma once
 
 #include "Classes.h"
+#include "utilities.h"
 
 class TMdlContainer {
     friend class TModelsManager;
@@ -22,17 +23,37 @@ private:
 class TModelsManager {
 public:
     // McZapkie: dodalem sciezke, notabene Path!=Patch :)
-	static TModel3d *GetModel(std::string const &Name, bool const dynamic = false, bool const Logerrors = true , int uid = 0);
+    // NOTE: with Loadnow == false binary models are loaded in the background, the returned model stays empty until it's ready
+	static TModel3d *GetModel(std::string const &Name, bool const dynamic = false, bool const Logerrors = true , int uid = 0, bool const Loadnow = true);
+    // completes setup of models loaded in the background, within per-frame time budget
+    static void update();
 
 private:
 // types:
     typedef std::deque<TMdlContainer> modelcontainer_sequence;
     typedef std::unordered_map<std::string, modelcontainer_sequence::size_type> stringmodelcontainerindex_map;
+    struct pending_model {
+        TModel3d *model; // placeholder handed to the callers, receives the data once it's ready
+        std::future<std::shared_ptr<TModel3d>> request; // data retrieval performed by a worker thread
+        std::shared_ptr<TModel3d> data; // retrieved data, being set up
+        std::string texturepath; // texture path active at the time of the request
+        bool dynamic;
+        int submodelindex { 0 }; // next submodel to set up
+    };
+    typedef std::deque<pending_model> pendingmodel_sequence;
 // members:
     static modelcontainer_sequence m_models;
     static stringmodelcontainerindex_map m_modelsmap;
+    static pendingmodel_sequence m_pendingmodels;
+    static threading::worker_pool m_loaders;
 // methods:
 	static TModel3d *LoadModel(std::string const &Name, const std::string &virtualName, bool const Dynamic );
+    // creates empty model and queues loading of its data on a worker thread
+	static TModel3d *RequestModel(std::string const &Name, const std::string &virtualName, bool const Dynamic );
+    // continues setup of provided model until specified deadline. returns: true if the model is complete
+    static bool finalize( pending_model &Model, std::chrono::steady_clock::time_point const Deadline );
+    // completes setup of specified model right away
+    static void complete( TModel3d const *Model );
     static std::pair<bool, TModel3d *> find_in_databank( std::string const &Name );
     // checks whether specified file exists. returns name of the located file, or empty string.
     static std::string find_on_disk( std::string const &Name );
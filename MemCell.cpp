@@ -19,6 +19,8 @@ http://mozilla.org/MPL/2.0/.
 #include "simulation.h"
 #include "Driver.h"
 #include "Event.h"
+#include "EvLaunch.h"
+#include "Timer.h"
 #include "Logs.h"
 
 //---------------------------------------------------------------------------
@@ -27,26 +29,104 @@ TMemCell::TMemCell( scene::node_data const &Nodedata ) : basic_node( Nodedata )
 
 void TMemCell::UpdateValues( std::string const &szNewText, double const fNewValue1, double const fNewValue2, int const CheckMask )
 {
+    auto changed { false };
     if (CheckMask & basic_event::flags::mode_add)
     { // dodawanie wartości
-        if( TestFlag( CheckMask, basic_event::flags::text ) )
+        if( ( TestFlag( CheckMask, basic_event::flags::text ) ) && ( false == szNewText.empty() ) ) {
             szText += szNewText;
-        if (TestFlag(CheckMask, basic_event::flags::value1))
+            changed = true;
+        }
+        if( ( TestFlag( CheckMask, basic_event::flags::value1 ) ) && ( fNewValue1 != 0.0 ) ) {
             fValue1 += fNewValue1;
-        if (TestFlag(CheckMask, basic_event::flags::value2))
+            changed = true;
+        }
+        if( ( TestFlag( CheckMask, basic_event::flags::value2 ) ) && ( fNewValue2 != 0.0 ) ) {
             fValue2 += fNewValue2;
+            changed = true;
+        }
     }
     else
     {
-        if( TestFlag( CheckMask, basic_event::flags::text ) )
+        if( ( TestFlag( CheckMask, basic_event::flags::text ) ) && ( szText != szNewText ) ) {
             szText = szNewText;
-        if (TestFlag(CheckMask, basic_event::flags::value1))
+            changed = true;
+        }
+        if( ( TestFlag( CheckMask, basic_event::flags::value1 ) ) && ( fValue1 != fNewValue1 ) ) {
             fValue1 = fNewValue1;
-        if (TestFlag(CheckMask, basic_event::flags::value2))
+            changed = true;
+        }
+        if( ( TestFlag( CheckMask, basic_event::flags::value2 ) ) && ( fValue2 != fNewValue2 ) ) {
             fValue2 = fNewValue2;
+            changed = true;
+        }
     }
     if (TestFlag(CheckMask, basic_event::flags::text))
         CommandCheck(); // jeśli zmieniony tekst, próbujemy rozpoznać komendę
+    if( true == changed ) {
+        notify();
+    }
+}
+
+// notifies subscribers about change of the cell content
+void
+TMemCell::notify() {
+
+    ++m_revision;
+    // launchers re-evaluate their conditions only after being notified about the change
+    for( auto *launcher : m_launchers ) {
+        launcher->conditions_changed();
+    }
+    // listeners are launched at most once per simulation frame. they're only queued here and read the cell when executed,
+    // so further changes in the same frame are covered by the pending launch. this also keeps listeners which modify
+    // the cell through other cells from flooding the event queue
+    if( ( true == m_listeners.empty() )
+     || ( Timer::GetTime() == m_notifytime ) ) {
+        return;
+    }
+    // changes made by the cell's own listeners don't launch them again, otherwise a listener writing to its cell
+    // would re-queue itself every frame
+    if( std::any_of(
+            std::begin( m_listeners ), std::end( m_listeners ),
+            []( basic_event const *Listener ) {
+                return Listener->is_running(); } ) ) {
+        return;
+    }
+    m_notifytime = Timer::GetTime();
+    for( auto *listener : m_listeners ) {
+        simulation::Events.AddToQuery( listener, nullptr );
+    }
+}
+
+// registers provided event launcher as dependent on content of the cell
+void
+TMemCell::subscribe( TEventLauncher *Launcher ) {
+
+    if( Launcher == nullptr ) { return; }
+
+    if( std::find( std::begin( m_launchers ), std::end( m_launchers ), Launcher ) == std::end( m_launchers ) ) {
+        m_launchers.emplace_back( Launcher );
+    }
+    Launcher->conditions_changed();
+}
+
+// removes provided event launcher from the list of dependent launchers
+void
+TMemCell::unsubscribe( TEventLauncher const *Launcher ) {
+
+    m_launchers.erase(
+        std::remove( std::begin( m_launchers ), std::end( m_launchers ), Launcher ),
+        std::end( m_launchers ) );
+}
+
+// registers provided event to be launched when content of the cell changes
+void
+TMemCell::subscribe( basic_event *Event ) {
+
+    if( Event == nullptr ) { return; }
+
+    if( std::find( std::begin( m_listeners ), std::end( m_listeners ), Event ) == std::end( m_listeners ) ) {
+        m_listeners.emplace_back( Event );
+    }
 }
 
 TCommandType TMemCell::CommandCheck()
@@ -53,6 +53,19 @@ public:
     void AssignEvents(basic_event *e);
     std::string Values() const;
     void LogValues() const;
+    // registers provided event launcher as dependent on content of the cell
+    void
+        subscribe( TEventLauncher *Launcher );
+    // registers provided event to be launched when content of the cell changes
+    void
+        subscribe( basic_event *Event );
+    // removes provided event launcher from the list of dependent launchers
+    void
+        unsubscribe( TEventLauncher const *Launcher );
+    // returns: counter of changes made to content of the cell
+    std::uint32_t
+        revision() const {
+            return m_revision; }
 // members
     std::string asTrackName; // McZapkie-100302 - zeby nazwe toru na ktory jest Putcommand wysylane pamietac
     TTrack *Track { nullptr }; // resolved binding with the specified track
@@ -66,6 +79,8 @@ private:
     void deserialize_( std::istream &Input );
     // export() subclass details, sends basic content of the class in legacy (text) format to provided stream
     void export_as_text_( std::ostream &Output ) const;
+    // notifies subscribers about change of the cell content
+    void notify();
 
 // members
     // content
@@ -76,6 +91,11 @@ private:
     TCommandType eCommand { TCommandType::cm_Unknown };
     bool bCommand { false }; // czy zawiera komendę dla zatrzymanego AI
     basic_event *OnSent { nullptr }; // event dodawany do kolejki po wysłaniu komendy zatrzymującej skład
+    // change notifications
+    std::uint32_t m_revision { 0 }; // incremented with each change of the content
+    std::vector<TEventLauncher *> m_launchers; // launchers with conditions dependent on the cell content
+    std::vector<basic_event *> m_listeners; // events launched when the cell content changes
+    double m_notifytime { -1.0 }; // simulation time of the last launch of the listeners
 };
 
 
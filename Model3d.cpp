@@ -403,7 +403,7 @@ std::pair<int, int> TSubModel::Load( cParser &parser, bool dynamic )
                 material.insert( 0, Global.asCurrentTexturePath );
             }
 */
-            m_material = GfxRenderer->Fetch_Material( material );
+            m_material = GfxRenderer->Fetch_Material( material, false );
             // renderowanie w cyklu przezroczystych tylko jeśli:
             // 1. Opacity=0 (przejściowo <1, czy tam <100)
 			iFlags |= Opacity < 0.999f ? 0x20 : 0x10 ; // 0x20-przezroczysta, 0x10-nieprzezroczysta
@@ -1417,6 +1417,25 @@ TModel3d::~TModel3d() {
     }
 };
 
+// exchanges content with provided model. NOTE: the model name stays with the object
+void
+TModel3d::swap( TModel3d &Other ) {
+
+    std::swap( Root, Other.Root );
+    std::swap( iFlags, Other.iFlags );
+    std::swap( m_geometrybank, Other.m_geometrybank );
+    std::swap( m_indexcount, Other.m_indexcount );
+    std::swap( m_vertexcount, Other.m_vertexcount );
+    std::swap( Textures, Other.Textures );
+    std::swap( Names, Other.Names );
+    // NOTE: swapped vectors keep their buffers, so submodel links to the matrices stay valid
+    std::swap( Matrices, Other.Matrices );
+    std::swap( iSubModelsCount, Other.iSubModelsCount );
+    std::swap( asBinary, Other.asBinary );
+    std::swap( m_smokesources, Other.m_smokesources );
+    std::swap( m_loading, Other.m_loading );
+}
+
 TSubModel *
 TModel3d::AddToNamed(const char *Name, TSubModel *SubModel) {
 
@@ -1776,12 +1795,27 @@ void TSubModel::deserialize(std::istream &s)
 	m_rotation_init_done = true;
 }
 
-void TModel3d::deserialize(std::istream &s, size_t size, bool dynamic)
+namespace {
+
+// remaps geometry type for custom type submodels
+int
+submodel_geometry_type( int const Type ) {
+
+    switch( Type ) {
+        case TP_FREESPOTLIGHT:
+        case TP_STARS: {
+            return GL_POINTS; }
+        default: {
+            return Type; }
+    }
+}
+
+} // anonymous
+
+// retrieves model data from provided stream, without creating renderer resources. NOTE: can be called from worker threads
+void TModel3d::deserialize_data(std::istream &s, size_t size)
 {
 	Root = nullptr;
-    if( m_geometrybank == null_handle ) {
-        m_geometrybank = GfxRenderer->Create_Bank();
-    }
 
 	std::streampos end = s.tellg() + (std::streampos)size;
     bool hastangents { false };
@@ -1967,32 +2001,30 @@ void TModel3d::deserialize(std::istream &s, size_t size, bool dynamic)
 	if (!Root)
 		throw std::runtime_error("e3d: no submodels");
 
-    for (size_t i = 0; (int)i < iSubModelsCount; ++i)
-	{
-        Root[i].BinInit( Root, Matrices.data(), &Textures, &Names, dynamic );
-
-        if (Root[i].ChildGet())
-			Root[i].ChildGet()->Parent = &Root[i];
-		if (Root[i].NextGet())
-			Root[i].NextGet()->Parent = Root[i].Parent;
-
-        // remap geometry type for custom type submodels
-        int type;
-        switch( Root[i].eType ) {
-            case TP_FREESPOTLIGHT:
-            case TP_STARS: {
-                type = GL_POINTS;
-                break; }
-            default: {
-                type = Root[i].eType;
-                break;
-            }
+    if( false == hastangents ) {
+        for( auto idx = 0; idx < iSubModelsCount; ++idx ) {
+            gfx::calculate_tangents( Root[ idx ].Vertices, Root[ idx ].Indices, submodel_geometry_type( Root[ idx ].eType ) );
         }
-        if( false == hastangents ) {
-            gfx::calculate_tangents( Root[i].Vertices, Root[i].Indices, type );
-        }
-        Root[i].m_geometry.handle = GfxRenderer->Insert( Root[i].Indices, Root[i].Vertices, m_geometrybank, type );
-	}
+    }
+}
+
+// sets up specified submodel of data retrieved by deserialize_data() and sends its geometry to the renderer
+// NOTE: submodels have to be processed in order, as parent links are propagated from preceding submodels
+void TModel3d::init_submodel( int const Index, bool const Dynamic )
+{
+    if( m_geometrybank == null_handle ) {
+        m_geometrybank = GfxRenderer->Create_Bank();
+    }
+
+    auto &submodel { Root[ Index ] };
+    submodel.BinInit( Root, Matrices.data(), &Textures, &Names, Dynamic );
+
+    if( submodel.ChildGet() )
+        submodel.ChildGet()->Parent = &submodel;
+    if( submodel.NextGet() )
+        submodel.NextGet()->Parent = submodel.Parent;
+
+    submodel.m_geometry.handle = GfxRenderer->Insert( submodel.Indices, submodel.Vertices, m_geometrybank, submodel_geometry_type( submodel.eType ) );
 }
 
 void TSubModel::BinInit(TSubModel *s, float4x4 *m, std::vector<std::string> *t, std::vector<std::string> *n, bool dynamic)
@@ -2039,7 +2071,7 @@ void TSubModel::BinInit(TSubModel *s, float4x4 *m, std::vector<std::string> *t,
                 m_materialname = Global.asCurrentTexturePath + m_materialname;
             }
 */
-            m_material = GfxRenderer->Fetch_Material( m_materialname );
+            m_material = GfxRenderer->Fetch_Material( m_materialname, false );
             // if we don't have phase flags set for some reason, try to fix it
             if (!(iFlags & 0x30) && m_material != null_handle)
             {
@@ -2134,6 +2166,16 @@ void TSubModel::BinInit(TSubModel *s, float4x4 *m, std::vector<std::string> *t,
 
 void TModel3d::LoadFromBinFile(std::string const &FileName, bool dynamic)
 { // wczytanie modelu z pliku binarnego
+    LoadDataFromBinFile( FileName );
+
+    for( auto idx = 0; idx < iSubModelsCount; ++idx ) {
+        init_submodel( idx, dynamic );
+    }
+}
+
+// retrieves model data from binary file, without creating renderer resources. NOTE: can be called from worker threads
+void TModel3d::LoadDataFromBinFile(std::string const &FileName)
+{
     WriteLog( "Loading binary format 3d model data from \"" + FileName + "\"...", logtype::model );
 
 	std::ifstream file(FileName, std::ios::binary);
@@ -2144,7 +2186,7 @@ void TModel3d::LoadFromBinFile(std::string const &FileName, bool dynamic)
 	if (type != MAKE_ID4('E', '3', 'D', '0'))
 		throw std::runtime_error("e3d: unknown main chunk");
 
-	deserialize(file, size, dynamic);
+	deserialize_data(file, size);
 	file.close();
 
     WriteLog( "Finished loading 3d model data from \"" + FileName + "\"", logtype::model );
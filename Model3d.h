@@ -285,17 +285,34 @@ public:
 	void AddTo(TSubModel *tmp, TSubModel *SubModel);
 	void LoadFromTextFile(std::string const &FileName, bool dynamic);
 	void LoadFromBinFile(std::string const &FileName, bool dynamic);
+    // retrieves model data from binary file, without creating renderer resources. NOTE: can be called from worker threads
+    void LoadDataFromBinFile(std::string const &FileName);
+    // sets up specified submodel of data retrieved by LoadDataFromBinFile() and sends its geometry to the renderer
+    void init_submodel( int const Index, bool const Dynamic );
+    int SubModelsCount() const { return iSubModelsCount; };
     bool LoadFromFile(std::string const &FileName, bool dynamic);
     TSubModel *AppendChildFromGeometry(const std::string &name, const std::string &parent, const gfx::vertex_array &vertices, const gfx::index_array &indices);
 	void SaveToBinFile(std::string const &FileName);
 	uint32_t Flags() const { return iFlags; };
 	void Init();
 	std::string NameGet() const { return m_filename; };
+	void NameSet( std::string const &Name ) { m_filename = Name; };
     nameoffset_sequence const & smoke_sources() const {
         return m_smokesources; }
 	int TerrainCount() const;
 	TSubModel * TerrainSquare(int n);
-	void deserialize(std::istream &s, size_t size, bool dynamic);
+    // exchanges content with provided model
+    void swap( TModel3d &Other );
+    // indicates model data is being loaded in the background and the model is empty until then
+    bool is_loading() const {
+        return m_loading; }
+    void is_loading( bool const Loading ) {
+        m_loading = Loading; }
+
+private:
+	void deserialize_data(std::istream &s, size_t size);
+
+    bool m_loading { false };
 };
 
 //---------------------------------------------------------------------------
@@ -19,13 +19,99 @@ http://mozilla.org/MPL/2.0/.
 #pragma GCC diagnostic ignored "-Wwrite-strings"
 #endif
 
-void render_task::run() {
+namespace {
+
+// converts dictionary value to new reference of matching python object
+PyObject *
+make_python_value( dictionary_value const &Value ) {
+
+    switch( Value.index() ) {
+        case 0: { return PyGetFloat( std::get<double>( Value ) ); }
+        case 1: { return PyGetInt( std::get<int>( Value ) ); }
+        case 2: { auto *value { PyGetBool( std::get<bool>( Value ) ) }; Py_INCREF( value ); return value; }
+        case 3: { return PyGetString( std::get<std::string>( Value ).c_str() ); }
+        default: { Py_INCREF( Py_None ); return Py_None; }
+    }
+}
+
+} // anonymous
+
+// returns new reference to the dictionary kept for the layout of provided input, updated with values of the input
+auto python_dictionary_cache::fetch( dictionary_source const &Input ) -> PyObject * {
+
+    auto const &layout { Input.layout };
+    auto entry { std::find_if(
+        std::begin( m_entries ), std::end( m_entries ),
+        [&]( dictionary_entry const &Entry ) {
+            return ( false == Entry.layout.owner_before( layout ) )
+                && ( false == layout.owner_before( Entry.layout ) ); } ) };
+
+    if( entry == std::end( m_entries ) ) {
+        // first use of the layout, set up the dictionary and its keys
+        purge();
+        auto *dictionary { PyDict_New() };
+        if( dictionary == nullptr ) { return nullptr; }
+        dictionary_entry newentry;
+        newentry.layout = layout;
+        newentry.dictionary = dictionary;
+        for( auto const &key : layout->keys ) {
+            newentry.keys.emplace_back( PyString_InternFromString( key.c_str() ) );
+        }
+        m_entries.emplace_back( newentry );
+        entry = std::prev( std::end( m_entries ) );
+    }
+
+    for( std::size_t idx = 0; idx < entry->keys.size(); ++idx ) {
+        auto *value { make_python_value( Input.values[ idx ] ) };
+        PyDict_SetItem( entry->dictionary, entry->keys[ idx ], value );
+        Py_DECREF( value );
+    }
+
+    Py_INCREF( entry->dictionary );
+    return entry->dictionary;
+}
+
+// releases dictionaries of layouts which are no longer in use
+void python_dictionary_cache::purge() {
+
+    for( auto entry { std::begin( m_entries ) }; entry != std::end( m_entries ); ) {
+        if( false == entry->layout.expired() ) {
+            ++entry;
+            continue;
+        }
+        for( auto *key : entry->keys ) {
+            Py_XDECREF( key );
+        }
+        Py_DECREF( entry->dictionary );
+        entry = m_entries.erase( entry );
+    }
+}
+
+// releases all cached dictionaries
+void python_dictionary_cache::clear() {
+
+    for( auto &entry : m_entries ) {
+        for( auto *key : entry.keys ) {
+            Py_XDECREF( key );
+        }
+        Py_DECREF( entry.dictionary );
+    }
+    m_entries.clear();
+}
+
+// --------------
+
+bool render_task::run( python_dictionary_cache &Dictionaries ) {
 
     // convert provided input to a python dictionary
-    auto *input = PyDict_New();
+    // data with compiled layout goes to dictionary kept for the layout, otherwise a new dictionary is built
+    auto *input = (
+        m_input->layout ?
+            Dictionaries.fetch( *m_input ) :
+            PyDict_New() );
     if (input == nullptr) {
 		cancel();
-		return;
+		return false;
 	}
     for( auto const &datapair : m_input->floats )   { auto *value{ PyGetFloat( datapair.second ) }; PyDict_SetItemString( input, datapair.first.c_str(), value ); Py_DECREF( value ); }
     for( auto const &datapair : m_input->integers ) { auto *value{ PyGetInt( datapair.second ) }; PyDict_SetItemString( input, datapair.first.c_str(), value ); Py_DECREF( value ); }
@@ -48,8 +134,17 @@ void render_task::run() {
         PyDict_SetItemString(input, datapair.first.c_str(), list);
         Py_DECREF(list);
     }
-	delete m_input;
-	m_input = nullptr;
+    if( m_input->layout ) {
+        // the dictionary is reused by subsequent tasks, scripts receive read-only view of it
+        auto *view { PyDictProxy_New( input ) };
+        Py_DECREF( input );
+        if( view == nullptr ) {
+            cancel();
+            return false;
+        }
+        input = view;
+    }
+	m_input.reset();
 
     // call the renderer
     auto *output { PyObject_CallMethod( m_renderer, "render", "O", input ) };
@@ -68,6 +163,9 @@ void render_task::run() {
 
             const unsigned char *image = reinterpret_cast<const unsigned char *>( PyString_AsString( output ) );
 
+			// the copy doesn't touch python objects, let other workers run their scripts in the meantime
+			// (we hold a reference to the output, so its buffer stays valid)
+			Py_BEGIN_ALLOW_THREADS
 			std::lock_guard<std::mutex> guard(m_target->mutex);
 			if (m_target->image)
 				delete[] m_target->image;
@@ -103,11 +201,26 @@ void render_task::run() {
 			m_target->components = components;
 			m_target->format = format;
 			m_target->timestamp = std::chrono::high_resolution_clock::now();
+			Py_END_ALLOW_THREADS
+
+			auto const now { clock::now() };
+			auto const latency { std::chrono::duration<float>( now - m_requested ).count() };
+			m_target->latency = (
+				m_target->renders == 0 ?
+					latency :
+					m_target->latency * 0.9f + latency * 0.1f );
+			m_target->peaklatency = std::max( m_target->peaklatency.load(), latency );
+			if( now > m_deadline ) {
+				++( m_target->late );
+			}
+			++( m_target->renders );
         }
         if( outputheight != nullptr ) { Py_DECREF( outputheight ); }
         if( outputwidth  != nullptr ) { Py_DECREF( outputwidth ); }
         Py_DECREF( output );
     }
+
+    return true;
 }
 
 void render_task::upload()
@@ -140,7 +253,6 @@ void render_task::upload()
 
 void render_task::cancel() {
 
-    delete m_input;
     delete this;
 }
 
@@ -149,6 +261,7 @@ auto python_taskqueue::init() -> bool {
 
 	crashreport_add_info("python.threadedupload", Global.python_threadedupload ? "yes" : "no");
 	crashreport_add_info("python.uploadmain", Global.python_uploadmain ? "yes" : "no");
+	crashreport_add_info("python.workers", std::to_string(Global.python_workers));
 
 #ifdef _WIN32
 	if (sizeof(void*) == 8)
@@ -203,6 +316,9 @@ auto python_taskqueue::init() -> bool {
     WriteLog( "Python Interpreter: setup complete" );
 
     // init workers
+    // scripts share the interpreter lock, additional workers keep slow scripts from holding up the other screens
+    // and overlap their texture copies and uploads with script execution
+    m_workers.resize( std::max( 1, Global.python_workers ) );
     for( auto &worker : m_workers ) {
 
 		GLFWwindow *openglcontextwindow = nullptr;
@@ -259,7 +375,12 @@ auto python_taskqueue::insert( task_request const &Task ) -> bool {
     auto *renderer { fetch_renderer( Task.renderer ) };
     if( renderer == nullptr ) { return false; }
 
-    auto *newtask { new render_task( renderer, Task.input, Task.target ) };
+    auto const deadline { (
+        Task.deadline.count() > 0.0 ?
+            render_task::clock::now() + std::chrono::duration_cast<render_task::clock::duration>( Task.deadline ) :
+            render_task::clock::time_point::max() ) };
+    auto *newtask { new render_task( renderer, Task.input, Task.target, deadline ) };
+    ++( Task.target->requests );
     bool newtaskinserted { false };
     // acquire a lock on the task queue and add the new task
     {
@@ -268,6 +389,7 @@ auto python_taskqueue::insert( task_request const &Task ) -> bool {
         for( auto &task : m_tasks.data ) {
             if( task->target() == Task.target ) {
                 // replace pending task in the slot with the more recent one
+                ++( Task.target->drops );
                 task->cancel();
                 task = newtask;
                 newtaskinserted = true;
@@ -365,6 +487,30 @@ cache_and_return:
     return renderer;
 }
 
+// removes from the queue the pending task with the earliest deadline whose renderer isn't busy
+// NOTE: requires lock on the task queue
+auto python_taskqueue::pick_task( rendertask_sequence &Tasks ) -> render_task * {
+
+    auto pick { std::end( Tasks.data ) };
+    for( auto taskiter { std::begin( Tasks.data ) }; taskiter != std::end( Tasks.data ); ++taskiter ) {
+        // renderer objects keep state between calls, so each can only serve one task at a time
+        if( std::find( std::begin( m_activerenderers ), std::end( m_activerenderers ), ( *taskiter )->renderer() ) != std::end( m_activerenderers ) ) {
+            continue;
+        }
+        // earliest deadline first, tasks with the same deadline in order of arrival
+        if( ( pick == std::end( Tasks.data ) )
+         || ( ( *taskiter )->deadline() < ( *pick )->deadline() ) ) {
+            pick = taskiter;
+        }
+    }
+    if( pick == std::end( Tasks.data ) ) {
+        return nullptr;
+    }
+    auto *task { *pick };
+    Tasks.data.erase( pick );
+    return task;
+}
+
 void python_taskqueue::run( GLFWwindow *Context, rendertask_sequence &Tasks, uploadtask_sequence &Upload_Tasks, threading::condition_variable &Condition, std::atomic<bool> &Exit ) {
 
 	if (Context)
@@ -376,6 +522,7 @@ void python_taskqueue::run( GLFWwindow *Context, rendertask_sequence &Tasks, upl
     PyEval_ReleaseLock();
 
     render_task *task { nullptr };
+    python_dictionary_cache dictionaries;
 
     while( false == Exit.load() ) {
         // regardless of the reason we woke up prime the spurious wakeup flag for the next time
@@ -386,18 +533,28 @@ void python_taskqueue::run( GLFWwindow *Context, rendertask_sequence &Tasks, upl
             // acquire a lock on the task queue and potentially grab a task from it
             {
                 std::lock_guard<std::mutex> lock( Tasks.mutex );
-                if( false == Tasks.data.empty() ) {
-                    // fifo
-                    task = Tasks.data.front();
-                    Tasks.data.pop_front();
+                task = pick_task( Tasks );
+                if( task != nullptr ) {
+                    m_activerenderers.emplace_back( task->renderer() );
                 }
             }
             if( task != nullptr ) {
+                auto *renderer { task->renderer() };
                 // swap in my thread state
                 PyEval_RestoreThread( threadstate );
+                // execute python code
+                auto const rendered { task->run( dictionaries ) };
+                if( PyErr_Occurred() != nullptr )
+                    error();
+                // clear the thread state
+                PyEval_SaveThread();
+                // release the renderer for other workers
                 {
-                    // execute python code
-                    task->run();
+                    std::lock_guard<std::mutex> lock( Tasks.mutex );
+                    m_activerenderers.erase( std::find( std::begin( m_activerenderers ), std::end( m_activerenderers ), renderer ) );
+                }
+                // texture upload doesn't involve python, do it without holding up other workers
+                if( true == rendered ) {
 					if (Context)
 						task->upload();
 					else
@@ -405,11 +562,7 @@ void python_taskqueue::run( GLFWwindow *Context, rendertask_sequence &Tasks, upl
 						std::lock_guard<std::mutex> lock(Upload_Tasks.mutex);
 						Upload_Tasks.data.push_back(task);
 					}
-					if( PyErr_Occurred() != nullptr )
-						error();
                 }
-                // clear the thread state
-                PyEval_SaveThread();
             }
             // TBD, TODO: add some idle time between tasks in case we're on a single thread cpu?
         } while( task != nullptr );
@@ -417,6 +570,10 @@ void python_taskqueue::run( GLFWwindow *Context, rendertask_sequence &Tasks, upl
         // but check every now and then on your own to minimize potential deadlock situations
         Condition.wait_for( std::chrono::seconds( 5 ) );
     }
+    // release python data owned by the thread
+    PyEval_RestoreThread( threadstate );
+    dictionaries.clear();
+    PyEval_SaveThread();
     // clean up thread state data
     PyEval_AcquireLock();
     PyThreadState_Swap( nullptr );
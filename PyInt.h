@@ -64,31 +64,71 @@ struct python_rt {
 
 	std::chrono::high_resolution_clock::time_point timestamp;
 
+	// scheduling statistics, maintained by the task queue
+	std::atomic<std::uint32_t> requests { 0 }; // render requests received
+	std::atomic<std::uint32_t> renders { 0 }; // completed renders
+	std::atomic<std::uint32_t> drops { 0 }; // requests superseded by a newer one before they were picked up
+	std::atomic<std::uint32_t> late { 0 }; // renders completed past their deadline
+	std::atomic<float> latency { 0.f }; // smoothed time between request and completed render, in seconds
+	std::atomic<float> peaklatency { 0.f };
+
 	~python_rt() {
 		if (image)
 			delete[] image;
 	}
 };
 
+// python dictionaries bound to compiled dictionary layouts, updated in place instead of being rebuilt for each task
+// NOTE: methods require the python lock to be held
+class python_dictionary_cache {
+
+public:
+// methods
+    // returns new reference to the dictionary kept for the layout of provided input, updated with values of the input
+    auto fetch( dictionary_source const &Input ) -> PyObject *;
+    // releases all cached dictionaries
+    void clear();
+
+private:
+// types
+    struct dictionary_entry {
+        std::weak_ptr<dictionary_layout const> layout;
+        PyObject *dictionary { nullptr };
+        std::vector<PyObject *> keys; // interned key strings, in order of the layout
+    };
+// methods
+    // releases dictionaries of layouts which are no longer in use
+    void purge();
+// members
+    std::vector<dictionary_entry> m_entries;
+};
+
 // TODO: extract common base and inherit specialization from it
 class render_task {
 
 public:
+// types
+    using clock = std::chrono::steady_clock;
 // constructors
-	render_task( PyObject *Renderer, dictionary_source *Input, std::shared_ptr<python_rt> Target ) :
-        m_renderer( Renderer ), m_input( Input ), m_target( Target )
+	render_task( PyObject *Renderer, std::shared_ptr<dictionary_source> Input, std::shared_ptr<python_rt> Target, clock::time_point const Deadline ) :
+        m_renderer( Renderer ), m_input( Input ), m_target( Target ), m_requested( clock::now() ), m_deadline( Deadline )
     {}
 // methods
-	void run();
+    // executes the renderer and stores its output in the target. returns false if the task was cancelled
+	bool run( python_dictionary_cache &Dictionaries );
 	void upload();
     void cancel();
 	auto target() const -> std::shared_ptr<python_rt> { return m_target; }
+	auto renderer() const -> PyObject * { return m_renderer; }
+	auto deadline() const -> clock::time_point { return m_deadline; }
 
 private:
 // members
     PyObject *m_renderer {nullptr};
-    dictionary_source *m_input { nullptr };
+    std::shared_ptr<dictionary_source> m_input;
 	std::shared_ptr<python_rt> m_target { nullptr };
+	clock::time_point m_requested; // creation time of the task, base for the latency statistics
+	clock::time_point m_deadline; // point past which the result is no longer of use
 };
 
 class python_taskqueue {
@@ -98,8 +138,9 @@ public:
     struct task_request {
 
         std::string const &renderer;
-        dictionary_source *input;
+        std::shared_ptr<dictionary_source> input;
 		std::shared_ptr<python_rt> target;
+        std::chrono::duration<double> deadline { 0.0 }; // time until the result becomes stale, or 0 if it doesn't expire
     };
 // constructors
     python_taskqueue() = default;
@@ -121,12 +162,14 @@ public:
 
 private:
 // types
-    static int const WORKERCOUNT { 1 };
-    using worker_array = std::array<std::thread, WORKERCOUNT >;
+    using worker_array = std::vector<std::thread>;
     using rendertask_sequence = threading::lockable< std::deque<render_task *> >;
 	using uploadtask_sequence = threading::lockable< std::deque<render_task *> >;
 // methods
     auto fetch_renderer( std::string const Renderer ) -> PyObject *;
+    // removes from the queue the pending task with the earliest deadline whose renderer isn't busy
+    // NOTE: requires lock on the task queue
+    auto pick_task( rendertask_sequence &Tasks ) -> render_task *;
 	void run(GLFWwindow *Context, rendertask_sequence &Tasks, uploadtask_sequence &Upload_Tasks, threading::condition_variable &Condition, std::atomic<bool> &Exit );
     void error();
 // members
@@ -138,6 +181,7 @@ private:
     std::atomic<bool> m_exit { false }; // signals the workers to quit
     std::unordered_map<std::string, PyObject *> m_renderers; // cache of python classes
     rendertask_sequence m_tasks;
+    std::vector<PyObject *> m_activerenderers; // renderers executed by the workers, guarded by the task queue lock
 	uploadtask_sequence m_uploadtasks;
     bool m_initialized { false };
 };
@@ -62,6 +62,8 @@ bool TSegment::Init(Math3D::vector3 NewPoint1, Math3D::vector3 NewPoint2, double
 
 bool TSegment::Init( Math3D::vector3 &NewPoint1, Math3D::vector3 NewCPointOut, Math3D::vector3 NewCPointIn, Math3D::vector3 &NewPoint2, double fNewStep, double fNewRoll1, double fNewRoll2, bool bIsCurve)
 { // wersja uniwersalna (dla krzywej i prostego)
+    // drop lookup table of previous geometry, re-initialized segment can be a straight which doesn't build one
+    m_arclengths.clear();
     Point1 = NewPoint1;
     CPointOut = NewCPointOut;
     CPointIn = NewCPointIn;
@@ -132,6 +134,10 @@ bool TSegment::Init( Math3D::vector3 &NewPoint1, Math3D::vector3 NewCPointOut, M
 
     fStep = fLength / iSegCount; // update step to equalize size of individual pieces
 
+    if( bCurve ) {
+        BuildArcLengthTable( arclength_tolerance );
+    }
+
     fTsBuffer.resize( iSegCount + 1 );
     fTsBuffer[ 0 ] = 0.0;
     for( int i = 1; i < iSegCount; ++i ) {
@@ -193,7 +199,96 @@ double TSegment::RombergIntegral(double const fA, double const fB) const
     return ms_apfRom[0][ms_iOrder - 1];
 }
 
+double TSegment::ArcLength(double const fA, double const fB) const
+{
+    // 5-point gauss-legendre quadrature, exact for polynomials up to 9th degree
+    // which is plenty for the length of derivative over short curve sections
+    static std::array<std::pair<double, double>, 5> const nodes { {
+        {  0.0,                0.5688888888888889 },
+        { -0.5384693101056831, 0.4786286704993665 },
+        {  0.5384693101056831, 0.4786286704993665 },
+        { -0.9061798459386640, 0.2369268850561891 },
+        {  0.9061798459386640, 0.2369268850561891 } } };
+
+    auto const halfrange { 0.5 * ( fB - fA ) };
+    auto const midpoint { 0.5 * ( fA + fB ) };
+    auto length { 0.0 };
+    for( auto const &node : nodes ) {
+        length += node.second * GetFirstDerivative( midpoint + halfrange * node.first ).Length();
+    }
+    return length * halfrange;
+}
+
+void TSegment::BuildArcLengthTable(double const Tolerance)
+{
+    // start with sparse table, refine as needed
+    auto intervalcount { clamp( static_cast<int>( std::ceil( fLength / 25.0 ) ), 4, 1024 ) };
+    while( true ) {
+        m_arclengths.resize( intervalcount + 1 );
+        m_arclengths[ 0 ] = 0.0;
+        for( auto idx = 0; idx < intervalcount; ++idx ) {
+            m_arclengths[ idx + 1 ] = m_arclengths[ idx ] + ArcLength( double( idx ) / intervalcount, double( idx + 1 ) / intervalcount );
+        }
+        if( intervalcount >= 16384 ) {
+            // arbitrary limit, reached only by pathological splines
+            break;
+        }
+        // verify accuracy of the lookups inside each interval, where the initial estimate is the worst.
+        // measured against arc length integrated with a different method, to account for the quadrature error as well
+        auto maxerror { 0.0 };
+        auto referencelength { 0.0 };
+        for( auto idx = 0; idx < intervalcount; ++idx ) {
+            auto const tstart { double( idx ) / intervalcount };
+            for( auto const fraction : { 0.25, 0.5, 0.75 } ) {
+                auto const s { interpolate( m_arclengths[ idx ], m_arclengths[ idx + 1 ], fraction ) };
+                auto const error { std::abs( referencelength + RombergIntegral( tstart, GetTFromS( s ) ) - s ) };
+                maxerror = std::max( maxerror, error );
+            }
+            referencelength += RombergIntegral( tstart, double( idx + 1 ) / intervalcount );
+        }
+        // keep a safety margin, as the samples can miss the actual peak
+        if( maxerror <= 0.5 * Tolerance ) {
+            break;
+        }
+        intervalcount *= 2;
+    }
+}
+
 double TSegment::GetTFromS(double const s) const
+{
+    if( m_arclengths.empty() ) {
+        // no table for straight segments
+        return s / fLength;
+    }
+    auto const intervalcount { m_arclengths.size() - 1 };
+    auto const totallength { m_arclengths.back() };
+    // outside of the curve extrapolate along the tangent
+    if( s <= 0.0 ) {
+        return s / GetFirstDerivative( 0.0 ).Length();
+    }
+    if( s >= totallength ) {
+        return 1.0 + ( s - totallength ) / GetFirstDerivative( 1.0 ).Length();
+    }
+    // locate the interval and interpolate parameter value...
+    auto const upper { std::upper_bound( std::begin( m_arclengths ), std::end( m_arclengths ), s ) };
+    auto const idx { static_cast<std::size_t>( std::distance( std::begin( m_arclengths ), upper ) ) - 1 };
+    auto const tstart { double( idx ) / intervalcount };
+    auto const intervallength { m_arclengths[ idx + 1 ] - m_arclengths[ idx ] };
+    auto t {
+        tstart
+        + ( intervallength > 0.0 ?
+                ( s - m_arclengths[ idx ] ) / intervallength :
+                0.0 )
+            / intervalcount };
+    // ...then refine it with single newton step
+    auto const speed { GetFirstDerivative( t ).Length() };
+    if( speed > 0.0 ) {
+        t -= ( m_arclengths[ idx ] + ArcLength( tstart, t ) - s ) / speed;
+    }
+    return t;
+}
+
+double TSegment::GetTFromS_Newton(double const s) const
 {
     // initial guess for Newton's method
     double fTolerance = 0.001;
@@ -54,13 +54,18 @@ class TSegment
     double fStoop = 0.0; // Ra: kąt wzniesienia; dla łuku od Point1
     Math3D::vector3 vA, vB, vC; // współczynniki wielomianów trzeciego stopnia vD==Point1
     TTrack *pOwner = nullptr; // wskaźnik na właściciela
+    std::vector<double> m_arclengths; // arc length at evenly spaced values of curve parameter
 
     Math3D::vector3
         GetFirstDerivative(double const fTime) const;
     double
         RombergIntegral(double const fA, double const fB) const;
+    // calculates arc length of curve section between specified parameter values, using gauss-legendre quadrature
     double
-        GetTFromS(double const s) const;
+        ArcLength(double const fA, double const fB) const;
+    // fills the arc length table, with density ensuring estimates drawn from it stay within specified tolerance
+    void
+        BuildArcLengthTable(double const Tolerance);
     Math3D::vector3
         RaInterpolate(double const t) const;
     Math3D::vector3
@@ -68,6 +73,8 @@ class TSegment
 
 public:
     bool bCurve = false;
+    // max difference between requested and actual distance for curve parameter returned by GetTFromS(), in metres
+    static constexpr double arclength_tolerance { 0.001 };
 
     TSegment(TTrack *owner);
     bool
@@ -76,6 +83,12 @@ public:
         Init( Math3D::vector3 &NewPoint1, Math3D::vector3 NewCPointOut, Math3D::vector3 NewCPointIn, Math3D::vector3 &NewPoint2, double fNewStep, double fNewRoll1 = 0, double fNewRoll2 = 0, bool bIsCurve = true);
     double
         ComputeLength() const; // McZapkie-150503
+    // converts distance from segment start to curve parameter, using precomputed arc length table
+    double
+        GetTFromS(double const s) const;
+    // converts distance from segment start to curve parameter, using iterative method. NOTE: slow, kept as a reference
+    double
+        GetTFromS_Newton(double const s) const;
     // finds point on segment closest to specified point in 3d space. returns: point on segment as value in range 0-1
     double
         find_nearest_point( glm::dvec3 const &Point ) const;
@@ -112,6 +112,8 @@ texture_manager::texture_manager() {
 
     // since index 0 is used to indicate no texture, we put a blank entry in the first texture slot
     m_textures.emplace_back( new opengl_texture(), std::chrono::steady_clock::time_point() );
+    // stb_image keeps the flip setting in process-wide state, so set it once before any decode worker can run
+    stbi_set_flip_vertically_on_load( 1 );
 }
 
 // convert image to format suitable for given internalformat
@@ -231,7 +233,7 @@ void opengl_texture::gles_match_internalformat(GLuint internalformat)
 }
 
 // loads texture data from specified file
-// TODO: wrap it in a workitem class, for the job system deferred loading
+// NOTE: for deferred loading it's executed by texture_manager worker threads on a copy of the texture object
 void
 opengl_texture::load() {
 	if (data_state == resource_state::good)
@@ -291,6 +293,74 @@ fail:
     return;
 }
 
+// reads texture file header to determine traits required before the data is available
+// NOTE: material setup classifies translucency based on alpha channel presence, so deferred textures need it up front
+void
+opengl_texture::probe() {
+
+    std::ifstream file( name + type, std::ios::binary ); file.unsetf( std::ios::skipws );
+    if( false == file.is_open() ) { return; }
+
+    if( type == ".dds" ) {
+        char filecode[ 5 ];
+        file.read( filecode, 4 );
+        filecode[ 4 ] = 0;
+        if( filecode != std::string( "DDS " ) ) { return; }
+        auto const ddsd { deserialize_ddsd( file ) };
+        has_alpha = ( ddsd.ddpfPixelFormat.dwFourCC != FOURCC_DXT1 );
+    }
+    else if( type == ".tga" ) {
+        unsigned char tgaheader[ 18 ];
+        file.read( (char *)tgaheader, sizeof( unsigned char ) * 18 );
+        has_alpha = ( ( file.gcount() == 18 ) && ( tgaheader[ 16 ] == 32 ) );
+    }
+    else if( type == ".tex" ) {
+        char head[ 5 ];
+        file.read( head, 4 );
+        head[ 4 ] = 0;
+        has_alpha = ( std::string( "RGBA" ) == head );
+    }
+    else if( type == ".png" ) {
+        png_image png;
+        memset( &png, 0, sizeof( png_image ) );
+        png.version = PNG_IMAGE_VERSION;
+        if( 0 != png_image_begin_read_from_file( &png, ( name + type ).c_str() ) ) {
+            has_alpha = ( ( png.format & PNG_FORMAT_FLAG_ALPHA ) != 0 );
+        }
+        png_image_free( &png );
+    }
+    else if( type == ".ktx" ) {
+        // only etc2 with alpha is supported
+        has_alpha = true;
+    }
+    else if( ( type == ".bmp" ) || ( type == ".jpg" ) ) {
+        int x, y, n;
+        if( 0 != stbi_info( ( name + type ).c_str(), &x, &y, &n ) ) {
+            has_alpha = ( n == 4 );
+        }
+    }
+}
+
+// takes over texture data retrieved by a copy of this texture, loaded on another thread
+void
+opengl_texture::assign_data( opengl_texture &&Source ) {
+
+    data = std::move( Source.data );
+    data_state = Source.data_state;
+    data_width = Source.data_width;
+    data_height = Source.data_height;
+    data_mapcount = Source.data_mapcount;
+    data_format = Source.data_format;
+    data_components = Source.data_components;
+    data_type = Source.data_type;
+    has_alpha = Source.has_alpha;
+    size = Source.size;
+    if( data_state == resource_state::failed ) {
+        // NOTE: temporary workaround for texture assignment errors, mirrors load()
+        id = 0;
+    }
+}
+
 void opengl_texture::load_PNG()
 {
 	png_image png;
@@ -341,7 +411,7 @@ void opengl_texture::load_PNG()
 void opengl_texture::load_STBI()
 {
 	int x, y, n;
-	stbi_set_flip_vertically_on_load(1);
+	// vertical flip is enabled once, by texture_manager
 	uint8_t *image = stbi_load((name + type).c_str(), &x, &y, &n, 4);
 
 	if (!image) {
@@ -400,7 +470,7 @@ opengl_texture::make_request() {
 
     auto const components { Split( name, '?' ) };
 
-	auto *dictionary { new dictionary_source( components.back() ) };
+	auto dictionary { std::make_shared<dictionary_source>( components.back() ) };
 
 	auto rt = std::make_shared<python_rt>();
 	rt->shared_tex = id;
@@ -1336,7 +1406,14 @@ texture_manager::create( std::string Filename, bool const Loadnow, GLint Formath
 
     WriteLog( "Created texture object for \"" + locator.first + "\"", logtype::texture );
 
-    if( true == Loadnow ) {
+    if( ( false == Loadnow )
+     && ( true == Global.gfx_texture_asyncdecode )
+     && ( false == ( isgenerated || isinternalsrc ) ) ) {
+        // file resources are retrieved in the background, setup of generated textures is cheap enough to do it here
+        texture->probe();
+        decode( textureindex );
+    }
+    else {
 
         texture_manager::texture( textureindex ).load();
 #ifndef EU07_DEFERRED_TEXTURE_UPLOAD
@@ -1368,6 +1445,57 @@ texture_manager::mark_as_used(const texture_handle Texture) {
     return *pair.first;
 }
 
+// queues loading of texture data on a worker thread
+void
+texture_manager::decode( texture_handle const Texture ) {
+
+    if( m_decodeworkers.size() == 0 ) {
+        // leave some room for the main thread and the other jobs
+        m_decodeworkers.start( std::max( 1, static_cast<int>( std::thread::hardware_concurrency() ) / 2 ) );
+    }
+    // the worker operates on its own copy of the texture, so the original stays safe to use in the meantime
+    auto decodedtexture { std::make_shared<opengl_texture>( texture( Texture ) ) };
+    ++m_decodingcount;
+    m_decodeworkers.push(
+        [ this, Texture, decodedtexture ]() {
+            decodedtexture->load();
+            std::lock_guard<std::mutex> lock( m_decodedtexturesmutex );
+            m_decodedtextures.emplace_back( Texture, decodedtexture ); } );
+}
+
+// uploads textures decoded in the background, within per-frame time budget
+void
+texture_manager::upload() {
+
+    if( m_decodingcount == 0 ) { return; }
+
+    auto const deadline {
+        std::chrono::steady_clock::now()
+        + std::chrono::duration_cast<std::chrono::steady_clock::duration>( std::chrono::duration<float, std::milli>( Global.gfx_texture_uploadbudget ) ) };
+    auto uploadcount { 0 };
+
+    do {
+        decodedtexture_pair decodedtexture;
+        {
+            std::lock_guard<std::mutex> lock( m_decodedtexturesmutex );
+            if( m_decodedtextures.empty() ) { break; }
+            decodedtexture = std::move( m_decodedtextures.front() );
+            m_decodedtextures.pop_front();
+        }
+        --m_decodingcount;
+        auto &texture { texture_manager::texture( decodedtexture.first ) };
+        texture.assign_data( std::move( *decodedtexture.second ) );
+        if( true == texture.create() ) {
+            ++uploadcount;
+        }
+    } while( std::chrono::steady_clock::now() < deadline );
+
+    if( uploadcount > 0 ) {
+        // texture creation binds textures to active unit behind the cache's back
+        opengl_texture::reset_unit_cache();
+    }
+}
+
 void
 texture_manager::delete_textures() {
     for( auto const &texture : m_textures ) {
@@ -13,6 +13,7 @@ http://mozilla.org/MPL/2.0/.
 #include "winheaders.h"
 #include <string>
 #include "ResourceManager.h"
+#include "utilities.h"
 #include "gl/ubo.h"
 
 struct opengl_texture {
@@ -26,6 +27,12 @@ struct opengl_texture {
 // methods
     void
         load();
+    // reads texture file header to determine traits required before the data is available
+    void
+        probe();
+    // takes over texture data retrieved by a copy of this texture, loaded on another thread
+    void
+        assign_data( opengl_texture &&Source );
     bool
         bind( size_t unit );
     static void
@@ -117,7 +124,9 @@ class texture_manager {
 
 public:
     texture_manager();
-    ~texture_manager() { delete_textures(); }
+    ~texture_manager() {
+        m_decodeworkers.stop();
+        delete_textures(); }
 
     // activates specified texture unit
     void
@@ -133,6 +142,9 @@ public:
     // provides direct access to specified texture object
     opengl_texture &
         texture( texture_handle const Texture ) const { return *(m_textures[ Texture ].first); }
+    // uploads textures decoded in the background, within per-frame time budget
+    void
+        upload();
     // performs a resource sweep
     void
         update();
@@ -150,6 +162,10 @@ private:
 
     typedef std::unordered_map<std::string, std::size_t> index_map;
 
+    typedef std::pair<
+        texture_handle,
+        std::shared_ptr<opengl_texture> > decodedtexture_pair;
+
 // methods:
     // checks whether specified texture is in the texture bank. returns texture id, or npos.
     texture_handle
@@ -157,6 +173,9 @@ private:
     // checks whether specified file exists. returns name of the located file, or empty string.
     std::pair<std::string, std::string>
         find_on_disk( std::string const &Texturename ) const;
+    // queues loading of texture data on a worker thread
+    void
+        decode( texture_handle const Texture );
     void
         delete_textures();
 
@@ -165,6 +184,10 @@ private:
     texturetimepointpair_sequence m_textures;
     index_map m_texturemappings;
     garbage_collector<texturetimepointpair_sequence> m_garbagecollector { m_textures, 600, 60, "texture" };
+    threading::worker_pool m_decodeworkers;
+    std::deque<decodedtexture_pair> m_decodedtextures; // decoded, awaiting upload
+    std::mutex m_decodedtexturesmutex;
+    std::size_t m_decodingcount { 0 }; // textures queued for decoding and not uploaded yet
 };
 
 // reduces provided data image to half of original size, using basic 2x2 average
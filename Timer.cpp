@@ -52,6 +52,11 @@ void set_delta_override(double t)
 	override_delta = t;
 }
 
+void set_time(double Time)
+{
+	fSimulationTime = Time;
+}
+
 void ResetTimers()
 {
     UpdateTimers( Global.iPause != 0 );
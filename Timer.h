@@ -18,6 +18,8 @@ double GetDeltaTime();
 double GetDeltaRenderTime();
 
 void set_delta_override(double v);
+// replaces current simulation time, used when resuming from stored state
+void set_time(double Time);
 
 void ResetTimers();
 
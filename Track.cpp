@@ -43,10 +43,10 @@ const int iLewo3[4] = {1, 3, 2, 1}; // segmenty do skręcania w lewo
 const int iPrawo3[4] = {-2, -1, -3, -2}; // segmenty do skręcania w prawo
 const int iProsto3[4] = {1, -1, 2, 1}; // segmenty do jazdy prosto
 const int iEnds3[13] = {3, 0, 2, 1, 2, 0, -1, 1, 0, 2, 0, 3, 1}; // numer sąsiedniego toru na końcu segmentu "-1"
-TIsolated *TIsolated::pRoot = NULL;
 
 TTrack::profiles_array TTrack::m_profiles;
 TTrack::profiles_map TTrack::m_profilesmap;
+std::uint32_t TTrack::m_scanrevision { 0 };
 
 TSwitchExtension::TSwitchExtension(TTrack *owner, int const what)
 { // na początku wszystko puste
@@ -74,40 +74,12 @@ TSwitchExtension::TSwitchExtension(TTrack *owner, int const what)
 TSwitchExtension::~TSwitchExtension()
 { // nie ma nic do usuwania
 }
-/*
-TIsolated::TIsolated()
-{ // utworznie pustego
-    TIsolated("none", NULL);
-};
-*/
-TIsolated::TIsolated(std::string const &n, TIsolated *i) :
-                                asName( n ),   pNext( i )
+TIsolated::TIsolated( std::string const &Name ) :
+    asName( Name )
 {
     // utworznie obwodu izolowanego. nothing to do here.
 };
 
-void TIsolated::DeleteAll() {
-
-    while( pRoot ) {
-        auto *next = pRoot->Next();
-        delete pRoot;
-        pRoot = next;
-    }
-}
-
-TIsolated * TIsolated::Find(std::string const &n)
-{ // znalezienie obiektu albo utworzenie nowego
-    TIsolated *p = pRoot;
-    while (p)
-    { // jeśli się znajdzie, to podać wskaźnik
-        if (p->asName == n)
-            return p;
-        p = p->pNext;
-    }
-    pRoot = new TIsolated(n, pRoot); // BUG: source of a memory leak
-    return pRoot;
-};
-
 void
 TIsolated::AssignEvents() {
 
@@ -124,6 +96,7 @@ void TIsolated::Modify(int i, TDynamicObject *o)
         iAxles += i;
         if (!iAxles)
         { // jeśli po zmianie nie ma żadnej osi na odcinku izolowanym
+            simulation::Paths.isolated().mark_changed( this );
             if (evFree)
                 simulation::Events.AddToQuery(evFree, o); // dodanie zwolnienia do kolejki
 			if (Global.iMultiplayer) // jeśli multiplayer
@@ -138,6 +111,7 @@ void TIsolated::Modify(int i, TDynamicObject *o)
         iAxles += i;
         if (iAxles)
         {
+            simulation::Paths.isolated().mark_changed( this );
             if (evBusy)
                 simulation::Events.AddToQuery(evBusy, o); // dodanie zajętości do kolejki
 			if (Global.iMultiplayer) // jeśli multiplayer
@@ -332,6 +306,7 @@ void TTrack::ConnectPrevPrev(TTrack *pTrack, int typ)
         iPrevDirection = ((pTrack->eType == tt_Switch) ? 0 : (typ & 2));
         pTrack->trPrev = this;
         pTrack->iPrevDirection = 0;
+        connections_changed( pTrack );
     }
 }
 void TTrack::ConnectPrevNext(TTrack *pTrack, int typ)
@@ -352,6 +327,7 @@ void TTrack::ConnectPrevNext(TTrack *pTrack, int typ)
                             (fTexHeight1 != pTrack->fTexHeight1) ||
                             (fTexWidth != pTrack->fTexWidth) || (fTexSlope != pTrack->fTexSlope))
                             pTrack->iTrapezoid |= 2; // to rysujemy potworka
+        connections_changed( pTrack );
     }
 }
 void TTrack::ConnectNextPrev(TTrack *pTrack, int typ)
@@ -372,6 +348,7 @@ void TTrack::ConnectNextPrev(TTrack *pTrack, int typ)
                             (fTexHeight1 != pTrack->fTexHeight1) ||
                             (fTexWidth != pTrack->fTexWidth) || (fTexSlope != pTrack->fTexSlope))
                             iTrapezoid |= 2; // to rysujemy potworka
+        connections_changed( pTrack );
     }
 }
 void TTrack::ConnectNextNext(TTrack *pTrack, int typ)
@@ -382,6 +359,19 @@ void TTrack::ConnectNextNext(TTrack *pTrack, int typ)
         iNextDirection = typ | 1; // 1:zwykły lub pierwszy zwrotnicy, 3:drugi zwrotnicy
         pTrack->trNext = this;
         pTrack->iNextDirection = 1;
+        connections_changed( pTrack );
+    }
+}
+
+// updates revision and compiled graph data after change of connections with specified other path
+void
+TTrack::connections_changed( TTrack *Other ) {
+
+    ++m_scanrevision;
+    auto &graph { simulation::Paths.graph() };
+    graph.update( this );
+    if( Other != nullptr ) {
+        graph.update( Other );
     }
 }
 
@@ -483,7 +473,7 @@ void TTrack::Load(cParser *parser, glm::dvec3 const &pOrigin)
         m_material1 = (
             str == "none" ?
                 null_handle :
-                GfxRenderer->Fetch_Material( str ) );
+                GfxRenderer->Fetch_Material( str, false ) );
         parser->getTokens();
         *parser >> fTexLength; // tex tile length
         if (fTexLength < 0.01)
@@ -493,7 +483,7 @@ void TTrack::Load(cParser *parser, glm::dvec3 const &pOrigin)
         m_material2 = (
             str == "none" ?
                 null_handle :
-                GfxRenderer->Fetch_Material( str ) );
+                GfxRenderer->Fetch_Material( str, false ) );
         parser->getTokens(3);
         *parser
             >> fTexHeight1
@@ -853,7 +843,7 @@ void TTrack::Load(cParser *parser, glm::dvec3 const &pOrigin)
         { // obwód izolowany, do którego tor należy
             parser->getTokens();
             *parser >> token;
-            pIsolated = TIsolated::Find(token);
+            pIsolated = simulation::Paths.isolated().find_or_insert(token);
         }
         else if (str == "angle1")
         { // kąt ścięcia końca od strony 1
@@ -901,7 +891,7 @@ void TTrack::Load(cParser *parser, glm::dvec3 const &pOrigin)
             // switch trackbed texture
             auto const trackbedtexture { parser->getToken<std::string>() };
             if( eType == tt_Switch ) {
-                SwitchExtension->m_material3 = GfxRenderer->Fetch_Material( trackbedtexture );
+                SwitchExtension->m_material3 = GfxRenderer->Fetch_Material( trackbedtexture, false );
             }
         }
         else if( str == "railprofile" ) {
@@ -926,7 +916,7 @@ void TTrack::Load(cParser *parser, glm::dvec3 const &pOrigin)
         if ((i = m_name.find("@")) != std::string::npos)
             if (i < m_name.length()) // nie może być puste
             {
-                pIsolated = TIsolated::Find(m_name.substr(i + 1, m_name.length()));
+                pIsolated = simulation::Paths.isolated().find_or_insert(m_name.substr(i + 1, m_name.length()));
                 m_name = m_name.substr(0, i - 1); // usunięcie z nazwy
             }
 
@@ -940,6 +930,7 @@ void TTrack::Load(cParser *parser, glm::dvec3 const &pOrigin)
 
 bool TTrack::AssignEvents() {
 
+    ++m_scanrevision;
     bool lookupfail { false };
 
     std::vector< std::pair< std::string, event_sequence * > > const eventsequences {
@@ -974,6 +965,7 @@ bool TTrack::AssignEvents() {
             }
         }
     }
+    simulation::Paths.graph().update( this );
 
     return ( lookupfail == false );
 }
@@ -1768,6 +1760,7 @@ bool TTrack::Switch(int i, float const t, float const d)
             else {
                 fVelocity = SwitchExtension->fVelocity;
             }
+            simulation::Paths.graph().update( this );
             if (SwitchExtension->pOwner ? SwitchExtension->pOwner->RaTrackAnimAdd(this) :
                                           true) // jeśli nie dodane do animacji
             { // nie ma się co bawić
@@ -1779,8 +1772,12 @@ bool TTrack::Switch(int i, float const t, float const d)
         }
         else if (eType == tt_Table)
         { // blokowanie (0, szukanie torów) lub odblokowanie (1, rozłączenie) obrotnicy
+            // the turntable modifies connections of neighbouring tracks
+            ++m_scanrevision;
             if (i) // NOTE: this condition seems opposite to intention/comment? TODO: investigate this
             { // 0: rozłączenie sąsiednich torów od obrotnicy
+                auto *previous { trPrev };
+                auto *next { trNext };
                 if (trPrev) // jeśli jest tor od Point1 obrotnicy
                     if (iPrevDirection) // 0:dołączony Point1, 1:dołączony Point2
                         trPrev->trNext = NULL; // rozłączamy od Point2
@@ -1793,6 +1790,8 @@ bool TTrack::Switch(int i, float const t, float const d)
                         trNext->trPrev = NULL; // rozłączamy od Point1
                 trNext = trPrev =
                     NULL; // na końcu rozłączamy obrotnicę (wkaźniki do sąsiadów już niepotrzebne)
+                connections_changed( previous );
+                connections_changed( next );
                 fVelocity = 0.0; // AI, nie ruszaj się!
                 if (SwitchExtension->pOwner)
                     SwitchExtension->pOwner->RaTrackAnimAdd(this); // dodanie do listy animacyjnej
@@ -1834,10 +1833,13 @@ bool TTrack::Switch(int i, float const t, float const d)
             trPrev = SwitchExtension->pPrevs[i];
             iNextDirection = SwitchExtension->iNextDirection[i];
             iPrevDirection = SwitchExtension->iPrevDirection[i];
+            simulation::Paths.graph().update( this );
             return true;
         }
-    if (iCategoryFlag == 1)
+    if (iCategoryFlag == 1) {
         iDamageFlag = (iDamageFlag & 127) + 128 * (i & 1); // przełączanie wykolejenia
+        ++m_scanrevision;
+    }
     else
         Error("Cannot switch normal track");
     return false;
@@ -2482,6 +2484,8 @@ void TTrack::MovedUp1(float const dh)
 
 // ustawienie prędkości z ograniczeniem do pierwotnej wartości (zapisanej w scenerii)
 void TTrack::VelocitySet(float v) {
+
+    auto const velocity { fVelocity };
     // TBD, TODO: add a variable to preserve potential speed limit set by the track configuration on basic track pieces
     if( ( SwitchExtension )
      && ( SwitchExtension->fVelocity != -1 ) ) {
@@ -2498,6 +2502,9 @@ void TTrack::VelocitySet(float v) {
     else {
         fVelocity = v; // nie ma ograniczenia
     }
+    if( fVelocity != velocity ) {
+        ++m_scanrevision;
+    }
 };
 
 double TTrack::VelocityGet()
@@ -3360,11 +3367,133 @@ TTrack::copy_adjacent_trackbed_material( TTrack const *Exclude ) {
 
 
 
-path_table::~path_table() {
+// builds the graph from provided list of paths
+void
+path_graph::compile( std::deque<TTrack *> const &Paths ) {
+
+    for( auto *path : m_paths ) {
+        path->m_graphid = none;
+    }
+    m_paths.assign( std::begin( Paths ), std::end( Paths ) );
+    auto const pathcount { m_paths.size() };
+    m_lengths.assign( pathcount, 0.0 );
+    m_flags.assign( pathcount, 0 );
+    m_prev.assign( pathcount, none );
+    m_next.assign( pathcount, none );
+    m_prevreverse.assign( pathcount, 0 );
+    m_nextreverse.assign( pathcount, 0 );
+    // indices have to be assigned before any connection can be resolved
+    for( std::size_t idx = 0; idx < pathcount; ++idx ) {
+        m_paths[ idx ]->m_graphid = static_cast<std::int32_t>( idx );
+    }
+    for( auto const *path : m_paths ) {
+        update( path );
+    }
+}
 
-    TIsolated::DeleteAll();
+// refreshes connections, length and flags of specified path
+void
+path_graph::update( TTrack const *Path ) {
+
+    auto const pathid { id( Path ) };
+    if( pathid == none ) { return; }
+
+    auto const has_passive_events = []( TTrack::event_sequence const &Events ) {
+        return std::any_of(
+            std::begin( Events ), std::end( Events ),
+            []( auto const &Event ) {
+                return ( ( Event.second != nullptr )
+                      && ( Event.second->m_passive ) ); } ); };
+
+    std::uint8_t flags { 0 };
+    if( Path->eType == tt_Normal ) { flags |= normal; }
+    if( Path->fRadius == 0.0 )     { flags |= straight; }
+    if( Path->iAction != 0 )       { flags |= action; }
+    if( has_passive_events( Path->m_events1 ) ) { flags |= events1; }
+    if( has_passive_events( Path->m_events2 ) ) { flags |= events2; }
+    // crossroads pick their exits based on route, and paths created after compilation aren't indexed
+    if( ( Path->eType == tt_Cross )
+     || ( ( Path->trPrev != nullptr ) && ( id( Path->trPrev ) == none ) )
+     || ( ( Path->trNext != nullptr ) && ( id( Path->trNext ) == none ) ) ) {
+        flags |= indirect;
+    }
+    m_flags[ pathid ] = flags;
+    m_lengths[ pathid ] = Path->Length();
+    // entering crossroads doesn't change direction, it's determined by selected segment
+    m_prev[ pathid ] = id( Path->trPrev );
+    m_prevreverse[ pathid ] = (
+        ( Path->trPrev != nullptr )
+     && ( Path->trPrev->eType != tt_Cross )
+     && ( Path->iPrevDirection == 0 ) );
+    m_next[ pathid ] = id( Path->trNext );
+    m_nextreverse[ pathid ] = (
+        ( Path->trNext != nullptr )
+     && ( Path->trNext->eType != tt_Cross )
+     && ( Path->iNextDirection != 0 ) );
 }
 
+// finds path connected to specified path in specified direction, reversing the direction if the paths have opposite orientation. returns: index of located path, or none
+std::int32_t
+path_graph::connected( std::int32_t const Id, double &Direction ) const {
+
+    if( ( m_flags[ Id ] & indirect ) != 0 ) {
+        return id( m_paths[ Id ]->Connected( static_cast<int>( Direction ), Direction ) );
+    }
+    if( Direction > 0 ) {
+        if( ( m_next[ Id ] != none ) && ( m_nextreverse[ Id ] != 0 ) ) {
+            Direction = -Direction;
+        }
+        return m_next[ Id ];
+    }
+    else {
+        if( ( m_prev[ Id ] != none ) && ( m_prevreverse[ Id ] != 0 ) ) {
+            Direction = -Direction;
+        }
+        return m_prev[ Id ];
+    }
+}
+
+
+
+// locates circuit with specified name, creating it if it doesn't exist. returns: located or created circuit
+TIsolated *
+isolated_table::find_or_insert( std::string const &Name ) {
+
+    auto *isolated { find( Name ) };
+    if( isolated != nullptr ) {
+        return isolated;
+    }
+    isolated = new TIsolated( Name );
+    isolated->m_handle = static_cast<std::uint32_t>( m_items.size() );
+    m_items.emplace_back( isolated );
+    // NOTE: unlike generic insert() we map every name, as legacy lookup matched also empty and "none" circuit names
+    m_itemmap.emplace( Name, isolated->m_handle );
+    return isolated;
+}
+
+// adds specified circuit to the list of circuits with changed occupation state
+void
+isolated_table::mark_changed( TIsolated *Isolated ) {
+
+    if( true == Isolated->m_changed ) { return; }
+
+    Isolated->m_changed = true;
+    m_changes.emplace_back( Isolated );
+}
+
+// provides list of circuits with changed occupation state since last call, and clears it
+std::vector<TIsolated *>
+isolated_table::fetch_changes() {
+
+    for( auto *isolated : m_changes ) {
+        isolated->m_changed = false;
+    }
+    std::vector<TIsolated *> changes;
+    changes.swap( m_changes );
+    return changes;
+}
+
+
 // legacy method, initializes tracks after deserialization from scenario file
 void
 path_table::InitTracks() {
@@ -3532,8 +3661,7 @@ path_table::InitTracks() {
         }
     }
 
-    auto *isolated = TIsolated::Root();
-    while( isolated ) {
+    for( auto *isolated : m_isolated.sequence() ) {
 
         isolated->AssignEvents();
 
@@ -3550,11 +3678,11 @@ path_table::InitTracks() {
         }
         // przypisanie powiązanej komórki
         isolated->pMemCell = memorycell;
-
-        isolated = isolated->Next();
     }
 
     TTrack::fetch_default_profiles();
+    // all connections are established at this point, so the network can be compiled
+    m_graph.compile( m_items );
 }
 
 // legacy method, sends list of occupied paths over network
@@ -3570,15 +3698,25 @@ path_table::TrackBusyList() const {
     }
 }
 
-// legacy method, sends list of occupied path sections over network
+// legacy method, sends list of occupied path sections over network, either complete or only ones changed since last report
 void
-path_table::IsolatedBusyList() const {
+path_table::IsolatedBusyList( bool const Changesonly ) {
     // wysłanie informacji o wszystkich odcinkach izolowanych
-    TIsolated *Current;
-    for( Current = TIsolated::Root(); Current; Current = Current->Next() ) {
+    // NOTE: the change list is reset also by complete report, as it brings the receiver up to date
+    auto const send_state = []( TIsolated *Isolated ) {
+        if( Isolated->Busy() ) { multiplayer::WyslijString( Isolated->asName, 11 ); }
+        else                   { multiplayer::WyslijString( Isolated->asName, 10 ); } };
 
-        if( Current->Busy() ) { multiplayer::WyslijString( Current->asName, 11 ); }
-        else                  { multiplayer::WyslijString( Current->asName, 10 ); }
+    auto const changes { m_isolated.fetch_changes() };
+    if( true == Changesonly ) {
+        for( auto *isolated : changes ) {
+            send_state( isolated );
+        }
+    }
+    else {
+        for( auto *isolated : m_isolated.sequence() ) {
+            send_state( isolated );
+        }
     }
     multiplayer::WyslijString( "none", 10 ); // informacja o końcu listy
 }
@@ -3587,15 +3725,11 @@ path_table::IsolatedBusyList() const {
 void
 path_table::IsolatedBusy( std::string const &Name ) const {
     // wysłanie informacji o odcinku izolowanym (t)
-    // Ra 2014-06: do wyszukania użyć drzewka nazw
-    TIsolated *Current;
-    for( Current = TIsolated::Root(); Current; Current = Current->Next() ) {
-        if( Current->asName == Name ) {
-            if( Current->Busy() ) { multiplayer::WyslijString( Current->asName, 11 ); }
-            else                  { multiplayer::WyslijString( Current->asName, 10 ); }
-            // nie sprawdzaj dalszych
-            return;
-        }
+    auto *isolated { m_isolated.find( Name ) };
+    if( isolated == nullptr ) {
+        multiplayer::WyslijString( Name, 10 ); // wolny (technically not found but, eh)
+        return;
     }
-    multiplayer::WyslijString( Name, 10 ); // wolny (technically not found but, eh)
+    if( isolated->Busy() ) { multiplayer::WyslijString( isolated->asName, 11 ); }
+    else                   { multiplayer::WyslijString( isolated->asName, 10 ); }
 }
@@ -101,12 +101,12 @@ class TSwitchExtension
 
 class TIsolated
 { // obiekt zbierający zajętości z kilku odcinków
+    friend class isolated_table;
+
 public:
     // constructors
-    TIsolated(const std::string &n, TIsolated *i);
+    explicit TIsolated( std::string const &Name );
     // methods
-    static void DeleteAll();
-    static TIsolated * Find(const std::string &n); // znalezienie obiektu albo utworzenie nowego
     void AssignEvents();
     void Modify(int i, TDynamicObject *o); // dodanie lub odjęcie osi
     inline
@@ -114,13 +114,9 @@ public:
         Busy() {
             return (iAxles > 0); };
     inline
-    static TIsolated *
-        Root() {
-            return (pRoot); };
-    inline
-    TIsolated *
-        Next() {
-            return (pNext); };
+    std::uint32_t
+        handle() const {
+            return m_handle; }
     inline
     void
         parent( TIsolated *Parent ) {
@@ -139,9 +135,37 @@ public:
 private:
     // members
     int iAxles { 0 }; // ilość osi na odcinkach obsługiwanych przez obiekt
-    TIsolated *pNext { nullptr }; // odcinki izolowane są trzymane w postaci listy jednikierunkowej
     TIsolated *pParent { nullptr }; // optional parent piece, receiving data from its children
-    static TIsolated *pRoot; // początek listy
+    std::uint32_t m_handle { 0 }; // index of the piece in the registry
+    bool m_changed { false }; // whether the piece is listed as changed since last report
+};
+
+// registry of isolated track circuits, owns the circuits and tracks changes of their state
+class isolated_table : public basic_table<TIsolated> {
+
+public:
+// methods
+    // locates circuit with specified name, creating it if it doesn't exist. returns: located or created circuit
+    TIsolated *
+        find_or_insert( std::string const &Name );
+    // provides circuit with specified handle. returns: the circuit, or nullptr for invalid handle
+    TIsolated *
+        find( std::uint32_t const Handle ) const {
+            return (
+                Handle < m_items.size() ?
+                    m_items[ Handle ] :
+                    nullptr ); }
+    using basic_table<TIsolated>::find;
+    // adds specified circuit to the list of circuits with changed occupation state
+    void
+        mark_changed( TIsolated *Isolated );
+    // provides list of circuits with changed occupation state since last call, and clears it
+    std::vector<TIsolated *>
+        fetch_changes();
+
+private:
+// members
+    std::vector<TIsolated *> m_changes; // circuits changed since last report
 };
 
 // trajektoria ruchu - opakowanie
@@ -151,6 +175,7 @@ class TTrack : public scene::basic_node
     friend opengl33_renderer;
     // NOTE: temporary arrangement
     friend itemproperties_panel;
+    friend class path_graph;
 
 private:
     TIsolated * pIsolated = nullptr; // obwód izolowany obsługujący zajęcia/zwolnienia grupy torów
@@ -182,6 +207,7 @@ private:
 
     std::vector<segment_data> m_paths; // source data for owned paths
 	int iterate_stamp = 0;
+    std::int32_t m_graphid { -1 }; // index of the path in compiled path graph
 
 public:
     using dynamics_sequence = std::deque<TDynamicObject *>;
@@ -313,12 +339,17 @@ public:
     void ConnectionsLog();
     bool DoubleSlip() const;
     static void fetch_default_profiles();
+    // provides revision of track properties used by route scans; changes when connections, speed limits or event assignments are modified
+    static std::uint32_t scan_revision() {
+        return m_scanrevision; }
 
 private:
 // types
     using profiles_array = std::vector<gfx::vertex_array>;
     using profiles_map = std::unordered_map<std::string, int>;
 // methods
+    // updates revision and compiled graph data after change of connections with specified other path
+    void connections_changed( TTrack *Other );
     // radius() subclass details, calculates node's bounding radius
     float radius_();
     // serialize() subclass details, sends content of the subclass to provided stream
@@ -345,27 +376,103 @@ private:
 // members
     static profiles_array m_profiles; // shared database of path element profiles
     static profiles_map m_profilesmap;
+    static std::uint32_t m_scanrevision; // bumped on changes which may invalidate cached route scans
 };
 
 
 
+// flat copy of path network topology, compiled after the paths are initialized.
+// switch changes and new connections are applied in place, so the data follows current state of the network
+class path_graph {
+
+public:
+// types
+    enum flag : std::uint8_t {
+        normal = 0x01, // ordinary path, not a switch, crossroads or turntable
+        straight = 0x02, // path has no horizontal curvature
+        events1 = 0x04, // path has passive events for movement towards point1
+        events2 = 0x08, // path has passive events for movement towards point2
+        action = 0x10, // path has properties significant for route scans
+        indirect = 0x20, // connections have to be resolved through the path itself
+    };
+// constants
+    static std::int32_t const none { -1 };
+// methods
+    // builds the graph from provided list of paths
+    void
+        compile( std::deque<TTrack *> const &Paths );
+    // refreshes connections, length and flags of specified path
+    void
+        update( TTrack const *Path );
+    // provides index of specified path. returns: none if the path isn't part of the graph
+    std::int32_t
+        id( TTrack const *Path ) const {
+            return (
+                ( ( Path != nullptr ) && ( Path->m_graphid < static_cast<std::int32_t>( m_paths.size() ) ) ) ?
+                    Path->m_graphid :
+                    none ); }
+    // finds path connected to specified path in specified direction, reversing the direction if the paths have opposite orientation. returns: index of located path, or none
+    std::int32_t
+        connected( std::int32_t const Id, double &Direction ) const;
+    std::size_t
+        size() const {
+            return m_paths.size(); }
+    TTrack *
+        path( std::int32_t const Id ) const {
+            return m_paths[ Id ]; }
+    double
+        length( std::int32_t const Id ) const {
+            return m_lengths[ Id ]; }
+    std::uint8_t
+        flags( std::int32_t const Id ) const {
+            return m_flags[ Id ]; }
+
+private:
+// members
+    std::vector<TTrack *> m_paths;
+    std::vector<double> m_lengths;
+    std::vector<std::uint8_t> m_flags;
+    std::vector<std::int32_t> m_prev; // index of path connected to point1
+    std::vector<std::int32_t> m_next; // index of path connected to point2
+    std::vector<std::uint8_t> m_prevreverse; // whether movement onto the path connected to point1 reverses direction
+    std::vector<std::uint8_t> m_nextreverse; // whether movement onto the path connected to point2 reverses direction
+};
+
 // collection of virtual tracks and roads present in the scene
 class path_table : public basic_table<TTrack> {
 
 public:
-    ~path_table();
     // legacy method, initializes tracks after deserialization from scenario file
     void
         InitTracks();
+    // provides access to compiled topology of the path network
+    path_graph const &
+        graph() const {
+            return m_graph; }
+    path_graph &
+        graph() {
+            return m_graph; }
     // legacy method, sends list of occupied paths over network
     void
         TrackBusyList() const;
-    // legacy method, sends list of occupied path sections over network
+    // provides access to registry of isolated track circuits
+    isolated_table const &
+        isolated() const {
+            return m_isolated; }
+    isolated_table &
+        isolated() {
+            return m_isolated; }
+    // legacy method, sends list of occupied path sections over network, either complete or only ones changed since last report
     void
-        IsolatedBusyList() const;
+        IsolatedBusyList( bool const Changesonly = false );
     // legacy method, sends state of specified path section over network
     void
         IsolatedBusy( std::string const &Name ) const;
+
+private:
+// members
+    path_graph m_graph;
+    isolated_table m_isolated;
 };
 
 //---------------------------------------------------------------------------
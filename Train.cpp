@@ -96,6 +96,10 @@ bool TTrain::screen_entry::deserialize_mapping( cParser &Input ) {
     else if( key == "parameters:" ) {
         parameters = dictionary_source( Input.getToken<std::string>() );
     }
+    else if( key == "fields:" ) {
+        // comma-separated list of state fields read by the script
+        fields = Split( Input.getToken<std::string>(), ',' );
+    }
     else {
         // HACK: we expect this to be true only if the screen entry doesn't start with a { which means legacy configuration format
         target = key;
@@ -614,6 +618,193 @@ bool TTrain::Init(TDynamicObject *NewDynamicObject, bool e3d)
     return true;
 }
 
+namespace {
+
+// converts state value to dictionary entry, picking the same type the dictionary would pick on insertion
+dictionary_value make_state_value( double const Value ) { return dictionary_value{ std::in_place_type<double>, Value }; }
+dictionary_value make_state_value( int const Value ) { return dictionary_value{ std::in_place_type<int>, Value }; }
+dictionary_value make_state_value( bool const Value ) { return dictionary_value{ std::in_place_type<bool>, Value }; }
+dictionary_value make_state_value( std::string const Value ) { return dictionary_value{ std::in_place_type<std::string>, Value }; }
+
+} // anonymous
+
+// returns sources of state values with fixed names, shared by all trains
+std::vector<TTrain::state_field> const &
+TTrain::state_fields() {
+
+    static std::vector<state_field> const fields { []() {
+
+        std::vector<state_field> fields;
+        auto add = [&]( std::string const &Name, auto Source ) {
+            fields.push_back( { Name, [=]( TTrain &Train ) { return make_state_value( Source( Train ) ); } } ); };
+
+        add( "name", []( TTrain &Train ) { return Train.DynamicObject->asName; } );
+        add( "cab", []( TTrain &Train ) { return Train.mvOccupied->CabOccupied; } );
+        // basic systems state data
+        add( "battery", []( TTrain &Train ) { return Train.mvOccupied->Power24vIsAvailable; } );
+        add( "linebreaker", []( TTrain &Train ) { return Train.mvControlled->Mains; } );
+        add( "main_init", []( TTrain &Train ) { return ( Train.mvControlled->MainsInitTimeCountdown < Train.mvControlled->MainsInitTime ) && ( Train.mvControlled->MainsInitTimeCountdown > 0.0 ); } );
+        add( "main_ready", []( TTrain &Train ) { return ( false == Train.mvControlled->Mains ) && ( Train.fHVoltage > 0.0 ) && ( Train.mvControlled->MainsInitTimeCountdown <= 0.0 ); } );
+        add( "converter", []( TTrain &Train ) { return Train.mvOccupied->Power110vIsAvailable; } );
+        add( "converter_overload", []( TTrain &Train ) { return Train.mvControlled->ConvOvldFlag; } );
+        add( "compress", []( TTrain &Train ) { return Train.mvControlled->CompressorFlag; } );
+        add( "pant_compressor", []( TTrain &Train ) { return Train.mvPantographUnit->PantCompFlag; } );
+        add( "lights_front", []( TTrain &Train ) { return Train.mvOccupied->iLights[ end::front ]; } );
+        add( "lights_rear", []( TTrain &Train ) { return Train.mvOccupied->iLights[ end::rear ]; } );
+        add( "lights_compartments", []( TTrain &Train ) { return Train.mvOccupied->CompartmentLights.is_active || Train.mvOccupied->CompartmentLights.is_disabled; } );
+        // lights at the ends of the train, as seen from the occupied cab
+        auto const trainlights = []( TTrain &Train, bool const Front ) {
+            if( Train.Dynamic()->Mechanik == nullptr ) {
+                // fallback, in the unlikely case we lose the controller
+                return Train.mvOccupied->iLights[ Front ? end::front : end::rear ];
+            }
+            auto const *controller { Train.Dynamic()->Mechanik };
+            auto const cabmodifier { Train.cab_to_end() == end::front ? 1 : -1 };
+            auto const traindirection { controller->Direction() * cabmodifier };
+            auto const *vehicle { controller->Vehicle( ( traindirection >= 0 ) == Front ? end::front : end::rear ) };
+            auto const vehicledirection { ( vehicle->DirectionGet() == controller->Vehicle()->DirectionGet() ? 1 : -1 ) };
+            return vehicle->MoverParameters->iLights[ ( vehicledirection * cabmodifier >= 0 ) == Front ? end::front : end::rear ]; };
+        add( "lights_train_front", [=]( TTrain &Train ) { return trainlights( Train, true ); } );
+        add( "lights_train_rear", [=]( TTrain &Train ) { return trainlights( Train, false ); } );
+        // reverser
+        add( "direction", []( TTrain &Train ) { return Train.mvOccupied->DirActive; } );
+        // throttle
+        add( "mainctrl_pos", []( TTrain &Train ) { return Train.mvControlled->MainCtrlPos; } );
+        add( "main_ctrl_actual_pos", []( TTrain &Train ) { return Train.mvControlled->MainCtrlActualPos; } );
+        add( "scndctrl_pos", []( TTrain &Train ) { return Train.mvControlled->ScndCtrlPos; } );
+        add( "scnd_ctrl_actual_pos", []( TTrain &Train ) { return Train.mvControlled->ScndCtrlActualPos; } );
+        add( "brakectrl_pos", []( TTrain &Train ) { return Train.mvControlled->fBrakeCtrlPos; } );
+        add( "localbrake_pos", []( TTrain &Train ) { return Train.mvControlled->LocalBrakePosA; } );
+        add( "new_speed", []( TTrain &Train ) { return Train.mvOccupied->NewSpeed; } );
+        add( "speedctrl", []( TTrain &Train ) { return Train.mvOccupied->SpeedCtrlValue; } );
+        add( "speedctrlpower", []( TTrain &Train ) { return Train.mvOccupied->SpeedCtrlUnit.DesiredPower; } );
+        add( "speedctrlactive", []( TTrain &Train ) { return Train.mvOccupied->SpeedCtrlUnit.IsActive; } );
+        add( "speedctrlstandby", []( TTrain &Train ) { return Train.mvOccupied->SpeedCtrlUnit.Standby; } );
+        // brakes
+        add( "manual_brake", []( TTrain &Train ) { return ( Train.mvOccupied->ManualBrakePos > 0 ); } );
+        add( "dir_brake", []( TTrain &Train ) { return ( Train.mvControlled->LocHandle->GetCP() > 0.2 ) || ( Train.fEIMParams[ 0 ][ 5 ] > 0.01 ); } );
+        add( "indir_brake", []( TTrain &Train ) {
+            auto *brake { Train.mvOccupied->Hamulec.get() };
+            if( ( typeid( *brake ) == typeid( TLSt ) )
+             || ( typeid( *brake ) == typeid( TEStED ) ) ) {
+                return ( static_cast<TLSt *>( brake )->GetEDBCP() > 0.2 );
+            }
+            return false; } );
+        add( "emergency_brake", []( TTrain &Train ) { return Train.mvOccupied->AlarmChainFlag; } );
+        add( "brake_delay_flag", []( TTrain &Train ) { return Train.mvOccupied->BrakeDelayFlag; } );
+        add( "brake_op_mode_flag", []( TTrain &Train ) { return Train.mvOccupied->BrakeOpModeFlag; } );
+        // other controls
+        add( "ca", []( TTrain &Train ) { return Train.mvOccupied->SecuritySystem.is_blinking(); } );
+        add( "shp", []( TTrain &Train ) { return Train.mvOccupied->SecuritySystem.is_cabsignal_blinking(); } );
+        add( "distance_counter", []( TTrain &Train ) { return Train.m_distancecounter; } );
+        add( "pantpress", []( TTrain &Train ) { return std::abs( Train.mvPantographUnit->PantPress ); } );
+        add( "universal3", []( TTrain &Train ) { return Train.InstrumentLightActive; } );
+        for( auto idx = 0; idx < std::tuple_size<decltype( TTrain::ggUniversals )>::value; ++idx ) {
+            if( idx != 3 ) {
+                add( "universal" + std::to_string( idx ), [=]( TTrain &Train ) { return ( Train.ggUniversals[ idx ].GetValue() > 0.5 ); } );
+            }
+        }
+        add( "radio", []( TTrain &Train ) { return Train.mvOccupied->Radio; } );
+        add( "radio_channel", []( TTrain &Train ) { return Train.RadioChannel(); } );
+        add( "radio_volume", []( TTrain &Train ) { return Global.RadioVolume; } );
+        add( "door_lock", []( TTrain &Train ) { return Train.mvOccupied->Doors.lock_enabled; } );
+        add( "door_step", []( TTrain &Train ) { return Train.mvOccupied->Doors.step_enabled; } );
+        // movement data
+        add( "velocity", []( TTrain &Train ) { return std::abs( Train.mvOccupied->Vel ); } );
+        add( "tractionforce", []( TTrain &Train ) { return std::abs( Train.mvOccupied->Ft ); } );
+        add( "slipping_wheels", []( TTrain &Train ) { return Train.mvOccupied->SlippingWheels; } );
+        add( "sanding", []( TTrain &Train ) { return Train.mvOccupied->SandDose; } );
+        add( "odometer", []( TTrain &Train ) { return Train.mvOccupied->DistCounter; } );
+        // electric current data
+        add( "traction_voltage", []( TTrain &Train ) { return std::abs( Train.mvPantographUnit->PantographVoltage ); } );
+        add( "voltage", []( TTrain &Train ) { return std::abs( Train.mvControlled->EngineVoltage ); } );
+        add( "im", []( TTrain &Train ) { return std::abs( Train.mvControlled->Im ); } );
+        add( "fuse", []( TTrain &Train ) { return Train.mvControlled->FuseFlag; } );
+        add( "epfuse", []( TTrain &Train ) { return Train.mvOccupied->EpFuse; } );
+        // induction motor state data
+        char const *TXTT[ 10 ] = { "fd", "fdt", "fdb", "pd", "pdt", "pdb", "itothv", "1", "2", "3" };
+        char const *TXTC[ 10 ] = { "fr", "frt", "frb", "pr", "prt", "prb", "im", "vm", "ihv", "uhv" };
+        char const *TXTD[ 10 ] = { "enrot", "nrot", "fill_des", "fill_real", "clutch_des", "clutch_real", "water_temp", "oil_press", "engine_temp", "retarder_fill" };
+        char const *TXTP[ 6 ] = { "bc", "bp", "sp", "cp", "rp", "mass" };
+        char const *TXTB[ 2 ] = { "spring_active", "spring_shutoff" };
+        for( int j = 0; j < 10; ++j ) {
+            add( ( "eimp_t_" + std::string( TXTT[ j ] ) ), [=]( TTrain &Train ) { return Train.fEIMParams[ 0 ][ j ]; } );
+        }
+        for( int i = 0; i < 8; ++i ) {
+            auto const idx { std::to_string( i + 1 ) };
+            for( int j = 0; j < 10; ++j ) {
+                add( ( "eimp_c" + idx + "_" + std::string( TXTC[ j ] ) ), [=]( TTrain &Train ) { return Train.fEIMParams[ i + 1 ][ j ]; } );
+            }
+            for( int j = 0; j < 10; ++j ) {
+                add( ( "diesel_param_" + idx + "_" + std::string( TXTD[ j ] ) ), [=]( TTrain &Train ) { return Train.fDieselParams[ i + 1 ][ j ]; } );
+            }
+            add( ( "eimp_c" + idx + "_ms" ), [=]( TTrain &Train ) { return Train.bMains[ i ]; } );
+            add( ( "eimp_c" + idx + "_cv" ), [=]( TTrain &Train ) { return Train.fCntVol[ i ]; } );
+            add( ( "eimp_c" + idx + "_fuse" ), [=]( TTrain &Train ) { return Train.bFuse[ i ]; } );
+            add( ( "eimp_c" + idx + "_batt" ), [=]( TTrain &Train ) { return Train.bBatt[ i ]; } );
+            add( ( "eimp_c" + idx + "_conv" ), [=]( TTrain &Train ) { return Train.bConv[ i ]; } );
+            add( ( "eimp_c" + idx + "_heat" ), [=]( TTrain &Train ) { return Train.bHeat[ i ]; } );
+
+            add( ( "eimp_u" + idx + "_pf" ), [=]( TTrain &Train ) { return Train.bPants[ i ][ 0 ]; } );
+            add( ( "eimp_u" + idx + "_pr" ), [=]( TTrain &Train ) { return Train.bPants[ i ][ 1 ]; } );
+            add( ( "eimp_u" + idx + "_comp_a" ), [=]( TTrain &Train ) { return Train.bComp[ i ][ 0 ]; } );
+            add( ( "eimp_u" + idx + "_comp_w" ), [=]( TTrain &Train ) { return Train.bComp[ i ][ 1 ]; } );
+        }
+        add( "compressors_no", []( TTrain &Train ) { return static_cast<int>( Train.bCompressors.size() ); } );
+        for( int i = 0; i < 20; ++i ) {
+            auto const idx { std::to_string( i + 1 ) };
+            for( int j = 0; j < 6; ++j ) {
+                add( ( "eimp_pn" + idx + "_" + TXTP[ j ] ), [=]( TTrain &Train ) { return Train.fPress[ i ][ j ]; } );
+            }
+            for( int j = 0; j < 2; ++j ) {
+                add( ( "brakes_" + idx + "_" + TXTB[ j ] ), [=]( TTrain &Train ) { return Train.bBrakes[ i ][ j ]; } );
+            }
+        }
+        // multi-unit state data
+        add( "car_no", []( TTrain &Train ) { return Train.iCarNo; } );
+        add( "power_no", []( TTrain &Train ) { return Train.iPowerNo; } );
+        add( "unit_no", []( TTrain &Train ) { return Train.iUnitNo; } );
+        for( int i = 0; i < 20; ++i ) {
+            auto const caridx { std::to_string( i + 1 ) };
+            add( ( "doors_" + caridx ), [=]( TTrain &Train ) { return Train.bDoors[ i ][ 0 ]; } );
+            add( ( "doors_l_" + caridx ), [=]( TTrain &Train ) { return Train.bDoors[ i ][ 1 ]; } );
+            add( ( "doors_r_" + caridx ), [=]( TTrain &Train ) { return Train.bDoors[ i ][ 2 ]; } );
+            add( ( "doorstep_l_" + caridx ), [=]( TTrain &Train ) { return Train.bDoors[ i ][ 3 ]; } );
+            add( ( "doorstep_r_" + caridx ), [=]( TTrain &Train ) { return Train.bDoors[ i ][ 4 ]; } );
+            add( ( "doors_no_" + caridx ), [=]( TTrain &Train ) { return Train.iDoorNo[ i ]; } );
+            add( ( "code_" + caridx ), [=]( TTrain &Train ) { return ( std::to_string( Train.iUnits[ i ] ) + Train.cCode[ i ] ); } );
+            add( ( "car_name" + caridx ), [=]( TTrain &Train ) { return Train.asCarName[ i ]; } );
+            add( ( "slip_" + caridx ), [=]( TTrain &Train ) { return Train.bSlip[ i ]; } );
+        }
+        // ai state data
+        auto const driver = []( TTrain &Train ) {
+            return (
+                Train.DynamicObject->ctOwner != nullptr ?
+                    Train.DynamicObject->ctOwner :
+                    Train.DynamicObject->Mechanik ); };
+        add( "velocity_desired", [=]( TTrain &Train ) { return driver( Train )->VelDesired; } );
+        add( "velroad", [=]( TTrain &Train ) { return driver( Train )->VelRoad; } );
+        add( "vellimitlast", [=]( TTrain &Train ) { return driver( Train )->VelLimitLast; } );
+        add( "velsignallast", [=]( TTrain &Train ) { return driver( Train )->VelSignalLast; } );
+        add( "velsignalnext", [=]( TTrain &Train ) { return driver( Train )->VelSignalNext; } );
+        add( "velnext", [=]( TTrain &Train ) { return driver( Train )->VelNext; } );
+        add( "actualproximitydist", [=]( TTrain &Train ) { return driver( Train )->ActualProximityDist; } );
+        // train data
+        add( "train_atpassengerstop", [=]( TTrain &Train ) { return driver( Train )->IsAtPassengerStop; } );
+        add( "train_length", [=]( TTrain &Train ) { return driver( Train )->fLength; } );
+        // world state data
+        add( "scenario", []( TTrain &Train ) { return Global.SceneryFile; } );
+        add( "hours", []( TTrain &Train ) { return static_cast<int>( simulation::Time.data().wHour ); } );
+        add( "minutes", []( TTrain &Train ) { return static_cast<int>( simulation::Time.data().wMinute ); } );
+        add( "seconds", []( TTrain &Train ) { return static_cast<int>( simulation::Time.second() ); } );
+        add( "air_temperature", []( TTrain &Train ) { return Global.AirTemperature; } );
+        add( "light_level", []( TTrain &Train ) { return Global.fLuminance - std::max( 0.f, Global.Overcast - 1.f ); } );
+
+        return fields; }() };
+
+    return fields;
+}
+
 dictionary_source *TTrain::GetTrainState( dictionary_source const &Extraparameters ) {
 
     if( ( mvOccupied   == nullptr )
@@ -622,125 +813,12 @@ dictionary_source *TTrain::GetTrainState( dictionary_source const &Extraparamete
     auto *dict { new dictionary_source( Extraparameters ) };
     if( dict == nullptr ) { return nullptr; }
 
-    dict->insert( "name", DynamicObject->asName );
-    dict->insert( "cab", mvOccupied->CabOccupied );
-    // basic systems state data
-    dict->insert( "battery", mvOccupied->Power24vIsAvailable );
-    dict->insert( "linebreaker", mvControlled->Mains );
-    dict->insert( "main_init", ( mvControlled->MainsInitTimeCountdown < mvControlled->MainsInitTime ) && ( mvControlled->MainsInitTimeCountdown > 0.0 ) );
-    dict->insert( "main_ready", ( false == mvControlled->Mains ) && ( fHVoltage > 0.0 ) && ( mvControlled->MainsInitTimeCountdown <= 0.0 ) );
-    dict->insert( "converter", mvOccupied->Power110vIsAvailable );
-    dict->insert( "converter_overload", mvControlled->ConvOvldFlag );
-    dict->insert( "compress", mvControlled->CompressorFlag );
-    dict->insert( "pant_compressor", mvPantographUnit->PantCompFlag );
-    dict->insert( "lights_front", mvOccupied->iLights[ end::front ] );
-    dict->insert( "lights_rear", mvOccupied->iLights[ end::rear ] );
-    dict->insert( "lights_compartments", mvOccupied->CompartmentLights.is_active || mvOccupied->CompartmentLights.is_disabled );
-    if( Dynamic()->Mechanik ) {
-        auto const *controller { Dynamic()->Mechanik };
-        auto const cabmodifier { cab_to_end() == end::front ? 1 : -1 };
-        auto const traindirection { controller->Direction() * cabmodifier };
-        auto const *frontvehicle { controller->Vehicle( traindirection >= 0 ? end::front : end::rear ) };
-        auto const *rearvehicle { controller->Vehicle( traindirection >= 0 ? end::rear : end::front ) };
-        auto const frontvehicledirection { ( frontvehicle->DirectionGet() == controller->Vehicle()->DirectionGet() ? 1 : -1 ) };
-        auto const rearvehicledirection { ( rearvehicle->DirectionGet() == controller->Vehicle()->DirectionGet() ? 1 : -1 ) };
-        auto const fronttrainlights { frontvehicle->MoverParameters->iLights[ frontvehicledirection * cabmodifier >= 0 ? end::front : end::rear ] };
-        auto const reartrainlights{ rearvehicle->MoverParameters->iLights[ rearvehicledirection * cabmodifier >= 0 ? end::rear : end::front ] };
-        dict->insert( "lights_train_front", fronttrainlights );
-        dict->insert( "lights_train_rear", reartrainlights );
-    }
-    else {
-        // fallback, in the unlikely case we lose the controller
-        dict->insert( "lights_train_front", mvOccupied->iLights[ end::front ] );
-        dict->insert( "lights_train_rear", mvOccupied->iLights[ end::rear ] );
-    }
-    // reverser
-    dict->insert( "direction", mvOccupied->DirActive );
-    // throttle
-    dict->insert( "mainctrl_pos", mvControlled->MainCtrlPos );
-    dict->insert( "main_ctrl_actual_pos", mvControlled->MainCtrlActualPos );
-    dict->insert( "scndctrl_pos", mvControlled->ScndCtrlPos );
-    dict->insert( "scnd_ctrl_actual_pos", mvControlled->ScndCtrlActualPos );
-	dict->insert( "brakectrl_pos", mvControlled->fBrakeCtrlPos );
-	dict->insert( "localbrake_pos", mvControlled->LocalBrakePosA );
-	dict->insert( "new_speed", mvOccupied->NewSpeed);
- 	dict->insert( "speedctrl", mvOccupied->SpeedCtrlValue);
-	dict->insert( "speedctrlpower", mvOccupied->SpeedCtrlUnit.DesiredPower );
-	dict->insert( "speedctrlactive", mvOccupied->SpeedCtrlUnit.IsActive );
-	dict->insert( "speedctrlstandby", mvOccupied->SpeedCtrlUnit.Standby );
-   // brakes
-    dict->insert( "manual_brake", ( mvOccupied->ManualBrakePos > 0 ) );
-    bool const bEP = ( mvControlled->LocHandle->GetCP() > 0.2 ) || ( fEIMParams[ 0 ][ 5 ] > 0.01 );
-    dict->insert( "dir_brake", bEP );
-    bool bPN { false };
-    if( ( typeid( *mvOccupied->Hamulec ) == typeid( TLSt ) )
-     || ( typeid( *mvOccupied->Hamulec ) == typeid( TEStED ) ) ) {
-
-        TBrake* temp_ham = mvOccupied->Hamulec.get();
-        bPN = ( static_cast<TLSt*>( temp_ham )->GetEDBCP() > 0.2 );
-    }
-    dict->insert( "indir_brake", bPN );
-	dict->insert( "emergency_brake", mvOccupied->AlarmChainFlag );
-	dict->insert( "brake_delay_flag", mvOccupied->BrakeDelayFlag );
-	dict->insert( "brake_op_mode_flag", mvOccupied->BrakeOpModeFlag );
-    // other controls
-    dict->insert( "ca", mvOccupied->SecuritySystem.is_blinking());
-    dict->insert( "shp", mvOccupied->SecuritySystem.is_cabsignal_blinking());
-    dict->insert( "distance_counter", m_distancecounter );
-    dict->insert( "pantpress", std::abs( mvPantographUnit->PantPress ) );
-    dict->insert( "universal3", InstrumentLightActive );
-	for (auto idx = 0; idx < ggUniversals.size(); idx++) {
-		if (idx != 3) {
-			dict->insert("universal" + std::to_string(idx), (ggUniversals[idx].GetValue() > 0.5));
-		}
-	}
-    dict->insert( "radio", mvOccupied->Radio );
-    dict->insert( "radio_channel", RadioChannel() );
-	dict->insert( "radio_volume", Global.RadioVolume );
-    dict->insert( "door_lock", mvOccupied->Doors.lock_enabled );
-	dict->insert( "door_step", mvOccupied->Doors.step_enabled );
-    // movement data
-    dict->insert( "velocity", std::abs( mvOccupied->Vel ) );
-    dict->insert( "tractionforce", std::abs( mvOccupied->Ft ) );
-    dict->insert( "slipping_wheels", mvOccupied->SlippingWheels );
-    dict->insert( "sanding", mvOccupied->SandDose );
-    dict->insert( "odometer", mvOccupied->DistCounter );
-    // electric current data
-    dict->insert( "traction_voltage", std::abs( mvPantographUnit->PantographVoltage ) );
-    dict->insert( "voltage", std::abs( mvControlled->EngineVoltage ) );
-    dict->insert( "im", std::abs(  mvControlled->Im ) );
-    dict->insert( "fuse", mvControlled->FuseFlag );
-    dict->insert( "epfuse", mvOccupied->EpFuse );
-    // induction motor state data
-    char const *TXTT[ 10 ] = { "fd", "fdt", "fdb", "pd", "pdt", "pdb", "itothv", "1", "2", "3" };
-    char const *TXTC[ 10 ] = { "fr", "frt", "frb", "pr", "prt", "prb", "im", "vm", "ihv", "uhv" };
-	char const *TXTD[ 10 ] = { "enrot", "nrot", "fill_des", "fill_real", "clutch_des", "clutch_real", "water_temp", "oil_press", "engine_temp", "retarder_fill" };
-    char const *TXTP[ 6 ] = { "bc", "bp", "sp", "cp", "rp", "mass" };
-	char const *TXTB[ 2 ] = { "spring_active", "spring_shutoff" };
-    for( int j = 0; j < 10; ++j )
-        dict->insert( ( "eimp_t_" + std::string( TXTT[ j ] ) ), fEIMParams[ 0 ][ j ] );
-    for( int i = 0; i < 8; ++i ) {
-        auto const idx { std::to_string( i + 1 ) };
-        for( int j = 0; j < 10; ++j )
-            dict->insert( ( "eimp_c" + idx + "_" + std::string( TXTC[ j ] ) ), fEIMParams[ i + 1 ][ j ] );
-
-		for (int j = 0; j < 10; ++j)
-			dict->insert(("diesel_param_" + idx + "_" + std::string(TXTD[j])), fDieselParams[i + 1][j]);
-
-        dict->insert( ( "eimp_c" + idx + "_ms" ), bMains[ i ] );
-        dict->insert( ( "eimp_c" + idx + "_cv" ), fCntVol[ i ] );
-        dict->insert( ( "eimp_c" + idx + "_fuse" ), bFuse[ i ] );
-        dict->insert( ( "eimp_c" + idx + "_batt" ), bBatt[ i ] );
-        dict->insert( ( "eimp_c" + idx + "_conv" ), bConv[ i ] );
-        dict->insert( ( "eimp_c" + idx + "_heat" ), bHeat[ i ] );
-
-        dict->insert( ( "eimp_u" + idx + "_pf" ), bPants[ i ][ 0 ] );
-        dict->insert( ( "eimp_u" + idx + "_pr" ), bPants[ i ][ 1 ] );
-        dict->insert( ( "eimp_u" + idx + "_comp_a" ), bComp[ i ][ 0 ] );
-        dict->insert( ( "eimp_u" + idx + "_comp_w" ), bComp[ i ][ 1 ] );
+    for( auto const &field : state_fields() ) {
+        std::visit(
+            [&]( auto const &Value ) { dict->insert( field.name, Value ); },
+            field.value( *this ) );
     }
-
-	dict->insert( "compressors_no", (int)bCompressors.size() );
+    // data with variable set of keys
 	for (int i = 0; i < bCompressors.size(); i++)
 	{
         auto const idx { std::to_string( i + 1 ) };
@@ -749,7 +827,6 @@ dictionary_source *TTrain::GetTrainState( dictionary_source const &Extraparamete
 		dict->insert("compressors_" + idx + "_car_no", std::get<2>(bCompressors[i]));
 	}
 
-
 	bool kier = (DynamicObject->DirectionGet() * mvOccupied->CabOccupied > 0);
 	TDynamicObject *p = DynamicObject->GetFirstDynamic(mvOccupied->CabOccupied < 0 ? end::rear : end::front, 4);
 	int in = 0;
@@ -767,59 +844,85 @@ dictionary_source *TTrain::GetTrainState( dictionary_source const &Extraparamete
 		}
 		p = (kier ? p->Next(4) : p->Prev(4));
 	}
-    for( int i = 0; i < 20; ++i ) {
-        for( int j = 0; j < 6; ++j ) {
-            dict->insert( ( "eimp_pn" + std::to_string( i + 1 ) + "_" + TXTP[ j ] ), fPress[ i ][ j ] );
-        }
-		for ( int j = 0; j < 2; ++j)  {
-			dict->insert( ( "brakes_" + std::to_string( i + 1 ) + "_" + TXTB[ j ] ), bBrakes[ i ][ j ] );
-		}
-    }
-    // multi-unit state data
-    dict->insert( "car_no", iCarNo );
-    dict->insert( "power_no", iPowerNo );
-    dict->insert( "unit_no", iUnitNo );
-
-    for( int i = 0; i < 20; i++ ) {
-        auto const caridx { std::to_string( i + 1 ) };
-        dict->insert( ( "doors_" + caridx ), bDoors[ i ][ 0 ] );
-        dict->insert( ( "doors_l_" + caridx ), bDoors[ i ][ 1 ] );
-        dict->insert( ( "doors_r_" + caridx ), bDoors[ i ][ 2 ] );
-        dict->insert( ( "doorstep_l_" + caridx ), bDoors[ i ][ 3 ] );
-        dict->insert( ( "doorstep_r_" + caridx ), bDoors[ i ][ 4 ] );
-        dict->insert( ( "doors_no_" + caridx ), iDoorNo[ i ] );
-        dict->insert( ( "code_" + caridx ), ( std::to_string( iUnits[ i ] ) + cCode[ i ] ) );
-        dict->insert( ( "car_name" + caridx ), asCarName[ i ] );
-        dict->insert( ( "slip_" + caridx ), bSlip[ i ] );
-    }
-    // ai state data
+    // train data
     auto const *driver { (
         DynamicObject->ctOwner != nullptr ?
             DynamicObject->ctOwner :
             DynamicObject->Mechanik ) };
-
-    dict->insert( "velocity_desired", driver->VelDesired );
-    dict->insert( "velroad", driver->VelRoad );
-    dict->insert( "vellimitlast", driver->VelLimitLast );
-    dict->insert( "velsignallast", driver->VelSignalLast );
-    dict->insert( "velsignalnext", driver->VelSignalNext );
-    dict->insert( "velnext", driver->VelNext );
-    dict->insert( "actualproximitydist", driver->ActualProximityDist );
-    // train data
     driver->TrainTimetable().serialize( dict );
-    dict->insert( "train_atpassengerstop", driver->IsAtPassengerStop );
-    dict->insert( "train_length", driver->fLength );
-    // world state data
-    dict->insert( "scenario", Global.SceneryFile );
-    dict->insert( "hours", static_cast<int>( simulation::Time.data().wHour ) );
-    dict->insert( "minutes", static_cast<int>( simulation::Time.data().wMinute ) );
-    dict->insert( "seconds", static_cast<int>( simulation::Time.second() ) );
-    dict->insert( "air_temperature", Global.AirTemperature );
-    dict->insert( "light_level", Global.fLuminance - std::max( 0.f, Global.Overcast - 1.f ) );
 
     return dict;
 }
 
+// updates provided collection with values of state fields selected by compiled layout. returns: true on success
+bool TTrain::GetTrainState( state_layout const &Layout, dictionary_source &Output ) {
+
+    if( ( mvOccupied   == nullptr )
+     || ( mvControlled == nullptr )
+     || ( Layout.keys == nullptr ) ) { return false; }
+
+    if( Output.layout != Layout.keys ) {
+        // first use of the collection with this layout. values without a field source keep their defaults afterwards
+        Output = {};
+        Output.layout = Layout.keys;
+        Output.values = Layout.defaults;
+    }
+
+    auto const &fields { state_fields() };
+    for( std::size_t idx = 0; idx < Layout.sources.size(); ++idx ) {
+        auto const source { Layout.sources[ idx ] };
+        if( source < 0 ) { continue; }
+        auto value { fields[ source ].value( *this ) };
+        // match the full state, where string values override screen parameters (which are strings) and other types don't
+        if( ( true == std::holds_alternative<std::string>( value ) )
+         || ( false == std::holds_alternative<std::string>( Layout.defaults[ idx ] ) ) ) {
+            Output.values[ idx ] = std::move( value );
+        }
+    }
+
+    return true;
+}
+
+// resolves declared state fields of specified screen into fixed layout
+void TTrain::compile_state_layout( screen_entry &Screen ) {
+
+    Screen.layout = {};
+    if( Screen.fields.empty() ) { return; }
+
+    static auto const fieldmap { []() {
+        std::unordered_map<std::string, int> fieldmap;
+        auto const &fields { state_fields() };
+        for( std::size_t idx = 0; idx < fields.size(); ++idx ) {
+            fieldmap.emplace( fields[ idx ].name, static_cast<int>( idx ) );
+        }
+        return fieldmap; }() };
+
+    auto keys { std::make_shared<dictionary_layout>() };
+    for( auto const &field : Screen.fields ) {
+        if( field.empty() ) { continue; }
+        auto const parameter { Screen.parameters.find( field ) };
+        auto const lookup { fieldmap.find( field ) };
+        if( lookup != std::end( fieldmap ) ) {
+            // the parameter, if any, serves as default and is resolved against the field value on retrieval
+            Screen.layout.sources.emplace_back( lookup->second );
+            Screen.layout.defaults.emplace_back( parameter ? *parameter : dictionary_value{ 0 } );
+        }
+        else if( parameter ) {
+            Screen.layout.sources.emplace_back( state_layout::parameter );
+            Screen.layout.defaults.emplace_back( *parameter );
+        }
+        else {
+            // not a fixed field, e.g. part of the timetable or per-vehicle data with variable set of keys.
+            // these are only provided by the full state, so the screen falls back on it
+            WriteLog( "Python Screen: field \"" + field + "\" declared by " + Screen.script + " isn't available in compiled form, full train state will be used instead" );
+            Screen.layout = {};
+            return;
+        }
+        keys->keys.emplace_back( field );
+    }
+    Screen.layout.keys = keys;
+}
+
 TTrain::state_t
 TTrain::get_state() const {
 
@@ -8039,12 +8142,29 @@ void TTrain::update_screens(double dt) {
 
         screen.updatetimecounter = screen.updatetime > 0 ? 0 : -1;
 
-        auto state_dict = GetTrainState(screen.parameters);
+        std::shared_ptr<dictionary_source> state_dict;
+        if (screen.layout.keys) {
+            // reuse the collection from the previous update once the worker is done with it
+            if ((screen.state == nullptr) || (screen.state.use_count() > 1))
+                screen.state = std::make_shared<dictionary_source>();
+            if (false == GetTrainState(screen.layout, *screen.state))
+                continue;
+            screen.state->vec2_lists.clear();
+            state_dict = screen.state;
+        }
+        else {
+            state_dict.reset(GetTrainState(screen.parameters));
+        }
+        if (state_dict == nullptr)
+            continue;
 
         state_dict->insert("touches", *screen.touch_list);
         screen.touch_list->clear();
 
-        Application.request({ screen.script, state_dict, screen.rt } );
+        // periodic screens are due again by the time of their next update, one-shot screens have no deadline
+        Application.request({
+            screen.script, state_dict, screen.rt,
+            std::chrono::duration<double>( std::max( screen.updatetime, 0.0 ) ) } );
     }
 }
 
@@ -8434,6 +8554,7 @@ bool TTrain::InitializeCab(int NewCabNo, std::string const &asFileName)
                 // record renderer and material binding for future update requests
                 m_screens.emplace_back(screen);
                 m_screens.back().rt = rt;
+                compile_state_layout(m_screens.back());
 
                 m_screens.back().touch_list = std::make_shared<std::vector<glm::vec2>>();
                 if (submodel)
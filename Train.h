@@ -125,6 +125,16 @@ class TTrain {
 		std::uint8_t lockpipe;
     };
 
+    // selection of train state fields compiled into fixed layout, for screens which declare the fields they read
+    struct state_layout {
+
+        static int const parameter { -1 }; // value is a screen parameter
+
+        std::shared_ptr<dictionary_layout const> keys;
+        std::vector<int> sources; // for each key index of the state field providing its value, or parameter
+        std::vector<dictionary_value> defaults; // for each key value used until the source provides one, holds screen parameters
+    };
+
     struct screen_entry {
 
         std::string script;
@@ -136,6 +146,9 @@ class TTrain {
         std::shared_ptr<std::vector<glm::vec2>> touch_list;
 
         dictionary_source parameters; // cached pre-processed optional per-screen parameters
+        std::vector<std::string> fields; // state fields read by the script, full state is passed if none are declared
+        state_layout layout; // compiled from declared fields
+        std::shared_ptr<dictionary_source> state; // train state for screens with compiled layout, reused while not held by a pending task
 
         void deserialize( cParser &Input );
         bool deserialize_mapping( cParser &Input );
@@ -167,6 +180,8 @@ class TTrain {
     // McZapkie-310302: ladowanie parametrow z pliku
     bool LoadMMediaFile(std::string const &asFileName);
     dictionary_source *GetTrainState( dictionary_source const &Extraparameters );
+    // updates provided collection with values of state fields selected by compiled layout. returns: true on success
+    bool GetTrainState( state_layout const &Layout, dictionary_source &Output );
     state_t get_state() const;
     // basic_table interface
     inline
@@ -177,7 +192,17 @@ class TTrain {
 // types
     typedef void( *command_handler )( TTrain *Train, command_data const &Command );
     typedef std::unordered_map<user_command, command_handler> commandhandler_map;
+    // named source of single train state value
+    struct state_field {
+
+        std::string name;
+        std::function<dictionary_value( TTrain & )> value;
+    };
 // methods
+    // returns sources of state values with fixed names, shared by all trains
+    static std::vector<state_field> const &state_fields();
+    // resolves declared state fields of specified screen into fixed layout
+    static void compile_state_layout( screen_entry &Screen );
     // clears state of all cabin controls
     void clear_cab_controls();
     // sets cabin controls based on current state of the vehicle
@@ -861,6 +886,8 @@ private:
     bool point_inside( Math3D::vector3 const Point ) const;
     Math3D::vector3 clamp_inside( Math3D::vector3 const &Point ) const;
     const screenentry_sequence & get_screens();
+    // screens of the cab, without triggering their update
+    inline screenentry_sequence const &screens() const { return m_screens; };
 
 	float get_tacho();
 	float get_tank_pressure();
@@ -21,6 +21,7 @@ http://mozilla.org/MPL/2.0/.
 #include "DynObj.h"
 #include "Driver.h"
 #include "Logs.h"
+#include "sn_utils.h"
 
 TTrackFollower::~TTrackFollower()
 {
@@ -44,6 +45,51 @@ void TTrackFollower::Reset()
 	fDirection = 1.0;
 }
 
+// sends placement on the track to provided stream
+void TTrackFollower::serialize_state( std::ostream &Output ) const
+{
+    sn_utils::s_str( Output, ( pCurrentTrack != nullptr ? pCurrentTrack->name() : "" ) );
+    sn_utils::ls_float64( Output, fCurrentDistance );
+    sn_utils::ls_float64( Output, fDirection );
+    sn_utils::ls_float64( Output, fOffsetH );
+    sn_utils::ls_int32( Output, iSegment );
+    sn_utils::ls_int32( Output, iEventFlag );
+    sn_utils::ls_int32( Output, iEventallFlag );
+}
+
+// restores placement on the track from provided stream. returns: true on success
+bool TTrackFollower::deserialize_state( std::istream &Input )
+{
+    auto const trackname { sn_utils::d_str( Input ) };
+    fCurrentDistance = sn_utils::ld_float64( Input );
+    fDirection = sn_utils::ld_float64( Input );
+    fOffsetH = sn_utils::ld_float64( Input );
+    iSegment = sn_utils::ld_int32( Input );
+    iEventFlag = sn_utils::ld_int32( Input );
+    iEventallFlag = sn_utils::ld_int32( Input );
+
+    // NOTE: tracks created on the fly for derailed vehicles are unnamed and can't be restored
+    auto *track { simulation::Paths.find( trackname ) };
+    if( track == nullptr ) {
+        ErrorLog( "Bad state: vehicle \"" + Owner->name() + "\" placed on unknown track \"" + trackname + "\"" );
+        return false;
+    }
+    if( track != pCurrentTrack ) {
+        // move the axle without going through SetCurrentTrack(), switch states are restored separately
+        track->AxleCounter( +1, Owner );
+        if( pCurrentTrack != nullptr ) {
+            pCurrentTrack->AxleCounter( -1, Owner );
+        }
+        pCurrentTrack = track;
+    }
+    if( ( pCurrentTrack->eType == tt_Cross )
+     && ( iSegment != 0 ) ) {
+        pCurrentTrack->SwitchForced( std::abs( iSegment ) - 1, nullptr );
+    }
+    pCurrentSegment = pCurrentTrack->CurrentSegment();
+    return ComputatePosition();
+}
+
 TTrack * TTrackFollower::SetCurrentTrack(TTrack *pTrack, int end)
 { // przejechanie na inny odcinkek toru, z ewentualnym rozpruciem
     if (pTrack)
@@ -42,6 +42,10 @@ public:
     bool Init(TTrack *pTrack, TDynamicObject *NewOwner, double fDir);
 	void Reset();
     void Render(float fNr);
+    // sends placement on the track to provided stream
+    void serialize_state( std::ostream &Output ) const;
+    // restores placement on the track from provided stream. returns: true on success
+    bool deserialize_state( std::istream &Input );
 // members
     double fOffsetH = 0.0; // Ra: odległość środka osi od osi toru (dla samochodów) - użyć do wężykowania
     Math3D::vector3 pPosition; // współrzędne XYZ w układzie scenerii
@@ -323,6 +323,19 @@ eu07_application::run() {
 				// if we're slave
 				if (m_network && m_network->client)
 				{
+					// fresh client starts from the simulation state sent ahead of the frames
+					if (auto const keyframe = m_network->client->pop_keyframe()) {
+						std::istringstream state(*keyframe);
+						if (simulation::State.deserialize_state(state)
+						 && m_modes[m_modestack.top()]->deserialize_state(state)) {
+							WriteLog("net: simulation state restored", logtype::net);
+						}
+						else {
+							ErrorLog("net: failed to restore simulation state", logtype::net);
+							m_network->client->reject_keyframe();
+						}
+					}
+
 					// fetch frame info from network layer,
 					auto frame_info = m_network->client->get_next_delta(MAX_NETWORK_PER_FRAME - loop_remaining);
 
@@ -365,6 +378,14 @@ eu07_application::run() {
 					double delta = Timer::GetDeltaTime();
 					double render = Timer::GetDeltaRenderTime();
 					m_network->servers->push_delta(render, delta, sync, commands_to_exec);
+
+					// periodically store complete simulation state, so clients joining later and session replays don't have to go through everything
+					if (m_network->servers->keyframe_due()) {
+						std::ostringstream state;
+						simulation::State.serialize_state(state);
+						m_modes[m_modestack.top()]->serialize_state(state);
+						m_network->servers->push_keyframe(state.str());
+					}
 				}
 
 				// if we're slave
@@ -441,13 +462,7 @@ eu07_application::run() {
 bool
 eu07_application::request( python_taskqueue::task_request const &Task ) {
 
-    auto const result { m_taskqueue.insert( Task ) };
-    if( ( false == result )
-     && ( Task.input != nullptr ) ) {
-        // clean up allocated resources since the worker won't
-        delete Task.input;
-    }
-    return result;
+    return m_taskqueue.insert( Task );
 }
 
 // ensures the main thread holds the python gil and can safely execute python calls
@@ -1004,18 +1019,7 @@ eu07_application::init_audio() {
 int
 eu07_application::init_data() {
 
-    // HACK: grab content of the first {} block in load_unit_weights using temporary parser, then parse it normally. on any error our weight list will be empty string
-    auto loadweights { cParser( cParser( "data/load_weights.txt", cParser::buffer_FILE ).getToken<std::string>( true, "{}" ), cParser::buffer_TEXT ) };
-    while( true == loadweights.getTokens( 2 ) ) {
-        std::pair<std::string, float> weightpair;
-        loadweights
-            >> weightpair.first
-            >> weightpair.second;
-        weightpair.first.erase( weightpair.first.end() - 1 ); // trim trailing ':' from the key
-        simulation::Weights.emplace( weightpair.first, weightpair.second );
-    }
-    cParser override_parser( "data/sound_overrides.txt", cParser::buffer_FILE );
-    deserialize_map( simulation::Sound_overrides,  override_parser);
+    simulation::State.init_data();
 
     return 0;
 }
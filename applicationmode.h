@@ -76,6 +76,15 @@ public:
     virtual
 	bool
 	    is_command_processor() const = 0;
+    // sends mode-specific state required to resume the simulation to provided stream
+    virtual
+    void
+        serialize_state( std::ostream &Output ) const {}
+    // restores mode-specific simulation state from provided stream. returns: true on success
+    virtual
+    bool
+        deserialize_state( std::istream &Input ) {
+            return true; }
 
 protected:
 // members
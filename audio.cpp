@@ -43,6 +43,7 @@ openal_buffer::openal_buffer( std::string const &Filename ) :
 	sf_close(sf);
 
 	rate = si.samplerate;
+	duration = ( rate > 0 ? static_cast<float>( si.frames ) / rate : 0.f );
 
 	if (si.channels != 1)
 		WriteLog("sound: warning: mixing multichannel file to mono");
@@ -26,6 +26,7 @@ struct openal_buffer {
 // members
     ALuint id { null_resource }; // associated AL resource
     unsigned int rate {}; // sample rate of the data
+    float duration {}; // length of the sample, in seconds
     std::string name;
     std::string caption;
 // constructors
@@ -25,6 +25,8 @@ bool event_volume_change { false };
 
 float const EU07_SOUND_CUTOFFRANGE { 3000.f }; // 2750 m = max expected emitter spawn range, plus safety margin
 float const EU07_SOUND_VELOCITYLIMIT { 250 / 3.6f }; // 343 m/sec ~= speed of sound; arbitrary limit of 250 km/h
+float const EU07_SOUND_ROLLOFFFACTOR { 1.75f };
+float const EU07_SOUND_VOICEHYSTERESIS { 1.25f }; // audibility bonus for emitters with implementation-side source, reduces swaps between emitters of similar loudness
 
 // potentially clamps length of provided vector to 343 meters
 // TBD: make a generic method for utilities out of this
@@ -43,7 +45,11 @@ limit_velocity( glm::vec3 const &Velocity ) {
 void
 openal_source::play() {
 
-    if( id == audio::null_resource ) { return; } // no implementation-side source to match, no point
+    if( id == audio::null_resource ) {
+        // virtual emitter, the playback is tracked until implementation-side source is assigned
+        is_playing = true;
+        return;
+    }
 
     ::alSourcePlay( id );
 
@@ -56,7 +62,12 @@ openal_source::play() {
 void
 openal_source::stop() {
 
-    if( id == audio::null_resource ) { return; } // no implementation-side source to match, no point
+    if( id == audio::null_resource ) {
+        // virtual emitter, there's only tracked state to update
+        is_looping = false;
+        is_playing = false;
+        return;
+    }
 
     loop( false );
     // NOTE: workaround for potential edge cases where ::alSourceStop() doesn't set source which wasn't yet started to AL_STOPPED
@@ -94,6 +105,10 @@ openal_source::update( double const Deltatime, glm::vec3 const &Listenervelocity
         while( ( sound_index > 0 )
             && ( sounds.size() > 1 ) ) {
             ::alSourceUnqueueBuffers( id, 1, &discard );
+            // keep the tracked buffer sequence in step, in case the emitter gets virtualized later
+            if( false == buffers.empty() ) {
+                buffers.erase( std::begin( buffers ) );
+            }
             sounds.erase( std::begin( sounds ) );
             --sound_index;
             sound_change = true;
@@ -117,20 +132,57 @@ openal_source::update( double const Deltatime, glm::vec3 const &Listenervelocity
         ::alGetSourcei( id, AL_SOURCE_STATE, &state );
         is_playing = ( state == AL_PLAYING );
     }
+    else {
+        update_virtual( Deltatime );
+    }
 
     // request instructions from the controller
     controller->update( *this );
 }
 
+// advances tracked playback position of an emitter without implementation-side source
+void
+openal_source::update_virtual( double const Deltatime ) {
+
+    sound_change = false;
+    if( false == is_playing ) { return; }
+
+    play_offset += static_cast<float>( Deltatime ) * clamp( properties.pitch * pitch_variation, 0.1f, 10.f );
+    // mimic behaviour of the implementation-side source: multipart sounds drop finished samples until only one remains,
+    // which can be looping or play until its end
+    while( true == is_playing ) {
+        auto const duration { (
+            buffers.empty() ?
+                0.f :
+                renderer.buffer( buffers.front() ).duration ) };
+        if( play_offset < duration ) { break; }
+
+        if( ( buffers.size() > 1 )
+         && ( sounds.size() > 1 ) ) {
+            play_offset -= duration;
+            buffers.erase( std::begin( buffers ) );
+            sounds.erase( std::begin( sounds ) );
+            sound_change = true;
+            // potentially adjust starting point of the last buffer, same as with implementation-side source
+            if( ( controller->start() > 0.f ) && ( buffers.size() == 1 ) ) {
+                play_offset = controller->start() * renderer.buffer( buffers.front() ).duration;
+            }
+        }
+        else if( ( true == is_looping ) && ( duration > 0.f ) ) {
+            play_offset = std::fmod( play_offset, duration );
+        }
+        else {
+            // reached end of the last sample
+            is_playing = false;
+            sound_index = static_cast<int>( sounds.size() );
+        }
+    }
+}
+
 // configures state of the source to match the provided set of properties
 void
 openal_source::sync_with( sound_properties const &State ) {
 
-    if( id == audio::null_resource ) {
-        // no implementation-side source to match, return sync error so the controller can clean up on its end
-        sync = sync_state::bad_resource;
-        return;
-    }
     // velocity
     if( ( update_deltatime > 0.0 )
      && ( sound_range >= 0 )
@@ -138,8 +190,6 @@ openal_source::sync_with( sound_properties const &State ) {
         // after sound position was initialized we can start velocity calculations
         sound_velocity = limit_velocity( ( State.location - properties.location ) / update_deltatime );
     }
-    // NOTE: velocity at this point can be either listener velocity for global sounds, actual sound velocity, or 0 if sound position is yet unknown
-    ::alSourcefv( id, AL_VELOCITY, glm::value_ptr( sound_velocity ) );
 
     // location
     sound_distance = State.location - renderer.cached_camerapos;
@@ -156,13 +206,6 @@ openal_source::sync_with( sound_properties const &State ) {
             return;
         }
     }
-    if( sound_range >= 0 ) {
-        ::alSourcefv( id, AL_POSITION, glm::value_ptr( sound_distance ) );
-    }
-    else {
-        // sounds with 'unlimited' or negative range are positioned on top of the listener
-        ::alSourcefv( id, AL_POSITION, glm::value_ptr( glm::vec3() ) );
-    }
     // gain
     auto const gain {
         State.gain
@@ -171,6 +214,52 @@ openal_source::sync_with( sound_properties const &State ) {
             State.category == sound_category::local ? Global.EnvironmentPositionalVolume :
             State.category == sound_category::ambient ? Global.EnvironmentAmbientVolume :
             1.f ) };
+    auto const rangesquared { sound_range * sound_range };
+    auto const distancesquared { glm::length2( sound_distance ) };
+    // if the emitter is outside of its nominal hearing range the volume is reduced to a suitable fraction of nominal value
+    auto const fadedistance { sound_range * 0.75f };
+    auto const rangefactor { (
+        sound_range != -1 ?
+            interpolate(
+                1.f, 0.f,
+                clamp<float>(
+                    ( distancesquared - rangesquared ) / ( fadedistance * fadedistance ),
+                    0.f, 1.f ) ) :
+            1.f ) };
+    // estimate how loud the emitter is at the listener location, to determine which emitters get implementation-side sources
+    if( sound_range >= 0 ) {
+        // approximation of the inverse distance clamped model used by the implementation
+        auto const referencedistance { std::max( 0.01f, sound_range * ( 1.f / 16.f ) * State.soundproofing ) };
+        auto const distance { std::sqrt( distancesquared ) };
+        auto const attenuation {
+            referencedistance
+            / ( referencedistance + EU07_SOUND_ROLLOFFFACTOR * std::max( 0.f, distance - referencedistance ) ) };
+        audibility =
+            gain * rangefactor * attenuation
+            * ( is_multipart ? 2.f : 1.f ); // multi-part sounds are more noticeable when restarted
+    }
+    else {
+        // sounds with 'unlimited' or negative range are positioned on top of the listener
+        audibility = std::numeric_limits<float>::max();
+    }
+
+    if( id == audio::null_resource ) {
+        // virtual emitter, there's no implementation-side source to configure
+        properties = State;
+        is_in_range = ( distancesquared <= rangesquared );
+        sync = sync_state::good;
+        return;
+    }
+
+    // NOTE: velocity at this point can be either listener velocity for global sounds, actual sound velocity, or 0 if sound position is yet unknown
+    ::alSourcefv( id, AL_VELOCITY, glm::value_ptr( sound_velocity ) );
+    if( sound_range >= 0 ) {
+        ::alSourcefv( id, AL_POSITION, glm::value_ptr( sound_distance ) );
+    }
+    else {
+        // sounds with 'unlimited' or negative range are positioned on top of the listener
+        ::alSourcefv( id, AL_POSITION, glm::value_ptr( glm::vec3() ) );
+    }
     if( ( State.gain != properties.gain )
      || ( State.soundproofing_stamp != properties.soundproofing_stamp )
      || ( audio::event_volume_change ) ) {
@@ -183,19 +272,10 @@ openal_source::sync_with( sound_properties const &State ) {
         ::alSourcef( id, AL_REFERENCE_DISTANCE, range * ( 1.f / 16.f ) * State.soundproofing );
     }
     if( sound_range != -1 ) {
-        auto const rangesquared { sound_range * sound_range };
-        auto const distancesquared { glm::length2( sound_distance ) };
         if( ( distancesquared > rangesquared )
          || ( false == is_in_range ) ) {
             // if the emitter is outside of its nominal hearing range or was outside of it during last check
             // adjust the volume to a suitable fraction of nominal value
-            auto const fadedistance { sound_range * 0.75f };
-            auto const rangefactor {
-                interpolate(
-                    1.f, 0.f,
-                    clamp<float>(
-                        ( distancesquared - rangesquared ) / ( fadedistance * fadedistance ),
-                        0.f, 1.f ) ) };
             ::alSourcef( id, AL_GAIN, gain * rangefactor );
         }
         is_in_range = ( distancesquared <= rangesquared );
@@ -224,7 +304,7 @@ openal_source::range( float const Range ) {
             Range :
             5 ) }; // range of -1 means sound of unlimited range, positioned at the listener
     ::alSourcef( id, AL_REFERENCE_DISTANCE, range * ( 1.f / 16.f ) );
-    ::alSourcef( id, AL_ROLLOFF_FACTOR, 1.75f );
+    ::alSourcef( id, AL_ROLLOFF_FACTOR, EU07_SOUND_ROLLOFFFACTOR );
 }
 
 // sets modifier applied to the pitch of sounds emitted by the source
@@ -240,10 +320,11 @@ openal_source::pitch( float const Pitch ) {
 void
 openal_source::loop( bool const State ) {
 
-    if( id == audio::null_resource ) { return; } // no implementation-side source to match, no point
     if( is_looping == State ) { return; }
 
     is_looping = State;
+
+    if( id == audio::null_resource ) { return; } // no implementation-side source to match, no point
     ::alSourcei(
         id,
         AL_LOOPING,
@@ -274,6 +355,67 @@ openal_source::clear() {
     id = sourceid;
 }
 
+// binds provided implementation-side source to the emitter and resumes playback from the tracked point
+void
+openal_source::realize( ALuint const Source ) {
+
+    if( id != audio::null_resource ) { return; } // already bound, no point
+    if( Source == audio::null_resource ) { return; }
+
+    id = Source;
+    // queue remaining buffers
+    std::vector<ALuint> bufferids;
+    for( auto const bufferhandle : buffers ) {
+        auto const &buffer { audio::renderer.buffer( bufferhandle ) };
+        if( buffer.id != audio::null_resource ) {
+            bufferids.emplace_back( buffer.id );
+        }
+    }
+    ::alSourceQueueBuffers( id, static_cast<ALsizei>( bufferids.size() ), bufferids.data() );
+    ::alSourcei( id, AL_LOOPING, ( is_looping ? AL_TRUE : AL_FALSE ) );
+    range( sound_range );
+    // invalidate cached properties to enforce full sync of the source
+    auto const state { properties };
+    properties.gain = -1.f;
+    properties.pitch = -1.f;
+    properties.soundproofing_stamp = ~( std::uintptr_t{ 0 } ) - 1;
+    is_in_range = false;
+    sync_with( state );
+    if( ( sync != sync_state::good )
+     || ( false == is_playing ) ) {
+        return;
+    }
+    // resume the playback from the tracked point
+    ::alSourcef( id, AL_SEC_OFFSET, play_offset );
+    ::alSourcePlay( id );
+}
+
+// releases implementation-side source, while keeping track of the playback state. returns: released source
+ALuint
+openal_source::virtualize() {
+
+    if( id == audio::null_resource ) { return audio::null_resource; } // nothing to release
+
+    // retrieve current playback point...
+    play_offset = 0.f;
+    if( true == is_playing ) {
+        ALfloat offset;
+        ::alGetSourcef( id, AL_SEC_OFFSET, &offset );
+        // the offset is measured from the start of the queue, which can still hold buffers processed since the last update.
+        // walk it through the tracked buffer sequence so the position lands within the sample actually playing
+        play_offset = std::max( offset, 0.f );
+        update_virtual( 0.0 );
+    }
+    // ...then release the source along with its buffers
+    ::alSourceStop( id );
+    ::alSourcei( id, AL_LOOPING, AL_FALSE );
+    ::alSourcei( id, AL_BUFFER, 0 );
+
+    auto const sourceid { id };
+    id = audio::null_resource;
+    return sourceid;
+}
+
 
 
 openal_renderer::~openal_renderer() {
@@ -415,10 +557,26 @@ openal_renderer::update( double const Deltatime ) {
     }
 
     // update active emitters
+    m_voicestats.updates = 0;
+    m_voicestats.skips = 0;
+    m_voicestats.band_updates.fill( 0 );
     auto source { std::begin( m_sources ) };
     while( source != std::end( m_sources ) ) {
+        // distant emitters are updated at reduced rate, with time accumulated for their next update
+        source->update_elapsed += Deltatime;
+        if( source->update_countdown > 0 ) {
+            --( source->update_countdown );
+            ++m_voicestats.skips;
+            ++source;
+            continue;
+        }
         // update each source
-        source->update( Deltatime, m_listenervelocity );
+        source->update( source->update_elapsed, m_listenervelocity );
+        source->update_elapsed = 0.0;
+        auto const band { update_band( *source ) };
+        source->update_countdown = ( 1 << band ) - 1;
+        ++m_voicestats.updates;
+        ++m_voicestats.band_updates[ band ];
         // if after the update the source isn't playing, put it away on the spare stack, it's done
         if( false == source->is_playing ) {
             source->clear();
@@ -433,6 +591,8 @@ openal_renderer::update( double const Deltatime ) {
             ++source;
         }
     }
+    // pick emitters which get to be heard
+    update_voices();
 
     // reset potentially used volume change flag
     audio::event_volume_change = false;
@@ -444,60 +604,33 @@ openal_renderer::update( double const Deltatime ) {
 	}
 }
 
+// returns distance band of specified emitter; emitters in band n are updated every 2^n renderer updates
+int
+openal_renderer::update_band( audio::openal_source const &Source ) const {
+
+    if( ( false == Source.is_playing )
+     || ( Source.sound_range <= 0.f ) ) {
+        // emitters which are about to start or end, and sounds positioned at the listener, are kept up to date
+        return 0;
+    }
+    auto const distanceratio { glm::length( Source.sound_distance ) / Source.sound_range };
+    return (
+        distanceratio < 1.5f ? 0 : // within audible range or close to it
+        distanceratio < 3.0f ? 1 :
+        distanceratio < 5.0f ? 2 :
+        3 ); // barely audible, if at all
+}
+
 // returns an instance of implementation-side part of the sound emitter
 audio::openal_source
 openal_renderer::fetch_source() {
 
     audio::openal_source newsource;
-    if( false == m_sourcespares.empty() ) {
-        // reuse (a copy of) already allocated source
-        newsource.id = m_sourcespares.top();
-        m_sourcespares.pop();
-    }
-    if( newsource.id == audio::null_resource ) {
-        // if there's no source to reuse, try to generate a new one
-        ::alGenSources( 1, &( newsource.id ) );
-    }
-    if( newsource.id == audio::null_resource ) {
-		alGetError();
-        // if we still don't have a working source, see if we can sacrifice an already active one
-        // under presumption it's more important to play new sounds than keep the old ones going
-        // TBD, TODO: for better results we could use range and/or position for the new sound
-        // to better weight whether the new sound is really more important
-        auto leastimportantsource { std::end( m_sources ) };
-        auto leastimportantweight { std::numeric_limits<float>::max() };
-
-        for( auto source { std::begin( m_sources ) }; source != std::cend( m_sources ); ++source ) {
-
-            if( ( source->id == audio::null_resource )
-             || ( true == source->is_multipart )
-             || ( false == source->is_playing ) ) {
-
-                continue;
-            }
-            auto const sourceweight { (
-                source->sound_range != -1 ?
-                    ( source->sound_range * source->sound_range ) / ( glm::length2( source->sound_distance ) + 1 ) :
-                    std::numeric_limits<float>::max() ) };
-            if( sourceweight < leastimportantweight ) {
-                leastimportantsource = source;
-                leastimportantweight = sourceweight;
-            }
-        }
-        if( ( leastimportantsource != std::end( m_sources ) )
-         && ( leastimportantweight < 1.f ) ) {
-            // only accept the candidate if it's outside of its nominal hearing range
-            leastimportantsource->stop();
-            // HACK: dt of 0 is a roundabout way to notify the controller its emitter has stopped
-            leastimportantsource->update( 0, m_listenervelocity );
-            leastimportantsource->clear();
-            // we should be now free to grab the id and get rid of the remains
-            newsource.id = leastimportantsource->id;
-            m_sources.erase( leastimportantsource );
-        }
-    }
+    // if we're out of implementation-side sources the emitter starts as virtual one,
+    // it can get promoted during next update if it's audible enough
+    newsource.id = fetch_source_id();
 
-    if( newsource.id == audio::null_resource ) {
+    if( newsource.id != audio::null_resource ) {
         // for sources with functional emitter reset emitter parameters from potential last use
         ::alSourcef( newsource.id, AL_PITCH, 1.f );
         ::alSourcef( newsource.id, AL_GAIN, 1.f );
@@ -508,6 +641,71 @@ openal_renderer::fetch_source() {
     return newsource;
 }
 
+// returns id of an implementation-side source, or null_resource if the source limit was reached
+ALuint
+openal_renderer::fetch_source_id() {
+
+    if( false == m_sourcespares.empty() ) {
+        // reuse already allocated source
+        auto const sourceid { m_sourcespares.top() };
+        m_sourcespares.pop();
+        return sourceid;
+    }
+    if( m_sourcecount >= m_sourcelimit ) {
+        return audio::null_resource;
+    }
+    // if there's no source to reuse, try to generate a new one
+    ALuint sourceid { audio::null_resource };
+    ::alGenSources( 1, &sourceid );
+    if( ( ::alGetError() != AL_NO_ERROR )
+     || ( sourceid == audio::null_resource ) ) {
+        // the implementation ran out of sources, don't bother asking for more
+        m_sourcelimit = m_sourcecount;
+        WriteLog( "sound: source limit reached at " + std::to_string( m_sourcelimit ) + " sources" );
+        return audio::null_resource;
+    }
+    ++m_sourcecount;
+    return sourceid;
+}
+
+// assigns implementation-side sources to the most audible emitters, the rest is tracked virtually
+void
+openal_renderer::update_voices() {
+
+    m_voices.clear();
+    for( auto &source : m_sources ) {
+        m_voices.emplace_back( &source );
+    }
+    auto const voicecount { std::min( m_voices.size(), m_sourcelimit ) };
+    // arrange emitters from the most to the least audible, we only care about the cutoff point
+    std::nth_element(
+        std::begin( m_voices ), std::begin( m_voices ) + voicecount, std::end( m_voices ),
+        []( audio::openal_source const *Left, audio::openal_source const *Right ) {
+            auto const leftweight { Left->audibility * ( Left->is_virtual() ? 1.f : EU07_SOUND_VOICEHYSTERESIS ) };
+            auto const rightweight { Right->audibility * ( Right->is_virtual() ? 1.f : EU07_SOUND_VOICEHYSTERESIS ) };
+            return leftweight > rightweight; } );
+
+    m_voicestats.swaps = 0;
+    // release sources of emitters which didn't make the cut...
+    for( auto voice { std::begin( m_voices ) + voicecount }; voice != std::end( m_voices ); ++voice ) {
+        if( true == ( *voice )->is_virtual() ) { continue; }
+        m_sourcespares.push( ( *voice )->virtualize() );
+        ++m_voicestats.swaps;
+    }
+    // ...and pass them to the ones which did
+    m_voicestats.real = 0;
+    for( auto voice { std::begin( m_voices ) }; voice != std::begin( m_voices ) + voicecount; ++voice ) {
+        if( true == ( *voice )->is_virtual() ) {
+            auto const sourceid { fetch_source_id() };
+            if( sourceid == audio::null_resource ) { continue; }
+            ( *voice )->realize( sourceid );
+            ++m_voicestats.swaps;
+        }
+        ++m_voicestats.real;
+    }
+    m_voicestats.virtualized = m_voices.size() - m_voicestats.real;
+}
+
 bool
 openal_renderer::init_caps() {
 
@@ -549,6 +747,7 @@ openal_renderer::init_caps() {
     WriteLog( "Supported extensions: " + std::string{ (char *)::alcGetString( m_device, ALC_EXTENSIONS ) } );
 
 	ALCint attr[3] = { ALC_MONO_SOURCES, Global.audio_max_sources, 0 }; // request more sounds
+    m_sourcelimit = std::max( 1, Global.audio_max_sources );
 
     m_context = ::alcCreateContext( m_device, attr );
     if( m_context == nullptr ) {
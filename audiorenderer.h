@@ -58,7 +58,7 @@ struct openal_source {
     ALuint id { audio::null_resource }; // associated AL resource
     sound_source *controller { nullptr }; // source controller 
     uint32_sequence sounds; // 
-//    buffer_sequence buffers; // sequence of samples the source will emit
+    buffer_sequence buffers; // sequence of samples the source will emit
     int sound_index { 0 }; // currently queued sample from the buffer sequence
     bool sound_change { false }; // indicates currently queued sample has changed
     bool is_playing { false };
@@ -96,8 +96,22 @@ struct openal_source {
     // NOTE: doesn't release allocated implementation-side source
     void
         clear();
+    // binds provided implementation-side source to the emitter and resumes playback from the tracked point
+    void
+        realize( ALuint const Source );
+    // releases implementation-side source, while keeping track of the playback state. returns: released source
+    ALuint
+        virtualize();
+    // returns true if the emitter doesn't have an implementation-side source
+    bool
+        is_virtual() const {
+            return id == audio::null_resource; }
 
 private:
+// methods
+    // advances tracked playback position of an emitter without implementation-side source
+    void
+        update_virtual( double const Deltatime );
 // members
     double update_deltatime { 0.0 }; // time delta of most current update
     float pitch_variation { 1.f }; // emitter-specific variation of the base pitch
@@ -106,6 +120,10 @@ private:
     glm::vec3 sound_velocity { 0.f }; // sound movement vector
     bool is_in_range { false }; // helper, indicates the source was recently within audible range
     bool is_multipart { false }; // multi-part sounds are kept alive at longer ranges
+    float play_offset { 0.f }; // playback point within the currently active sample, in seconds. tracked only for virtual emitters
+    float audibility { 0.f }; // estimated loudness of the emitter at the listener location
+    double update_elapsed { 0.0 }; // time since last update, accumulated while the emitter sits out scheduled updates
+    int update_countdown { 0 }; // number of upcoming renderer updates the emitter will sit out
 };
 
 
@@ -115,6 +133,15 @@ class openal_renderer {
     friend opengl_renderer;
 
 public:
+// types
+    struct voice_statistics {
+        std::size_t real { 0 }; // emitters with implementation-side source
+        std::size_t virtualized { 0 }; // emitters tracked without implementation-side source
+        std::size_t swaps { 0 }; // emitters which gained or lost implementation-side source during last update
+        std::size_t updates { 0 }; // emitters updated during last update
+        std::size_t skips { 0 }; // emitters which sat out last update due to their distance from the listener
+        std::array<std::size_t, 4> band_updates {}; // emitters updated during last update, by distance band: every frame, every 2nd, 4th and 8th frame
+    };
 // constructors
     openal_renderer() = default;
 // destructor
@@ -142,6 +169,10 @@ public:
     // updates state of all active emitters
     void
         update( double const Deltatime );
+    // provides statistics of the emitter pool
+    voice_statistics const &
+        voice_stats() const {
+            return m_voicestats; }
 
     glm::dvec3 cached_camerapos;
 
@@ -155,6 +186,15 @@ private:
     // returns an instance of implementation-side part of the sound emitter
     audio::openal_source
         fetch_source();
+    // returns id of an implementation-side source, or null_resource if the source limit was reached
+    ALuint
+        fetch_source_id();
+    // assigns implementation-side sources to the most audible emitters, the rest is tracked virtually
+    void
+        update_voices();
+    // returns distance band of specified emitter; emitters in band n are updated every 2^n renderer updates
+    int
+        update_band( audio::openal_source const &Source ) const;
 // members
     ALCdevice * m_device { nullptr };
     ALCcontext * m_context { nullptr };
@@ -168,9 +208,12 @@ private:
     int m_activecab{ 0 };
 
     buffer_manager m_buffers;
-    // TBD: list of sources as vector, sorted by distance, for openal implementations with limited number of active sources?
     source_list m_sources;
     source_sequence m_sourcespares; // already created and currently unused sound sources
+    std::size_t m_sourcecount { 0 }; // number of created implementation-side sources
+    std::size_t m_sourcelimit { 0 }; // max number of implementation-side sources
+    std::vector<audio::openal_source *> m_voices; // scratchpad for emitter ranking
+    voice_statistics m_voicestats;
 
 	void (*alDeferUpdatesSOFT)() = nullptr;
 	void (*alProcessUpdatesSOFT)() = nullptr;
@@ -8,29 +8,37 @@ openal_source::bind( sound_source *Controller, uint32_sequence Sounds, Iterator_
     controller = Controller;
     sounds = Sounds;
     // look up and queue assigned buffers
-    std::vector<ALuint> buffers;
+    std::vector<ALuint> bufferids;
     std::for_each(
         First, Last,
         [&]( audio::buffer_handle const &bufferhandle ) {
+            buffers.emplace_back( bufferhandle );
             auto const &buffer { audio::renderer.buffer( bufferhandle ) };
-			if (buffer.id != null_resource) buffers.emplace_back( buffer.id ); } );
+			if (buffer.id != null_resource) bufferids.emplace_back( buffer.id ); } );
 
-    is_multipart = ( buffers.size() > 1 );
+    is_multipart = ( bufferids.size() > 1 );
+    // virtual emitters track the starting point on their own, following the same rules as the implementation-side sources
+    if( ( false == buffers.empty() )
+     && ( controller->start() != 0.f )
+     && ( false == is_multipart )
+     && ( false == controller->is_bookend( buffers.front() ) ) ) {
+        play_offset = controller->start() * audio::renderer.buffer( buffers.front() ).duration;
+    }
 
     if( id != audio::null_resource ) {
-        ::alSourceQueueBuffers( id, static_cast<ALsizei>( buffers.size() ), buffers.data() );
+        ::alSourceQueueBuffers( id, static_cast<ALsizei>( bufferids.size() ), bufferids.data() );
         ::alSourceRewind( id );
         // sound controller can potentially request playback to start from certain buffer point
         // for multipart sounds the offset is applied only to last piece during playback
         // for single sound we also make sure not to apply the offset to optional bookends
-        if( controller->start() == 0.f || is_multipart || controller->is_bookend( buffers.front() ) ) {
+        if( controller->start() == 0.f || is_multipart || controller->is_bookend( bufferids.front() ) ) {
             // regular case with no offset, reset bound source just in case
             ::alSourcei( id, AL_SAMPLE_OFFSET, 0 );
         }
         else {
             // move playback start to specified point in 0-1 range
             ALint buffersize;
-            ::alGetBufferi( buffers.front(), AL_SIZE, &buffersize );
+            ::alGetBufferi( bufferids.front(), AL_SIZE, &buffersize );
             ::alSourcei(
                 id,
                 AL_SAMPLE_OFFSET,
@@ -404,6 +404,10 @@ public:
     // generates active continuous commands
     void
         update();
+    // returns true if any continuous command is currently held
+    bool
+        is_continuous_active() const {
+            return ( false == m_active_continuous.empty() ); }
     // checks if given command must be scheduled on server
 	bool
 	    is_network_target(const uint32_t Recipient);
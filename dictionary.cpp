@@ -48,3 +48,31 @@ dictionary_source::dictionary_source( std::string const &Input ) {
         }
     }
 }
+
+// returns value stored under specified key, if any. lists aren't included in the search
+std::optional<dictionary_value>
+dictionary_source::find( std::string const &Key ) const {
+
+    auto const lookup = [&]( auto const &Sequence ) -> std::optional<dictionary_value> {
+        // later entries take precedence, same as when the collection is converted to a python dictionary
+        for( auto entry { std::rbegin( Sequence ) }; entry != std::rend( Sequence ); ++entry ) {
+            if( entry->first == Key ) {
+                return dictionary_value{ entry->second };
+            }
+        }
+        return std::nullopt; };
+
+    // search in reverse order of conversion to a python dictionary, i.e. strings > bools > integers > floats > layout values
+    if( auto value { lookup( strings ) } )  { return value; }
+    if( auto value { lookup( bools ) } )    { return value; }
+    if( auto value { lookup( integers ) } ) { return value; }
+    if( auto value { lookup( floats ) } )   { return value; }
+    if( layout ) {
+        auto const key { std::find( std::begin( layout->keys ), std::end( layout->keys ), Key ) };
+        if( key != std::end( layout->keys ) ) {
+            return values[ std::distance( std::begin( layout->keys ), key ) ];
+        }
+    }
+
+    return std::nullopt;
+}
@@ -9,6 +9,15 @@ http://mozilla.org/MPL/2.0/.
 
 #pragma once
 
+// value of single dictionary entry
+using dictionary_value = std::variant<double, int, bool, std::string>;
+
+// fixed sequence of keys, resolved once by the producer of the data.
+// dictionaries sharing a layout carry only the values, consumers can map the keys once and reuse the mapping
+struct dictionary_layout {
+    std::vector<std::string> keys;
+};
+
 // collection of keyword-value pairs
 // NOTE: since our python dictionary operates on a few types, most of the class was hardcoded for simplicity
 struct dictionary_source {
@@ -21,6 +30,8 @@ struct dictionary_source {
     keyvaluepair_sequence<bool> bools;
     keyvaluepair_sequence<std::string> strings;
     keyvaluepair_sequence<std::vector<glm::vec2>> vec2_lists;
+    std::shared_ptr<dictionary_layout const> layout; // optional, compiled part of the collection
+    std::vector<dictionary_value> values; // values for keys of the layout, in the same order
 // constructors
     dictionary_source() = default;
     dictionary_source( std::string const &Input );
@@ -30,4 +41,6 @@ struct dictionary_source {
     inline void insert( std::string const &Key, bool const Value )        { bools.emplace_back( Key, Value ); }
     inline void insert( std::string const &Key, std::string const Value ) { strings.emplace_back( Key, Value ); }
     inline void insert( std::string const &Key, std::vector<glm::vec2> const Value ) { vec2_lists.emplace_back( Key, Value ); }
+    // returns value stored under specified key, if any. lists aren't included in the search
+    std::optional<dictionary_value> find( std::string const &Key ) const;
 };
@@ -29,6 +29,7 @@ http://mozilla.org/MPL/2.0/.
 #include "Timer.h"
 #include "renderer.h"
 #include "utilities.h"
+#include "sn_utils.h"
 #include "Logs.h"
 /*
 namespace input {
@@ -169,62 +170,61 @@ driver_mode::update() {
 
     simulation::State.update_clocks();
     simulation::State.update_scripting_interface();
+    simulation::State.update_models();
     simulation::Environment.update();
 
+    // interpolated vehicle placement is for presentation only, simulation works with the actual physics state
+    simulation::Vehicles.restore_render_state();
+
 	if (deltatime != 0.0)
 	{
         // jak pauza, to nie ma po co tego przeliczać
         simulation::Time.update( deltatime );
 
     // fixed step, simulation time based updates
-	//  m_primaryupdateaccumulator += dt; // unused for the time being
+		m_primaryupdateaccumulator += deltatime;
 		m_secondaryupdateaccumulator += deltatime;
-	/*
-		// NOTE: until we have no physics state interpolation during render, we need to rely on the old code,
-		// as doing fixed step calculations but flexible step render results in ugly mini jitter
+
 		// core routines (physics)
-		int updatecount = 0;
-		while( ( m_primaryupdateaccumulator >= m_primaryupdaterate )
-			 &&( updatecount < 20 ) ) {
-			// no more than 20 updates per single pass, to keep physics from hogging up all run time
-			Ground.Update( m_primaryupdaterate, 1 );
-			++updatecount;
-			m_primaryupdateaccumulator -= m_primaryupdaterate;
-		}
-	*/
-		int updatecount = 1;
-		if( deltatime > m_primaryupdaterate ) // normalnie 0.01s
-		{
-	/*
-			// NOTE: experimentally disabled physics update cap
-			auto const iterations = std::ceil(dt / m_primaryupdaterate);
-			updatecount = std::min( 20, static_cast<int>( iterations ) );
-	*/
-			updatecount = std::ceil( deltatime / m_primaryupdaterate );
-	/*
-			// NOTE: changing dt wrecks things further down the code. re-acquire proper value later or cleanup here
-			dt = dt / iterations; // Ra: fizykę lepiej by było przeliczać ze stałym krokiem
-	*/
+		auto updatecount { static_cast<int>( m_primaryupdateaccumulator / m_primaryupdaterate ) };
+		// no more than specified number of updates per single pass, to keep physics from hogging up all run time.
+		// accelerated time raises the limit, as it's expected to require more updates
+		auto const updatelimit { static_cast<int>( m_primaryupdatelimit * std::max( 1.0, Global.fTimeSpeed ) ) };
+		if( updatecount > updatelimit ) {
+			// remaining time stays in the accumulator and is simulated during next frames, so physics keeps in step with the clock.
+			// if it falls too far behind, all of it is simulated right away
+			auto const backlog { m_primaryupdateaccumulator - updatelimit * m_primaryupdaterate };
+			if( backlog > m_primarybackloglimit ) {
+				WriteLog( "Physics update fell " + to_string( backlog, 2 ) + " sec behind the simulation clock, catching up" );
+			}
+			else {
+				if( false == m_primaryupdatethrottled ) {
+					WriteLog( "Physics update limit of " + to_string( updatelimit ) + " steps per frame reached, carrying " + to_string( backlog, 2 ) + " sec over to next frames" );
+				}
+				updatecount = updatelimit;
+			}
 		}
-		auto const stepdeltatime { deltatime / updatecount };
-		// NOTE: updates are limited to 20, but dt is distributed over potentially many more iterations
-		// this means at count > 20 simulation and render are going to desync. is that right?
-		// NOTE: experimentally changing this to prevent the desync.
-		// TODO: test what happens if we hit more than 20 * 0.01 sec slices, i.e. less than 5 fps
+		m_primaryupdatethrottled = ( updatecount == updatelimit ) && ( m_primaryupdateaccumulator - updatecount * m_primaryupdaterate >= m_primaryupdaterate );
 		Timer::subsystem.sim_dynamics.start();
+		if( updatecount > 0 ) {
+			// physics state from before the update is the starting point of render interpolation
+			simulation::Vehicles.store_render_state();
+			m_primaryupdateaccumulator -= updatecount * m_primaryupdaterate;
+			m_primaryupdatebatch = updatecount;
+		}
 		if( true == Global.FullPhysics ) {
 			// mixed calculation mode, steps calculated in ~0.05s chunks
 			while( updatecount >= 5 ) {
-				simulation::State.update( stepdeltatime, 5 );
+				simulation::State.update( m_primaryupdaterate, 5 );
 				updatecount -= 5;
 			}
 			if( updatecount ) {
-				simulation::State.update( stepdeltatime, updatecount );
+				simulation::State.update( m_primaryupdaterate, updatecount );
 			}
 		}
-		else {
+		else if( updatecount ) {
 			// simplified calculation mode; faster but can lead to errors
-			simulation::State.update( stepdeltatime, updatecount );
+			simulation::State.update( m_primaryupdaterate, updatecount );
 		}
 		Timer::subsystem.sim_dynamics.stop();
 
@@ -285,6 +285,15 @@ driver_mode::update() {
     auto const deltarealtime = Timer::GetDeltaRenderTime(); // nie uwzględnia pauzowania ani mnożenia czasu
 	simulation::State.process_commands();
 
+	// vehicles are presented one physics step behind, interpolated between the two most recent physics states
+	// the render time lags the physics by one step, so it falls within the most recent batch of updates
+	if( m_primaryupdatebatch > 0 ) {
+		auto const batchduration { m_primaryupdatebatch * m_primaryupdaterate };
+		simulation::Vehicles.interpolate_render_state(
+			// NOTE: time carried over to next frames isn't covered by the batch, and the latest physics state is the best we can show
+			( batchduration - m_primaryupdaterate + std::min( m_primaryupdateaccumulator, m_primaryupdaterate ) ) / batchduration );
+	}
+
     // fixed step render time routines
 
     fTime50Hz += deltarealtime; // w pauzie też trzeba zliczać czas, bo przy dużym FPS będzie problem z odczytem ramek
@@ -501,6 +510,25 @@ driver_mode::is_command_processor() const {
     return true;
 }
 
+// sends mode-specific state required to resume the simulation to provided stream
+void
+driver_mode::serialize_state( std::ostream &Output ) const {
+
+    // fixed step routines pick up where they left off, otherwise the physics would run out of step with the source
+    sn_utils::ls_float64( Output, m_primaryupdateaccumulator );
+    sn_utils::ls_float64( Output, m_secondaryupdateaccumulator );
+}
+
+// restores mode-specific simulation state from provided stream. returns: true on success
+bool
+driver_mode::deserialize_state( std::istream &Input ) {
+
+    m_primaryupdateaccumulator = sn_utils::ld_float64( Input );
+    m_secondaryupdateaccumulator = sn_utils::ld_float64( Input );
+
+    return Input.good();
+}
+
 void
 driver_mode::update_camera( double const Deltatime ) {
 
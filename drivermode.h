@@ -56,6 +56,10 @@ public:
         on_event_poll() override;
     bool
         is_command_processor() const override;
+    void
+        serialize_state( std::ostream &Output ) const override;
+    bool
+        deserialize_state( std::istream &Input ) override;
 
 private:
 // types
@@ -120,7 +124,11 @@ private:
     double fTime50Hz { 0.0 }; // bufor czasu dla komunikacji z PoKeys
     double const m_primaryupdaterate { 1.0 / 100.0 };
     double const m_secondaryupdaterate { 1.0 / 50.0 };
-    double m_primaryupdateaccumulator { m_secondaryupdaterate }; // keeps track of elapsed simulation time, for core fixed step routines
+    int const m_primaryupdatelimit { 50 }; // max number of core fixed step updates per frame at regular time speed, time beyond it is carried over to next frames
+    double const m_primarybackloglimit { 1.0 }; // max amount of simulation time the physics can fall behind before it's forced to catch up, in seconds
+    double m_primaryupdateaccumulator { 0.0 }; // keeps track of elapsed simulation time, for core fixed step routines
+    int m_primaryupdatebatch { 0 }; // number of core fixed step updates performed in the most recent batch
+    bool m_primaryupdatethrottled { false }; // core fixed step updates are spread over multiple frames
     double m_secondaryupdateaccumulator { m_secondaryupdaterate }; // keeps track of elapsed simulation time, for less important fixed step routines
     int iPause { 0 }; // wykrywanie zmian w zapauzowaniu
 	command_relay m_relay;
@@ -29,6 +29,7 @@ http://mozilla.org/MPL/2.0/.
 #include "renderer.h"
 #include "utilities.h"
 #include "Logs.h"
+#include "lightarray.h"
 #include "widgets/vehicleparams.h"
 
 #define DRIVER_HINT_CONTENT
@@ -1242,13 +1243,14 @@ debug_panel::update_section_eventqueue( std::vector<text_line> &Output ) {
 
     // current event queue
     auto const time { Timer::GetTime() };
-    auto const *event { simulation::Events.begin() };
+    auto const queue { simulation::Events.queued() };
     auto const searchfilter { std::string( m_eventsearch.data() ) };
 
 	Output.emplace_back( "Delay:   Event:", Global.UITextColor );
 
-	while( ( event != nullptr )
-	    && ( Output.size() < 30 ) ) {
+    for( auto const *event : queue ) {
+
+        if( Output.size() >= 30 ) { break; }
 
 		if( ( false == event->m_ignored )
 		 && ( false == event->m_passive )
@@ -1259,7 +1261,6 @@ debug_panel::update_section_eventqueue( std::vector<text_line> &Output ) {
 
             if( ( false == searchfilter.empty() )
              && ( false == contains( label, searchfilter ) ) ) {
-                event = event->m_next;
                 continue;
             }
 
@@ -1271,12 +1272,11 @@ debug_panel::update_section_eventqueue( std::vector<text_line> &Output ) {
 
             Output.emplace_back( textline, Global.UITextColor );
         }
-        event = event->m_next;
     }
     if( Output.size() == 1 ) {
         // event queue can be empty either because no event got through active filters, or because it is genuinely empty
         Output.front().data = (
-            simulation::Events.begin() == nullptr ?
+            queue.empty() ?
                 "(no queued events)" :
                 "(no matching events)" );
     }
@@ -1322,6 +1322,15 @@ debug_panel::update_section_powergrid( std::vector<text_line> &Output ) {
 	if( Output.size() == 1 ) {
 		Output.front().data = "(no power stations)";
 	}
+    // pantograph wire searches
+    auto const &tractionstats { simulation::Region->traction_stats() };
+    textline =
+        "Wire searches: " + std::to_string( tractionstats.searches )
+        + ", tested pieces: " + std::to_string( tractionstats.candidates )
+        + ( tractionstats.searches > 0 ?
+            " (" + to_string( static_cast<double>( tractionstats.candidates ) / tractionstats.searches, 1 ) + " per search)" :
+            "" );
+    Output.emplace_back( textline, Global.UITextColor );
 }
 
 void
@@ -1389,6 +1398,12 @@ debug_panel::update_section_renderer( std::vector<text_line> &Output ) {
             // renderer stats
             Output.emplace_back( GfxRenderer->info_times(), Global.UITextColor );
             Output.emplace_back( GfxRenderer->info_stats(), Global.UITextColor );
+            // light source stats
+            Output.emplace_back(
+                "Vehicle lights: " + std::to_string( simulation::Lights.size() )
+                + ", active: " + std::to_string( simulation::Lights.active() )
+                + ", updated: " + std::to_string( simulation::Lights.updated() ),
+                Global.UITextColor );
 }
 
 bool
@@ -1441,6 +1456,14 @@ debug_panel::render_section_settings() {
     ImGui::PushStyleColor( ImGuiCol_Text, { Global.UITextColor.r, Global.UITextColor.g, Global.UITextColor.b, Global.UITextColor.a } );
     ImGui::TextUnformatted( "Sound" );
     ImGui::PopStyleColor();
+    // emitter pool state
+    auto const &voicestats { audio::renderer.voice_stats() };
+    ImGui::TextUnformatted(
+        ( "Voices: " + std::to_string( voicestats.real ) + " real, "
+        + std::to_string( voicestats.virtualized ) + " virtual, "
+        + std::to_string( voicestats.swaps ) + " swaps" ).c_str() );
+    ImGui::TextUnformatted(
+        ( "Emitter updates: " + std::to_string( voicestats.updates ) + ", deferred: " + std::to_string( voicestats.skips ) ).c_str() );
     // audio volume sliders
     ImGui::SliderFloat( ( to_string( static_cast<int>( Global.AudioVolume * 100 ) ) + "%###volumemain" ).c_str(), &Global.AudioVolume, 0.0f, 2.0f, "Main audio volume" );
     if( ImGui::SliderFloat( ( to_string( static_cast<int>( Global.VehicleVolume * 100 ) ) + "%###volumevehicle" ).c_str(), &Global.VehicleVolume, 0.0f, 1.0f, "Vehicle sounds" ) ) {
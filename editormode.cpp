@@ -56,6 +56,7 @@ editor_mode::update() {
     Timer::UpdateTimers( true );
 
     simulation::State.update_clocks();
+    simulation::State.update_models();
     simulation::Environment.update();
 
     // render time routines follow:
@@ -0,0 +1,1298 @@
+/*
+This Source Code Form is subject to the
+terms of the Mozilla Public License, v.
+2.0. If a copy of the MPL was not
+distributed with this file, You can
+obtain one at
+http://mozilla.org/MPL/2.0/.
+*/
+/*
+Headless simulation runner. Loads specified scenario without creating a window or opening audio device,
+advances the simulation at fixed step for requested amount of simulated time, then reports subsystem
+timings and hash of the final simulation state. Intended for batch regression checks and benchmarking.
+Can also replay a recorded network session at maximum speed, exporting per-frame vehicle state for analysis,
+or measure encoding and decoding speed of the network message codec on the frames of such recording.
+Replay with a seek point starts from the latest state snapshot of the recording preceding that point.
+Audio band check drives the sound renderer through the null output driver of OpenAL Soft, with emitters placed in each
+distance band, and verifies how often emitters of each band get updated.
+Physics check mode runs the scenario twice, with serial and parallel vehicle physics, and verifies both runs
+end in the same state with the same order of queued events.
+Loopback check mode runs the scenario as a network server storing state keyframes in its backbuffer, then serves
+that backbuffer to a fresh in-process client, and verifies the client started from the latest keyframe ends in the
+same state as the server. The session recording of the server is then replayed from one of its state snapshots,
+which is expected to end in the same state as well. The check is repeated for a scenario with ai driven trains,
+where the server can't store keyframes and both the client and the replay are expected to go through all frames.
+*/
+
+#include "stdafx.h"
+
+#include "Globals.h"
+#include "simulation.h"
+#include "simulationtime.h"
+#include "simulationenvironment.h"
+#include "DynObj.h"
+#include "MemCell.h"
+#include "Track.h"
+#include "Event.h"
+#include "scene.h"
+#include "renderer.h"
+#include "translation.h"
+#include "Timer.h"
+#include "Logs.h"
+#include "sn_utils.h"
+#include "network/recording.h"
+#include "network/manager.h"
+#include "audiorenderer.h"
+#include "sound.h"
+#include "version_info.h"
+
+namespace {
+
+// fixed defaults, to keep runs reproducible between machines
+std::time_t const default_timestamp { 1577880000 }; // 2020-01-01 12:00 UTC
+uint32_t const default_seed { 1 };
+
+struct runner_settings {
+    std::string scenario;
+    std::string report; // output file, stdout if empty
+    double duration { 60.0 }; // simulated time, in seconds
+    double step { 1.0 / 30.0 }; // simulation step, in seconds
+    uint32_t seed { default_seed };
+    std::time_t timestamp { default_timestamp };
+    bool splinebenchmark { false }; // compare methods of distance to spline parameter conversion
+    std::string replay; // session recording to play back, replaces scenario, seed and duration settings
+    std::string exportfile; // per-frame vehicle state output, csv or binary
+    double exportstart { 0.0 }; // simulated time at which the export begins, in seconds
+    int parallelphysics { -1 }; // overrides physics.parallel ini setting if 0 or 1
+    bool eventhash { false }; // include order of queued events in the report
+    bool physicscheck { false }; // compare results of serial and parallel physics
+    bool codecbenchmark { false }; // measure network codec speed on frames of the replayed recording
+    bool audiocheck { false }; // verify update rates of sound emitters in each distance band
+    bool loopbackcheck { false }; // verify client joining from a state keyframe ends in the same state as the server
+    std::string aiscenario; // scenario with ai driven trains, for the loopback check
+    std::string loopback; // network role of the loopback check run, server or client
+};
+
+// accumulated wall time spent in a single subsystem
+struct subsystem_timing {
+    std::string name;
+    std::chrono::duration<double, std::milli> total { 0.0 };
+    std::chrono::duration<double, std::milli> peak { 0.0 };
+};
+
+class subsystem_timer {
+
+public:
+    explicit subsystem_timer( subsystem_timing &Timing ) :
+        m_timing( Timing ),
+        m_start( std::chrono::steady_clock::now() )
+    {}
+    ~subsystem_timer() {
+        auto const elapsed { std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - m_start ) };
+        m_timing.total += elapsed;
+        m_timing.peak = std::max( m_timing.peak, elapsed ); }
+
+private:
+    subsystem_timing &m_timing;
+    std::chrono::time_point<std::chrono::steady_clock> m_start;
+};
+
+// 64-bit FNV-1a
+class state_hash {
+
+public:
+    void
+        add( void const *Data, std::size_t const Size ) {
+            auto const *bytes { reinterpret_cast<std::uint8_t const *>( Data ) };
+            for( std::size_t idx = 0; idx < Size; ++idx ) {
+                m_value ^= bytes[ idx ];
+                m_value *= 0x100000001b3ULL; } }
+    void
+        add( double const Value ) {
+            // normalize negative zero, it's equal for all practical purposes
+            auto const value { ( Value == 0.0 ? 0.0 : Value ) };
+            add( &value, sizeof( value ) ); }
+    void
+        add( std::string const &Value ) {
+            add( Value.data(), Value.size() );
+            add( static_cast<double>( Value.size() ) ); }
+    std::uint64_t
+        value() const {
+            return m_value; }
+
+private:
+    std::uint64_t m_value { 0xcbf29ce484222325ULL };
+};
+
+// writes state of all vehicles after each simulation step. text output for .csv files, binary records otherwise
+class state_exporter {
+
+public:
+    bool
+        open( std::string const &File ) {
+            m_binary = ( false == ends_with( ToLower( File ), ".csv" ) );
+            m_file.open( File, std::ios::out | std::ios::trunc | ( m_binary ? std::ios::binary : std::ios::openmode() ) );
+            if( false == m_file.is_open() ) { return false; }
+            if( false == m_binary ) {
+                m_file << "frame,time,vehicle,x,y,z,velocity,distance,brakepressure,pipepressure,mainctrlpos\n";
+                m_file << std::setprecision( 9 );
+            }
+            return true; }
+    bool
+        is_open() const {
+            return m_file.is_open(); }
+    // binary record: frame, time, vehicle count, then name, position, velocity, distance, brake and pipe pressure, main controller position for each vehicle
+    void
+        write( std::uint64_t const Frame, double const Time ) {
+            auto const &vehicles { simulation::Vehicles.sequence() };
+            if( true == m_binary ) {
+                sn_utils::ls_uint64( m_file, Frame );
+                sn_utils::ls_float64( m_file, Time );
+                sn_utils::ls_uint32( m_file, std::count_if( std::begin( vehicles ), std::end( vehicles ), []( TDynamicObject const *Vehicle ) { return Vehicle != nullptr; } ) );
+            }
+            for( auto const *vehicle : vehicles ) {
+                if( vehicle == nullptr ) { continue; }
+                auto const *mover { vehicle->MoverParameters };
+                auto const position { vehicle->GetPosition() };
+                if( true == m_binary ) {
+                    sn_utils::s_str( m_file, vehicle->name() );
+                    sn_utils::s_dvec3( m_file, position );
+                    sn_utils::ls_float64( m_file, mover->V );
+                    sn_utils::ls_float64( m_file, mover->DistCounter );
+                    sn_utils::ls_float64( m_file, mover->BrakePress );
+                    sn_utils::ls_float64( m_file, mover->PipePress );
+                    sn_utils::ls_int32( m_file, mover->MainCtrlPos );
+                }
+                else {
+                    m_file
+                        << Frame << ',' << Time << ',' << vehicle->name() << ','
+                        << position.x << ',' << position.y << ',' << position.z << ','
+                        << mover->V << ',' << mover->DistCounter << ','
+                        << mover->BrakePress << ',' << mover->PipePress << ','
+                        << mover->MainCtrlPos << '\n';
+                }
+            } }
+
+private:
+    std::ofstream m_file;
+    bool m_binary { false };
+};
+
+// in-process transport for the loopback check. messages pass through the regular codec,
+// and wait at the receiving end until they're delivered
+class loopback_connection : public network::connection {
+
+public:
+    loopback_connection( bool const Client, std::size_t const Counter = 0 ) :
+        network::connection( Client, Counter )
+    {}
+    void
+        connected() override {
+            network::connection::connected(); }
+    void
+        disconnect() override {
+            network::connection::disconnect(); }
+    void
+        send_message( network::message const &Message ) override {
+            auto *peer { m_peer.lock().get() };
+            if( peer == nullptr ) { return; }
+            std::string buffer;
+            network::packet_writer output( buffer );
+            network::serialize_message( Message, output );
+            if( buffer.size() > network::MAX_MSG_SIZE ) {
+                ErrorLog( "net: message too big", logtype::net );
+                return;
+            }
+            peer->m_inbox.emplace_back( std::move( buffer ) ); }
+    void
+        send_messages( std::vector<std::shared_ptr<network::message>> const &Messages ) override {
+            for( auto const &message : Messages ) {
+                send_message( *message ); } }
+    void
+        link( std::shared_ptr<loopback_connection> Peer ) {
+            m_peer = Peer; }
+    // passes received messages to the handler. returns: true if there were any
+    bool
+        deliver() {
+            if( m_inbox.empty() ) { return false; }
+            while( false == m_inbox.empty() ) {
+                auto const buffer { std::move( m_inbox.front() ) };
+                m_inbox.pop_front();
+                network::packet_reader input( buffer.data(), buffer.size() );
+                auto const message { network::deserialize_message( input ) };
+                if( message == nullptr ) {
+                    disconnect();
+                    return true;
+                }
+                if( message_handler ) {
+                    message_handler( *message );
+                }
+            }
+            // let the sender know the transfer is done, same as the socket backend does
+            if( auto peer = m_peer.lock() ) {
+                peer->send_complete( nullptr );
+            }
+            return true; }
+
+private:
+    std::weak_ptr<loopback_connection> m_peer;
+    std::deque<std::string> m_inbox;
+};
+
+class loopback_server : public network::server {
+
+public:
+    explicit loopback_server( std::shared_ptr<std::istream> Backbuffer ) :
+        network::server( Backbuffer )
+    {}
+    // registers provided server end of a new connection
+    void
+        accept( std::shared_ptr<loopback_connection> Connection ) {
+            Connection->set_handler( std::bind( &loopback_server::handle_message, this, Connection, std::placeholders::_1 ) );
+            clients.emplace_back( Connection );
+            Connection->connected(); }
+};
+
+class loopback_client : public network::client {
+
+public:
+    explicit loopback_client( loopback_server &Server ) :
+        m_server( Server )
+    {}
+    // passes messages between both ends of the connection until there's nothing left in transit
+    void
+        pump() {
+            if( m_connection == nullptr ) { return; }
+            if( true == m_connecting ) {
+                // deferred until the base class is done configuring the new connection
+                m_connecting = false;
+                m_connection->connected();
+            }
+            while( ( true == m_connection->deliver() )
+                || ( true == m_serverconnection->deliver() ) ) {
+                ; // each delivery can prompt the server to send the next batch
+            } }
+    // retrieves next frame received from the server. returns: false if there's none
+    bool
+        next_frame( network::frame_info &Frame ) {
+            if( delta_queue.empty() ) { return false; }
+            Frame = delta_queue.front();
+            delta_queue.pop();
+            return true; }
+
+protected:
+    void
+        connect() override {
+            m_connection = std::make_shared<loopback_connection>( true, resume_frame_counter );
+            m_serverconnection = std::make_shared<loopback_connection>( false );
+            m_connection->link( m_serverconnection );
+            m_serverconnection->link( m_connection );
+            m_connection->set_handler( std::bind( &loopback_client::handle_message, this, m_connection, std::placeholders::_1 ) );
+            conn = m_connection;
+            m_server.accept( m_serverconnection );
+            m_connecting = true; }
+
+private:
+    loopback_server &m_server;
+    std::shared_ptr<loopback_connection> m_connection;
+    std::shared_ptr<loopback_connection> m_serverconnection;
+    bool m_connecting { false };
+};
+
+// same checksum as the one used by network clients to detect desync, including its draw from the random engine
+double
+generate_sync() {
+
+    if( Timer::GetDeltaTime() == 0.0 ) { return 0.0; }
+    auto sync { 0.0 };
+    for( auto const *vehicle : simulation::Vehicles.sequence() ) {
+        auto const position { vehicle->GetPosition() };
+        sync += position.x + position.y + position.z;
+    }
+    sync += Random( 1.0, 100.0 );
+    return sync;
+}
+
+int
+parse_arguments( int Argc, char *Argv[], runner_settings &Settings ) {
+
+    for( int i = 1; i < Argc; ++i ) {
+
+        std::string const token { Argv[ i ] };
+        auto const hasvalue { i + 1 < Argc };
+
+        if( ( token == "-s" ) && hasvalue ) {
+            Settings.scenario = ToLower( Argv[ ++i ] );
+        }
+        else if( ( token == "-t" ) && hasvalue ) {
+            Settings.duration = std::max( 0.0, std::atof( Argv[ ++i ] ) );
+        }
+        else if( ( token == "-dt" ) && hasvalue ) {
+            Settings.step = clamp( std::atof( Argv[ ++i ] ), 0.001, 1.0 );
+        }
+        else if( ( token == "-seed" ) && hasvalue ) {
+            Settings.seed = static_cast<uint32_t>( std::strtoul( Argv[ ++i ], nullptr, 10 ) );
+        }
+        else if( ( token == "-timestamp" ) && hasvalue ) {
+            Settings.timestamp = static_cast<std::time_t>( std::strtoll( Argv[ ++i ], nullptr, 10 ) );
+        }
+        else if( ( token == "-o" ) && hasvalue ) {
+            Settings.report = Argv[ ++i ];
+        }
+        else if( token == "-splinebench" ) {
+            Settings.splinebenchmark = true;
+        }
+        else if( ( token == "-replay" ) && hasvalue ) {
+            Settings.replay = Argv[ ++i ];
+        }
+        else if( ( token == "-export" ) && hasvalue ) {
+            Settings.exportfile = Argv[ ++i ];
+        }
+        else if( ( token == "-seek" ) && hasvalue ) {
+            Settings.exportstart = std::max( 0.0, std::atof( Argv[ ++i ] ) );
+        }
+        else if( ( token == "-parallel" ) && hasvalue ) {
+            Settings.parallelphysics = ( std::atoi( Argv[ ++i ] ) != 0 ? 1 : 0 );
+        }
+        else if( token == "-eventhash" ) {
+            Settings.eventhash = true;
+        }
+        else if( token == "-physicscheck" ) {
+            Settings.physicscheck = true;
+        }
+        else if( token == "-codecbench" ) {
+            Settings.codecbenchmark = true;
+        }
+        else if( token == "-audiocheck" ) {
+            Settings.audiocheck = true;
+        }
+        else if( token == "-loopbackcheck" ) {
+            Settings.loopbackcheck = true;
+        }
+        else if( ( token == "-aiscenario" ) && hasvalue ) {
+            Settings.aiscenario = ToLower( Argv[ ++i ] );
+        }
+        else if( ( token == "-loopback" ) && hasvalue
+              && ( ( std::string( Argv[ i + 1 ] ) == "server" ) || ( std::string( Argv[ i + 1 ] ) == "client" ) ) ) {
+            Settings.loopback = Argv[ ++i ];
+        }
+        else {
+            std::cout
+                << "usage: " << std::string( Argv[ 0 ] )
+                << " -s sceneryfilepath"
+                << " [-t simulatedseconds]"
+                << " [-dt stepseconds]"
+                << " [-seed randomseed]"
+                << " [-timestamp startingtimestamp]"
+                << " [-o reportfile]"
+                << " [-splinebench]"
+                << " [-parallel 0|1]"
+                << " [-eventhash]"
+                << " [-physicscheck]"
+                << " [-loopbackcheck -aiscenario sceneryfilepath]"
+                << " [-loopback server|client]"
+                << "\n       " << std::string( Argv[ 0 ] )
+                << " -replay recordingfile"
+                << " [-export statefile.csv|statefile.bin]"
+                << " [-seek simulatedseconds]"
+                << " [-o reportfile]"
+                << "\n       " << std::string( Argv[ 0 ] )
+                << " -replay recordingfile"
+                << " -codecbench"
+                << " [-o reportfile]"
+                << "\n       " << std::string( Argv[ 0 ] )
+                << " -audiocheck"
+                << " [-o reportfile]"
+                << std::endl;
+            return -1;
+        }
+    }
+    if( ( Settings.scenario.empty() ) && ( Settings.replay.empty() ) && ( false == Settings.audiocheck ) ) {
+        std::cout << "no scenario specified" << std::endl;
+        return -1;
+    }
+    if( ( true == Settings.codecbenchmark ) && ( Settings.replay.empty() ) ) {
+        std::cout << "codec benchmark requires a session recording" << std::endl;
+        return -1;
+    }
+    if( ( true == Settings.loopbackcheck ) && ( Settings.aiscenario.empty() ) ) {
+        std::cout << "loopback check requires a scenario with ai driven trains" << std::endl;
+        return -1;
+    }
+    return 0;
+}
+
+// calculates hash of the simulation state most likely to be affected by physics and scenario logic
+std::uint64_t
+hash_state() {
+
+    state_hash hash;
+    hash.add( Timer::GetTime() );
+
+    for( auto const *vehicle : simulation::Vehicles.sequence() ) {
+        if( vehicle == nullptr ) { continue; }
+        auto const *mover { vehicle->MoverParameters };
+        auto const position { vehicle->GetPosition() };
+        hash.add( vehicle->name() );
+        hash.add( position.x );
+        hash.add( position.y );
+        hash.add( position.z );
+        hash.add( mover->V );
+        hash.add( mover->DistCounter );
+        hash.add( mover->BrakePress );
+        hash.add( mover->PipePress );
+        hash.add( static_cast<double>( mover->MainCtrlPos ) );
+        hash.add( static_cast<double>( mover->Couplers[ end::front ].CouplingFlag ) );
+        hash.add( static_cast<double>( mover->Couplers[ end::rear ].CouplingFlag ) );
+    }
+    for( auto const *memcell : simulation::Memory.sequence() ) {
+        if( memcell == nullptr ) { continue; }
+        hash.add( memcell->name() );
+        hash.add( memcell->Text() );
+        hash.add( memcell->Value1() );
+        hash.add( memcell->Value2() );
+    }
+    return hash.value();
+}
+
+// compares table based conversion of distance to spline parameter with the iterative reference method, on segments of loaded scenario
+void
+benchmark_splines( std::ostream &Output ) {
+
+    std::vector<TSegment const *> segments;
+    for( auto const *path : simulation::Paths.sequence() ) {
+        if( ( path != nullptr ) && ( path->CurrentSegment() != nullptr ) ) {
+            segments.emplace_back( path->CurrentSegment().get() );
+        }
+    }
+    // sample points spread over each segment, with some beyond its ends
+    auto const samplecount { 32 };
+    auto sampledistance = []( TSegment const *Segment, int const Sample ) {
+        return Segment->GetLength() * ( -0.05 + 1.1 * Sample / ( samplecount - 1 ) ); };
+
+    auto checksum { 0.0 }; // keeps the optimizer from discarding the work
+    auto const newtonstart { std::chrono::steady_clock::now() };
+    for( auto const *segment : segments ) {
+        for( auto sample = 0; sample < samplecount; ++sample ) {
+            checksum += segment->GetTFromS_Newton( sampledistance( segment, sample ) );
+        }
+    }
+    auto const tablestart { std::chrono::steady_clock::now() };
+    for( auto const *segment : segments ) {
+        for( auto sample = 0; sample < samplecount; ++sample ) {
+            checksum += segment->GetTFromS( sampledistance( segment, sample ) );
+        }
+    }
+    auto const tableend { std::chrono::steady_clock::now() };
+    // position difference between the methods. NOTE: includes tolerance of the reference method
+    auto maxdeviation { 0.0 };
+    for( auto const *segment : segments ) {
+        for( auto sample = 0; sample < samplecount; ++sample ) {
+            auto const distance { sampledistance( segment, sample ) };
+            if( ( distance < 0.0 ) || ( distance > segment->GetLength() ) ) { continue; }
+            auto const deviation {
+                glm::length(
+                    glm::dvec3{ segment->FastGetPoint( segment->GetTFromS_Newton( distance ) ) }
+                  - glm::dvec3{ segment->FastGetPoint( segment->GetTFromS( distance ) ) } ) };
+            maxdeviation = std::max( maxdeviation, deviation );
+        }
+    }
+    auto const newtontime { std::chrono::duration<double, std::milli>( tablestart - newtonstart ) };
+    auto const tabletime { std::chrono::duration<double, std::milli>( tableend - tablestart ) };
+    Output
+        << std::fixed << std::setprecision( 3 )
+        << "splines.segments: " << segments.size() << "\n"
+        << "splines.lookups: " << segments.size() * samplecount << "\n"
+        << "splines.newton: " << newtontime.count() << " ms\n"
+        << "splines.table: " << tabletime.count() << " ms\n"
+        << "splines.speedup: " << ( tabletime.count() > 0.0 ? newtontime.count() / tabletime.count() : 0.0 ) << "\n"
+        << "splines.maxdeviation: " << maxdeviation * 1000.0 << " mm (table tolerance: " << TSegment::arclength_tolerance * 1000.0 << " mm)\n"
+        << "splines.checksum: " << checksum << "\n";
+}
+
+// encodes and decodes frames of specified recording with the network message codec, in packet and backbuffer record form
+// returns: true if all frames survived the round trip unchanged
+bool
+benchmark_codec( network::session_reader &Recording, std::ostream &Output ) {
+
+    std::vector<network::frame_info> frames;
+    {
+        network::frame_info frame;
+        while( true == Recording.next( frame ) ) {
+            frames.emplace_back( frame );
+        }
+    }
+    std::size_t commandcount { 0 };
+    for( auto const &frame : frames ) {
+        for( auto const &commands : frame.commands ) {
+            commandcount += commands.second.size();
+        }
+    }
+    // several passes over the data, to get measurable times from short recordings
+    auto const passcount { 10 };
+    auto checksum { 0.0 }; // keeps the optimizer from discarding the work
+
+    // packet form, as sent over the network
+    std::string packets;
+    std::vector<std::size_t> offsets;
+    auto const encodestart { std::chrono::steady_clock::now() };
+    for( auto pass = 0; pass < passcount; ++pass ) {
+        packets.clear();
+        offsets.clear();
+        network::packet_writer output( packets );
+        for( auto const &frame : frames ) {
+            offsets.emplace_back( packets.size() );
+            network::serialize_message( frame, output );
+        }
+    }
+    offsets.emplace_back( packets.size() );
+    auto const decodestart { std::chrono::steady_clock::now() };
+    for( auto pass = 0; pass < passcount; ++pass ) {
+        for( std::size_t idx = 0; idx < frames.size(); ++idx ) {
+            network::packet_reader input( packets.data() + offsets[ idx ], offsets[ idx + 1 ] - offsets[ idx ] );
+            auto const message { network::deserialize_message( input ) };
+            if( message ) {
+                checksum += static_cast<network::frame_info const &>( *message ).dt;
+            }
+        }
+    }
+    auto const decodeend { std::chrono::steady_clock::now() };
+
+    // length-prefixed record form, as stored in the backbuffer
+    std::stringstream records;
+    auto const streamencodestart { std::chrono::steady_clock::now() };
+    for( auto pass = 0; pass < passcount; ++pass ) {
+        records.str( "" );
+        records.clear();
+        for( auto const &frame : frames ) {
+            network::serialize_message( frame, records );
+        }
+    }
+    auto const streamdecodestart { std::chrono::steady_clock::now() };
+    for( auto pass = 0; pass < passcount; ++pass ) {
+        records.clear();
+        records.seekg( 0 );
+        for( std::size_t idx = 0; idx < frames.size(); ++idx ) {
+            auto const message { network::deserialize_message( records ) };
+            if( message ) {
+                checksum += static_cast<network::frame_info const &>( *message ).dt;
+            }
+        }
+    }
+    auto const streamdecodeend { std::chrono::steady_clock::now() };
+
+    // round trip check, decoded frames have to encode back to the same bytes
+    auto mismatchcount { 0 };
+    std::string reencoded;
+    for( std::size_t idx = 0; idx < frames.size(); ++idx ) {
+        network::packet_reader input( packets.data() + offsets[ idx ], offsets[ idx + 1 ] - offsets[ idx ] );
+        auto const message { network::deserialize_message( input ) };
+        reencoded.clear();
+        if( message ) {
+            network::packet_writer output( reencoded );
+            network::serialize_message( *message, output );
+        }
+        if( reencoded.compare( 0, std::string::npos, packets, offsets[ idx ], offsets[ idx + 1 ] - offsets[ idx ] ) != 0 ) {
+            ++mismatchcount;
+        }
+    }
+
+    auto const framecount { std::max<std::size_t>( 1, frames.size() * passcount ) };
+    auto pertime = [&]( std::chrono::steady_clock::time_point const Start, std::chrono::steady_clock::time_point const End ) {
+        return std::chrono::duration<double, std::micro>( End - Start ).count() / framecount; };
+    Output
+        << std::fixed << std::setprecision( 3 )
+        << "codec.frames: " << frames.size() << "\n"
+        << "codec.commands: " << commandcount << "\n"
+        << "codec.bytes: " << packets.size() << " (" << ( frames.empty() ? 0.0 : static_cast<double>( packets.size() ) / frames.size() ) << " per frame)\n"
+        << "codec.encode: " << pertime( encodestart, decodestart ) << " us per frame\n"
+        << "codec.decode: " << pertime( decodestart, decodeend ) << " us per frame\n"
+        << "codec.stream.encode: " << pertime( streamencodestart, streamdecodestart ) << " us per frame\n"
+        << "codec.stream.decode: " << pertime( streamdecodestart, streamdecodeend ) << " us per frame\n"
+        << "codec.mismatches: " << mismatchcount << "\n"
+        << "codec.checksum: " << checksum << "\n";
+
+    return ( mismatchcount == 0 );
+}
+
+// writes half a second of silence as 16 bit mono wav file
+bool
+write_silence( std::string const &Filename ) {
+
+    std::ofstream file( Filename, std::ios::out | std::ios::trunc | std::ios::binary );
+    if( false == file.is_open() ) { return false; }
+
+    std::uint32_t const rate { 22050 };
+    std::uint32_t const datasize { rate }; // 0.5 s of 2 byte samples
+    file.write( "RIFF", 4 );
+    sn_utils::ls_uint32( file, 36 + datasize );
+    file.write( "WAVEfmt ", 8 );
+    sn_utils::ls_uint32( file, 16 ); // format chunk size
+    sn_utils::ls_uint16( file, 1 ); // pcm
+    sn_utils::ls_uint16( file, 1 ); // channels
+    sn_utils::ls_uint32( file, rate );
+    sn_utils::ls_uint32( file, rate * 2 ); // byte rate
+    sn_utils::ls_uint16( file, 2 ); // block align
+    sn_utils::ls_uint16( file, 16 ); // bits per sample
+    file.write( "data", 4 );
+    sn_utils::ls_uint32( file, datasize );
+    std::vector<char> const samples( datasize, 0 );
+    file.write( samples.data(), samples.size() );
+
+    return file.good();
+}
+
+// places looping sound emitters in each distance band and checks how many updates they receive from the sound renderer
+// the renderer runs on the null output driver of OpenAL Soft, which processes sources without an audio device
+// returns: true if update counts of all bands match their update rates
+bool
+check_audio_bands( std::ostream &Output ) {
+
+#ifdef _WIN32
+    ::_putenv_s( "ALSOFT_DRIVERS", "null" );
+#else
+    ::setenv( "ALSOFT_DRIVERS", "null", 1 );
+#endif
+    Global.bSoundEnabled = true;
+    FreeFlyModeFlag = true;
+    if( false == audio::renderer.init() ) {
+        Output << "audio: failed to initialize sound renderer with null output driver\n";
+        return false;
+    }
+    auto const soundfile { "./headless_audiocheck.wav" };
+    if( false == write_silence( soundfile ) ) {
+        Output << "audio: failed to create test sound file\n";
+        return false;
+    }
+    // emitters along x axis, at distance to range ratios picked from each band: 1, 2, 4 and 6
+    auto const range { 50.f };
+    auto const emittersperband { 3 };
+    std::array<float, 4> const distanceratios { 1.f, 2.f, 4.f, 6.f };
+    std::vector<std::unique_ptr<sound_source>> emitters;
+    // start the emitters with the listener placed where all of them are within activation range...
+    Global.pCamera.Pos = Math3D::vector3( 150.0, 0.0, 0.0 );
+    for( auto const ratio : distanceratios ) {
+        for( auto idx = 0; idx < emittersperband; ++idx ) {
+            emitters.emplace_back( std::make_unique<sound_source>( sound_placement::general, range ) );
+            auto &emitter { *emitters.back() };
+            emitter.deserialize( soundfile, sound_type::single );
+            emitter.offset( { ratio * range, 0.f, 10.f * idx } );
+            emitter.play( sound_flags::looping );
+        }
+    }
+    // ...then move it to the origin, where the emitters end up in their intended bands
+    Global.pCamera.Pos = Math3D::vector3( 0.0, 0.0, 0.0 );
+
+    // frame count divisible by the longest update interval
+    auto const framecount { 64 };
+    std::array<std::size_t, 4> bandupdates {};
+    auto skipcount { 0 };
+    for( auto frame = 0; frame < framecount; ++frame ) {
+        audio::renderer.update( 1.0 / 60.0 );
+        auto const &stats { audio::renderer.voice_stats() };
+        for( std::size_t band = 0; band < bandupdates.size(); ++band ) {
+            bandupdates[ band ] += stats.band_updates[ band ];
+        }
+        skipcount += stats.skips;
+    }
+    auto const &stats { audio::renderer.voice_stats() };
+    auto result { true };
+    for( std::size_t band = 0; band < bandupdates.size(); ++band ) {
+        std::size_t const expected { static_cast<std::size_t>( emittersperband * framecount / ( 1 << band ) ) };
+        Output
+            << "audio.band" << band << ": " << bandupdates[ band ] << " updates, expected " << expected
+            << ( bandupdates[ band ] == expected ? "" : " MISMATCH" ) << "\n";
+        result &= ( bandupdates[ band ] == expected );
+    }
+    Output
+        << "audio.deferred: " << skipcount << "\n"
+        << "audio.voices: " << stats.real << " real, " << stats.virtualized << " virtual\n"
+        << "audiocheck: " << ( result ? "passed" : "FAILED" ) << "\n";
+
+    emitters.clear();
+    std::remove( soundfile );
+
+    return result;
+}
+
+// reads hash entries from specified report file
+std::vector<std::string>
+read_hashes( std::string const &Filename ) {
+
+    std::vector<std::string> hashes;
+    std::ifstream input( Filename );
+    std::string line;
+    while( std::getline( input, line ) ) {
+        if( starts_with( line, "hash" ) ) {
+            hashes.emplace_back( line );
+        }
+    }
+    return hashes;
+}
+
+// runs the scenario with serial and parallel physics in separate processes, then compares their final state and event order
+// returns: 0 if the results match, 1 otherwise
+int
+check_physics( std::string const &Executable, runner_settings const &Settings ) {
+
+    std::vector<std::string> reports;
+    for( auto const parallel : { 0, 1 } ) {
+        auto const report { "physicscheck_" + std::to_string( parallel ) + ".txt" };
+        std::remove( report.c_str() );
+        std::ostringstream command;
+        command
+            << '"' << Executable << '"'
+            << " -s \"" << Settings.scenario << '"'
+            << " -t " << Settings.duration
+            << " -dt " << Settings.step
+            << " -seed " << Settings.seed
+            << " -timestamp " << Settings.timestamp
+            << " -parallel " << parallel
+            << " -eventhash"
+            << " -o " << report;
+        if( std::system( command.str().c_str() ) != 0 ) {
+            std::cout << "physicscheck: run with physics.parallel " << parallel << " failed" << std::endl;
+            return 1;
+        }
+        reports.emplace_back( report );
+    }
+    auto const serial { read_hashes( reports[ 0 ] ) };
+    auto const parallel { read_hashes( reports[ 1 ] ) };
+    if( ( serial.empty() )
+     || ( serial != parallel ) ) {
+        std::cout << "physicscheck: FAILED, serial and parallel physics results differ" << std::endl;
+        for( auto const &hash : serial ) { std::cout << "  serial " << hash << "\n"; }
+        for( auto const &hash : parallel ) { std::cout << "  parallel " << hash << "\n"; }
+        std::cout.flush();
+        return 1;
+    }
+    std::cout << "physicscheck: passed, serial and parallel physics results match" << std::endl;
+    return 0;
+}
+
+// returns value of specified entry of the report stored in provided file, or empty string if there's no such entry
+std::string
+read_report_value( std::string const &Filename, std::string const &Key ) {
+
+    std::ifstream input( Filename );
+    std::string line;
+    while( std::getline( input, line ) ) {
+        if( starts_with( line, Key + ": " ) ) {
+            return line.substr( Key.size() + 2 );
+        }
+    }
+    return {};
+}
+
+// runs specified scenario as a network server storing state keyframes, then serves its backbuffer to a fresh client in separate process,
+// and replays the session recording of the server from one of its state snapshots.
+// for scenario with ai driven trains the server is expected to refuse the keyframes, leaving the client and the replay to go through all frames
+// returns: 0 if the client and the replay end in the same state as the server, 1 otherwise
+int
+check_loopback_scenario( std::string const &Executable, runner_settings const &Settings, std::string const &Scenario, bool const Aitrains ) {
+
+    auto const prefix { std::string( "loopbackcheck_" ) + ( Aitrains ? "ai_" : "" ) };
+    std::vector<std::string> reports;
+    std::remove( "backbuffer.bin" );
+    std::remove( "loopback.rec" );
+    for( auto const *role : { "server", "client" } ) {
+        auto const report { prefix + role + ".txt" };
+        std::remove( report.c_str() );
+        std::ostringstream command;
+        command
+            << '"' << Executable << '"'
+            << " -s \"" << Scenario << '"'
+            << " -t " << Settings.duration
+            << " -dt " << Settings.step
+            << " -seed " << Settings.seed
+            << " -timestamp " << Settings.timestamp
+            << " -loopback " << role
+            << " -o " << report;
+        if( std::system( command.str().c_str() ) != 0 ) {
+            std::cout << "loopbackcheck: " << role << " run of " << Scenario << " failed" << std::endl;
+            return 1;
+        }
+        reports.emplace_back( report );
+    }
+    {
+        // replay of the server session, started from state snapshot stored in the recording
+        auto const report { prefix + "seek.txt" };
+        std::remove( report.c_str() );
+        std::ostringstream command;
+        command
+            << '"' << Executable << '"'
+            << " -replay loopback.rec"
+            << " -seek " << Settings.duration * 0.75
+            << " -o " << report;
+        if( std::system( command.str().c_str() ) != 0 ) {
+            std::cout << "loopbackcheck: seek run of " << Scenario << " failed" << std::endl;
+            return 1;
+        }
+        reports.emplace_back( report );
+    }
+    if( true == Aitrains ) {
+        if( std::atoi( read_report_value( reports[ 0 ], "vehicles.driven" ).c_str() ) == 0 ) {
+            std::cout << "loopbackcheck: FAILED, scenario " << Scenario << " has no ai driven trains" << std::endl;
+            return 1;
+        }
+        if( ( read_report_value( reports[ 0 ], "loopback.keyframe" ) != "0" )
+         || ( read_report_value( reports[ 1 ], "loopback.keyframe" ) != "0" )
+         || ( read_report_value( reports[ 2 ], "replay.start" ) != "0" ) ) {
+            std::cout << "loopbackcheck: FAILED, state keyframe of " << Scenario << " was used despite ai driven trains" << std::endl;
+            return 1;
+        }
+    }
+    auto const server { read_hashes( reports[ 0 ] ) };
+    auto const client { read_hashes( reports[ 1 ] ) };
+    auto const seek { read_hashes( reports[ 2 ] ) };
+    if( ( server.empty() )
+     || ( server != client ) ) {
+        std::cout << "loopbackcheck: FAILED, client of " << Scenario << " ends in different state than the server" << std::endl;
+        for( auto const &hash : server ) { std::cout << "  server " << hash << "\n"; }
+        for( auto const &hash : client ) { std::cout << "  client " << hash << "\n"; }
+        std::cout.flush();
+        return 1;
+    }
+    if( server != seek ) {
+        std::cout << "loopbackcheck: FAILED, replay of " << Scenario << " ends in different state than the server" << std::endl;
+        for( auto const &hash : server ) { std::cout << "  server " << hash << "\n"; }
+        for( auto const &hash : seek ) { std::cout << "  replay " << hash << "\n"; }
+        std::cout.flush();
+        return 1;
+    }
+    return 0;
+}
+
+// runs the loopback check for the main scenario, then for the scenario with ai driven trains
+// returns: 0 if both checks pass, 1 otherwise
+int
+check_loopback( std::string const &Executable, runner_settings const &Settings ) {
+
+    if( ( check_loopback_scenario( Executable, Settings, Settings.scenario, false ) != 0 )
+     || ( check_loopback_scenario( Executable, Settings, Settings.aiscenario, true ) != 0 ) ) {
+        return 1;
+    }
+    std::cout << "loopbackcheck: passed, clients and replays started from stored state or from the first frame end in the same state as the server" << std::endl;
+    return 0;
+}
+
+} // anonymous
+
+int main( int argc, char *argv[] ) {
+
+    runner_settings settings;
+    if( parse_arguments( argc, argv, settings ) != 0 ) {
+        return 1;
+    }
+    if( true == settings.physicscheck ) {
+        return check_physics( argv[ 0 ], settings );
+    }
+    if( true == settings.loopbackcheck ) {
+        return check_loopback( argv[ 0 ], settings );
+    }
+
+    Global.asVersion = VERSION_INFO;
+    Global.LoadIniFile( "eu07.ini" );
+    if( settings.parallelphysics >= 0 ) {
+        Global.ParallelPhysics = ( settings.parallelphysics != 0 );
+    }
+    // recorded session dictates the scenario and its starting conditions
+    network::session_reader recording;
+    if( false == settings.replay.empty() ) {
+        if( false == recording.open( settings.replay ) ) {
+            std::cout << "failed to open session recording " << settings.replay << std::endl;
+            return 1;
+        }
+        settings.scenario = ToLower( recording.header().scenario );
+        settings.seed = recording.header().seed;
+        settings.timestamp = recording.header().timestamp;
+        settings.duration = recording.duration();
+    }
+    if( true == settings.audiocheck ) {
+        // sound renderer check works on its own set of emitters, there's no need to load the scenario
+        std::ostringstream report;
+        auto const result { check_audio_bands( report ) };
+        if( settings.report.empty() ) {
+            std::cout << report.str();
+        }
+        else {
+            std::ofstream output( settings.report, std::ios::trunc );
+            output << report.str();
+        }
+        std::cout.flush();
+        std::_Exit( result ? 0 : 1 );
+    }
+    if( true == settings.codecbenchmark ) {
+        // codec benchmark works on the recorded data alone, there's no need to load the scenario
+        std::ostringstream report;
+        report << "replay: " << settings.replay << "\n";
+        auto const result { benchmark_codec( recording, report ) };
+        if( settings.report.empty() ) {
+            std::cout << report.str();
+        }
+        else {
+            std::ofstream output( settings.report, std::ios::trunc );
+            output << report.str();
+        }
+        std::cout.flush();
+        return ( result ? 0 : 1 );
+    }
+    state_exporter exporter;
+    if( ( false == settings.exportfile.empty() )
+     && ( false == exporter.open( settings.exportfile ) ) ) {
+        std::cout << "failed to create export file " << settings.exportfile << std::endl;
+        return 1;
+    }
+    // there's nothing to present the output with, and nobody to interact with it
+    Global.SceneryFile = settings.scenario;
+    Global.local_start_vehicle = "ghostview";
+    Global.bSoundEnabled = false;
+    Global.python_enabled = false;
+    Global.iPause = 0;
+    Global.fTimeSpeed = 1.0;
+    Global.network_servers.clear();
+    Global.network_client.reset();
+    Global.network_recording.clear();
+    if( settings.loopback == "server" ) {
+        // the server run also leaves behind session recording, with its own state snapshots
+        Global.network_recording = "loopback.rec";
+    }
+    // fixed seeds and starting time, to make runs comparable
+    Global.random_seed = settings.seed;
+    Global.random_engine.seed( settings.seed );
+    Global.local_random_engine.seed( settings.seed );
+    Global.starting_timestamp = settings.timestamp;
+    Global.ready_to_load = true;
+
+    WriteLog( "Starting headless simulation runner (release: " + Global.asVersion + ")" );
+
+    Translations.init();
+    GfxRenderer = gfx_renderer_factory::get_instance()->create( "null" );
+    if( ( GfxRenderer == nullptr )
+     || ( false == GfxRenderer->Init( nullptr ) ) ) {
+        ErrorLog( "Bad init: failed to set up null renderer" );
+        return 1;
+    }
+    simulation::State.init_data();
+
+    // load the scenario
+    auto const loadstart { std::chrono::steady_clock::now() };
+    try {
+        auto state { simulation::State.deserialize_begin( Global.SceneryFile ) };
+        while( true == simulation::State.deserialize_continue( state ) ) {
+            ; // deserialization is performed in chunks, keep going until it's done
+        }
+    }
+    catch( invalid_scenery_exception & ) {
+        ErrorLog( "Bad init: scenario loading failed" );
+        return 1;
+    }
+    auto const loadtime { std::chrono::duration<double>( std::chrono::steady_clock::now() - loadstart ) };
+
+    simulation::Time.init( Global.starting_timestamp );
+    simulation::Environment.init();
+    simulation::is_ready = true;
+    Timer::set_delta_override( settings.step );
+    Timer::ResetTimers();
+
+    std::vector<subsystem_timing> timings {
+        { "environment" },
+        { "dynamics" },
+        { "trains" },
+        { "events" },
+        { "local events" } };
+    auto &environmenttiming { timings[ 0 ] };
+    auto &dynamicstiming { timings[ 1 ] };
+    auto &trainstiming { timings[ 2 ] };
+    auto &eventstiming { timings[ 3 ] };
+    auto &localeventstiming { timings[ 4 ] };
+
+    // order of events queued by vehicles and scenario logic, as seen by the event manager after each physics update
+    state_hash eventhash;
+
+    // primary update step used by the regular driver mode
+    auto const primaryupdaterate { 0.01 };
+    auto primaryupdateaccumulator { 0.0 };
+
+    // advances the simulation by the current time step, returns length of the step
+    auto const simulate_step = [&]() {
+
+        Timer::UpdateTimers( false );
+        auto const deltatime { Timer::GetDeltaTime() };
+
+        {
+            subsystem_timer timer( environmenttiming );
+            simulation::State.update_clocks();
+            simulation::State.update_scripting_interface();
+            simulation::State.update_models();
+            simulation::Environment.update();
+            simulation::Time.update( deltatime );
+        }
+        {
+            subsystem_timer timer( dynamicstiming );
+            // mirror fixed step updates of the regular driver mode
+            primaryupdateaccumulator += deltatime;
+            auto updatecount { static_cast<int>( primaryupdateaccumulator / primaryupdaterate ) };
+            primaryupdateaccumulator -= updatecount * primaryupdaterate;
+            if( true == Global.FullPhysics ) {
+                while( updatecount >= 5 ) {
+                    simulation::State.update( primaryupdaterate, 5 );
+                    updatecount -= 5;
+                }
+                if( updatecount ) {
+                    simulation::State.update( primaryupdaterate, updatecount );
+                }
+            }
+            else if( updatecount ) {
+                simulation::State.update( primaryupdaterate, updatecount );
+            }
+        }
+        if( true == settings.eventhash ) {
+            for( auto const *event : simulation::Events.queued() ) {
+                eventhash.add( event->name() );
+            }
+        }
+        {
+            subsystem_timer timer( trainstiming );
+            simulation::Trains.update( deltatime );
+        }
+        {
+            subsystem_timer timer( eventstiming );
+            simulation::Events.update();
+        }
+        {
+            subsystem_timer timer( localeventstiming );
+            simulation::Region->update_events();
+        }
+        simulation::State.process_commands();
+        return deltatime;
+    };
+
+    // simulation state followed by state of the fixed step updates, same as the state keyframe stored by the network server.
+    // there are no secondary updates here, but the slot is kept to match snapshots made by the driver mode
+    auto const snapshot = [&]() {
+        std::ostringstream state;
+        simulation::State.serialize_state( state );
+        sn_utils::ls_float64( state, primaryupdateaccumulator );
+        sn_utils::ls_float64( state, 0.0 );
+        return state.str();
+    };
+    // restores state stored by the snapshot routine or by the driver mode. returns: true on success
+    auto const restore = [&]( std::string const &Snapshot ) {
+        std::istringstream state( Snapshot );
+        if( false == simulation::State.deserialize_state( state ) ) {
+            return false;
+        }
+        primaryupdateaccumulator = sn_utils::ld_float64( state );
+        sn_utils::ld_float64( state ); // secondary update accumulator
+        return state.good();
+    };
+
+    std::size_t stepcount { 0 };
+    auto simulatedtime { 0.0 };
+    std::size_t desynccount { 0 };
+    std::size_t firstdesync { 0 };
+    std::size_t loopbackkeyframe { 0 }; // number of frames preceding the state keyframe the loopback client started from
+    std::size_t replaystart { 0 }; // number of frames preceding the state snapshot the replay started from
+
+    auto const runstart { std::chrono::steady_clock::now() };
+    if( settings.loopback == "client" ) {
+        // fresh client joining the server run, through the regular network code
+        auto backbuffer { std::make_shared<std::fstream>( "backbuffer.bin", std::ios::in | std::ios::binary ) };
+        auto index { std::make_shared<network::backbuffer_index>() };
+        if( ( false == backbuffer->is_open() )
+         || ( false == index->scan( *backbuffer ) ) ) {
+            std::cout << "loopback: failed to read backbuffer of the server run" << std::endl;
+            return 1;
+        }
+        loopback_server server( backbuffer );
+        server.set_index( index );
+        loopback_client client( server );
+        client.update();
+        client.pump();
+
+        // server without stored state leaves the client to go through all frames
+        auto const keyframe { client.pop_keyframe() };
+        auto const lateststate { index->latest_state() };
+        if( keyframe.has_value() != lateststate.has_value() ) {
+            std::cout << "loopback: client " << ( keyframe.has_value() ? "received unexpected" : "didn't receive" ) << " state keyframe" << std::endl;
+            return 1;
+        }
+        auto const startframe { lateststate.has_value() ? lateststate->second : 0 };
+        loopbackkeyframe = client.get_frame_counter() - client.get_awaiting_frames();
+        if( ( loopbackkeyframe != startframe )
+         || ( static_cast<std::size_t>( client.get_frame_counter() ) != index->frame_count() ) ) {
+            std::cout
+                << "loopback: client started from frame " << loopbackkeyframe << " with " << client.get_awaiting_frames() << " frames to follow, "
+                << "expected frame " << startframe << " of " << index->frame_count() << std::endl;
+            return 1;
+        }
+        if( ( true == keyframe.has_value() )
+         && ( false == restore( *keyframe ) ) ) {
+            std::cout << "loopback: client failed to restore state keyframe" << std::endl;
+            return 1;
+        }
+        // mirror the frame sequence of the network client
+        network::frame_info frame;
+        while( true == client.next_frame( frame ) ) {
+            Timer::set_delta_override( frame.dt );
+            simulation::Commands.push_commands( frame.commands );
+            simulatedtime += simulate_step();
+            simulation::Commands.update();
+            if( generate_sync() != frame.sync ) {
+                if( desynccount == 0 ) {
+                    firstdesync = stepcount;
+                }
+                ++desynccount;
+            }
+            ++stepcount;
+        }
+    }
+    else if( settings.replay.empty() ) {
+        // loopback server stores the frames and a pair of state keyframes, the client is expected to pick the latter.
+        // the keyframes are refused while the state can't be fully serialized, e.g. with ai driven trains in the scenario
+        std::optional<network::server_manager> servers;
+        if( settings.loopback == "server" ) {
+            servers.emplace();
+        }
+        auto const steplimit { static_cast<std::size_t>( std::ceil( settings.duration / settings.step ) ) };
+        for( ; stepcount < steplimit; ++stepcount ) {
+            simulatedtime += simulate_step();
+            if( servers ) {
+                // mirror the frame sequence of the network server
+                simulation::Commands.update();
+                servers->push_delta( settings.step, settings.step, generate_sync(), {} );
+                if( ( stepcount + 1 == steplimit / 3 )
+                 || ( stepcount + 1 == steplimit * 2 / 3 ) ) {
+                    if( true == servers->push_keyframe( snapshot() ) ) {
+                        loopbackkeyframe = stepcount + 1;
+                    }
+                }
+                else if( true == servers->keyframe_due() ) {
+                    // regular keyframes, including state snapshots of the session recording
+                    servers->push_keyframe( snapshot() );
+                }
+            }
+            if( ( true == exporter.is_open() ) && ( simulatedtime >= settings.exportstart ) ) {
+                exporter.write( stepcount, simulatedtime );
+            }
+        }
+        // closing the backbuffer flushes it for the client run
+        servers.reset();
+    }
+    else {
+        if( settings.exportstart > 0.0 ) {
+            // start from the latest state snapshot preceding the requested point, frames before it don't need to be simulated
+            std::string state;
+            auto const keyframe { recording.seek( settings.exportstart, state ) };
+            if( true == keyframe.has_value() ) {
+                if( false == restore( state ) ) {
+                    std::cout << "failed to restore state snapshot of session recording " << settings.replay << std::endl;
+                    return 1;
+                }
+                stepcount = keyframe->frame;
+                simulatedtime = keyframe->time;
+                replaystart = keyframe->frame;
+            }
+        }
+        network::frame_info frame;
+        while( true == recording.next( frame ) ) {
+            // mirror the frame sequence of the network client
+            Timer::set_delta_override( frame.dt );
+            simulation::Commands.push_commands( frame.commands );
+            simulatedtime += simulate_step();
+            simulation::Commands.update();
+            if( generate_sync() != frame.sync ) {
+                if( desynccount == 0 ) {
+                    firstdesync = stepcount;
+                }
+                ++desynccount;
+            }
+            if( ( true == exporter.is_open() ) && ( simulatedtime >= settings.exportstart ) ) {
+                exporter.write( stepcount, simulatedtime );
+            }
+            ++stepcount;
+        }
+    }
+    auto const runtime { std::chrono::duration<double>( std::chrono::steady_clock::now() - runstart ) };
+
+    // report
+    auto dormantcount { 0 };
+    auto drivencount { 0 };
+    for( auto const *vehicle : simulation::Vehicles.sequence() ) {
+        if( ( vehicle != nullptr ) && ( vehicle->is_dormant() ) ) {
+            ++dormantcount;
+        }
+        if( ( vehicle != nullptr ) && ( vehicle->Mechanik != nullptr ) ) {
+            ++drivencount;
+        }
+    }
+    std::ostringstream report;
+    report
+        << std::fixed
+        << "scenario: " << Global.SceneryFile << "\n"
+        << "version: " << Global.asVersion << "\n"
+        << "seed: " << settings.seed << "\n"
+        << "step: " << std::setprecision( 6 ) << settings.step << "\n"
+        << "steps: " << stepcount << "\n"
+        << "vehicles: " << simulation::Vehicles.sequence().size() << "\n"
+        << "vehicles.dormant: " << dormantcount << "\n"
+        << "vehicles.driven: " << drivencount << "\n"
+        << "parallelphysics: " << ( Global.ParallelPhysics ? "yes" : "no" ) << "\n"
+        << std::setprecision( 3 )
+        << "time.load: " << loadtime.count() << " s\n"
+        << "time.simulated: " << simulatedtime << " s\n"
+        << "time.wall: " << runtime.count() << " s\n"
+        << "throughput: " << ( runtime.count() > 0.0 ? simulatedtime / runtime.count() : 0.0 ) << " simulated s/wall s\n";
+    for( auto const &timing : timings ) {
+        report
+            << "subsystem." << timing.name << ": "
+            << timing.total.count() << " ms total, "
+            << ( stepcount > 0 ? timing.total.count() / stepcount : 0.0 ) << " ms average, "
+            << timing.peak.count() << " ms peak\n";
+    }
+    if( false == settings.replay.empty() ) {
+        report
+            << "replay: " << settings.replay << "\n"
+            << "replay.frames: " << stepcount << " of " << recording.frame_count() << "\n"
+            << "replay.start: " << replaystart << "\n"
+            << "replay.desyncs: " << desynccount;
+        if( desynccount > 0 ) {
+            report << " (first at frame " << firstdesync << ")";
+        }
+        report << "\n";
+    }
+    if( false == settings.loopback.empty() ) {
+        report
+            << "loopback.role: " << settings.loopback << "\n"
+            << "loopback.keyframe: " << loopbackkeyframe << "\n";
+        if( settings.loopback == "client" ) {
+            report << "loopback.desyncs: " << desynccount;
+            if( desynccount > 0 ) {
+                report << " (first at frame " << loopbackkeyframe + firstdesync << ")";
+            }
+            report << "\n";
+        }
+    }
+    if( true == settings.splinebenchmark ) {
+        benchmark_splines( report );
+    }
+    report
+        << "hash: " << std::hex << std::setw( 16 ) << std::setfill( '0' ) << hash_state() << "\n";
+    if( true == settings.eventhash ) {
+        report
+            << "hash.events: " << std::hex << std::setw( 16 ) << std::setfill( '0' ) << eventhash.value() << "\n";
+    }
+
+    WriteLog( report.str() );
+    if( settings.report.empty() ) {
+        std::cout << report.str();
+    }
+    else {
+        std::ofstream output( settings.report, std::ios::trunc );
+        output << report.str();
+    }
+    std::cout.flush();
+    // skip destructors, same as the main executable, there are ordering errors which cause segfaults
+    std::_Exit( 0 );
+}
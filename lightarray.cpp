@@ -22,70 +22,182 @@ light_array::insert( TDynamicObject const *Owner ) {
 
     // we're only storing lights for locos, which have two sets of lights, front and rear
     // for a more generic role this function would have to be tweaked to add vehicle type-specific light combinations
-    data.emplace_back( Owner, end::front );
-    data.emplace_back( Owner, end::rear );
+    for( auto const index : { end::front, end::rear } ) {
+        light_record const light { Owner, index };
+        m_owners.emplace_back( light.owner );
+        m_indices.emplace_back( light.index );
+        m_positions.emplace_back( light.position );
+        m_directions.emplace_back( light.direction );
+        m_colors.emplace_back( light.color );
+        m_intensities.emplace_back( light.intensity );
+        m_counts.emplace_back( light.count );
+        m_states.emplace_back( light.state );
+        m_sources.emplace_back();
+    }
 }
 
 void
 light_array::remove( TDynamicObject const *Owner ) {
 
-    data.erase(
-        std::remove_if(
-            data.begin(),
-            data.end(),
-            [=]( light_record const &light ){ return light.owner == Owner; } ),
-        data.end() );
+    std::size_t target { 0 };
+    for( std::size_t source = 0; source < m_owners.size(); ++source ) {
+        if( m_owners[ source ] == Owner ) { continue; }
+        if( target != source ) {
+            m_owners[ target ] = m_owners[ source ];
+            m_indices[ target ] = m_indices[ source ];
+            m_positions[ target ] = m_positions[ source ];
+            m_directions[ target ] = m_directions[ source ];
+            m_colors[ target ] = m_colors[ source ];
+            m_intensities[ target ] = m_intensities[ source ];
+            m_counts[ target ] = m_counts[ source ];
+            m_states[ target ] = m_states[ source ];
+            m_sources[ target ] = m_sources[ source ];
+        }
+        ++target;
+    }
+    m_owners.resize( target );
+    m_indices.resize( target );
+    m_positions.resize( target );
+    m_directions.resize( target );
+    m_colors.resize( target );
+    m_intensities.resize( target );
+    m_counts.resize( target );
+    m_states.resize( target );
+    m_sources.resize( target );
+    // record indices changed, the list of active lights will be rebuilt during next update
+    m_active.clear();
 }
 
 // updates records in the collection
 void
 light_array::update() {
 
-    for( auto &light : data ) {
-        // update light parameters to match current data of the owner
-        if( light.index == end::front ) {
-            // front light set
-            light.position = light.owner->GetPosition() + ( light.owner->VectorFront() * ( std::max( 0.0, light.owner->GetLength() * 0.5 - 2.0 ) ) );// +( light.owner->VectorUp() * 0.25 );
-            light.direction = glm::make_vec3( light.owner->VectorFront().getArray() );
+    m_updatecount = 0;
+    m_active.clear();
+
+    source_data source;
+    TDynamicObject const *sourceowner { nullptr };
+
+    auto const lightcount { m_owners.size() };
+    for( std::size_t idx = 0; idx < lightcount; ++idx ) {
+
+        auto const *owner { m_owners[ idx ] };
+        // dormant vehicles don't move and nobody operates their lights, so their records stay valid as they are
+        if( ( true == owner->is_dormant() )
+         && ( true == m_sources[ idx ].is_valid ) ) {
+            if( m_intensities[ idx ] > 0.f ) {
+                m_active.emplace_back( idx );
+            }
+            continue;
         }
-        else {
-            // rear light set
-            light.position = light.owner->GetPosition() - ( light.owner->VectorFront() * ( std::max( 0.0, light.owner->GetLength() * 0.5 - 2.0 ) ) );// +( light.owner->VectorUp() * 0.25 );
-            light.direction = glm::make_vec3( light.owner->VectorFront().getArray() );
-            light.direction.x = -light.direction.x;
-            light.direction.z = -light.direction.z;
+        if( owner != sourceowner ) {
+            // both light sets of the owner are stored next to each other, so we can gather its shared data once
+            sourceowner = owner;
+            source.position = owner->GetPosition();
+            source.front = owner->VectorFront();
+            source.powered = (
+                ( true == owner->MoverParameters->Power24vIsAvailable )
+             || ( true == owner->MoverParameters->Power110vIsAvailable ) );
+            source.dimmed = owner->DimHeadlights;
+            source.is_valid = true;
         }
-        // determine intensity of this light set
-        if( ( true == light.owner->MoverParameters->Power24vIsAvailable )
-         || ( true == light.owner->MoverParameters->Power110vIsAvailable ) ) {
-            // with power on, the intensity depends on the state of activated switches
-            // first we cross-check the list of enabled lights with the lights installed in the vehicle...
-            auto const lights { light.owner->MoverParameters->iLights[ light.index ] & light.owner->LightList( static_cast<end>( light.index ) ) };
-            // ...then check their individual state
-            light.count = 0
-                + ( ( lights & light::headlight_left  ) ? 1 : 0 )
-                + ( ( lights & light::headlight_right ) ? 1 : 0 )
-                + ( ( lights & light::headlight_upper ) ? 1 : 0 );
-
-            if( light.count > 0 ) {
-                light.intensity = std::max( 0.0f, std::log( (float)light.count  + 1.0f ) );
-                light.intensity *= ( light.owner->DimHeadlights ? 0.6f : 1.0f );
-                // TBD, TODO: intensity can be affected further by other factors
-                light.state = {
-                    ( ( lights & light::headlight_left  ) ? 1.f : 0.f ),
-                    ( ( lights & light::headlight_upper ) ? 1.f : 0.f ),
-                    ( ( lights & light::headlight_right ) ? 1.f : 0.f ) };
-                light.state *= ( light.owner->DimHeadlights ? 0.6f : 1.0f );
-            }
-            else {
-                light.intensity = 0.0f;
-                light.state = glm::vec3{ 0.f };
-            }
+        source.lights = owner->MoverParameters->iLights[ m_indices[ idx ] ] & owner->LightList( static_cast<end>( m_indices[ idx ] ) );
+        // light data is recalculated only if something changed since the last time
+        if( false == ( source == m_sources[ idx ] ) ) {
+            calculate( idx, source );
+            m_sources[ idx ] = source;
+            ++m_updatecount;
+        }
+        if( m_intensities[ idx ] > 0.f ) {
+            m_active.emplace_back( idx );
+        }
+    }
+}
+
+// calculates light parameters from provided owner data, for record with specified index
+void
+light_array::calculate( std::size_t const Index, source_data const &Source ) {
+
+    auto const *owner { m_owners[ Index ] };
+    auto const offset { std::max( 0.0, owner->GetLength() * 0.5 - 2.0 ) };
+    // update light parameters to match current data of the owner
+    if( m_indices[ Index ] == end::front ) {
+        // front light set
+        m_positions[ Index ] = Source.position + Source.front * offset;
+        m_directions[ Index ] = glm::vec3{ Source.front };
+    }
+    else {
+        // rear light set
+        m_positions[ Index ] = Source.position - Source.front * offset;
+        m_directions[ Index ] = glm::vec3{ -Source.front.x, Source.front.y, -Source.front.z };
+    }
+    // determine intensity of this light set
+    if( true == Source.powered ) {
+        // with power on, the intensity depends on the state of activated switches
+        // first we cross-check the list of enabled lights with the lights installed in the vehicle...
+        auto const lights { Source.lights };
+        // ...then check their individual state
+        auto &count { m_counts[ Index ] };
+        count = 0
+            + ( ( lights & light::headlight_left  ) ? 1 : 0 )
+            + ( ( lights & light::headlight_right ) ? 1 : 0 )
+            + ( ( lights & light::headlight_upper ) ? 1 : 0 );
+
+        if( count > 0 ) {
+            auto &intensity { m_intensities[ Index ] };
+            intensity = std::max( 0.0f, std::log( (float)count  + 1.0f ) );
+            intensity *= ( Source.dimmed ? 0.6f : 1.0f );
+            // TBD, TODO: intensity can be affected further by other factors
+            auto &state { m_states[ Index ] };
+            state = {
+                ( ( lights & light::headlight_left  ) ? 1.f : 0.f ),
+                ( ( lights & light::headlight_upper ) ? 1.f : 0.f ),
+                ( ( lights & light::headlight_right ) ? 1.f : 0.f ) };
+            state *= ( Source.dimmed ? 0.6f : 1.0f );
         }
         else {
-            // with battery off the lights are off
-            light.intensity = 0.0f;
-            light.count = 0;
+            m_intensities[ Index ] = 0.0f;
+            m_states[ Index ] = glm::vec3{ 0.f };
         }
     }
+    else {
+        // with battery off the lights are off
+        m_intensities[ Index ] = 0.0f;
+        m_counts[ Index ] = 0;
+    }
+}
+
+// finds up to specified number of active lights most relevant for specified point, within specified range. returns: records of located lights, most relevant first
+std::vector<light_array::light_record> const &
+light_array::find( glm::dvec3 const &Point, std::size_t const Count, double const Range ) {
+
+    m_found.clear();
+    m_candidates.clear();
+    // lights which are off were already filtered out during update, so we only need to check the distance
+    auto const rangesquared { Range * Range };
+    for( auto const idx : m_active ) {
+        auto const distancesquared { glm::length2( Point - m_positions[ idx ] ) };
+        if( distancesquared > rangesquared ) { continue; }
+        // prefer closer and/or brigher light sources
+        m_candidates.emplace_back( distancesquared / m_intensities[ idx ], idx );
+    }
+    auto const foundcount { std::min( Count, m_candidates.size() ) };
+    if( foundcount == 0 ) { return m_found; }
+    // we only need the selected lights in order, the rest can stay unsorted
+    std::partial_sort(
+        std::begin( m_candidates ), std::begin( m_candidates ) + foundcount, std::end( m_candidates ) );
+
+    m_found.reserve( foundcount );
+    for( std::size_t candidate = 0; candidate < foundcount; ++candidate ) {
+        auto const idx { m_candidates[ candidate ].second };
+        m_found.emplace_back( m_owners[ idx ], m_indices[ idx ] );
+        auto &light { m_found.back() };
+        light.position = m_positions[ idx ];
+        light.direction = m_directions[ idx ];
+        light.color = m_colors[ idx ];
+        light.intensity = m_intensities[ idx ];
+        light.count = m_counts[ idx ];
+        light.state = m_states[ idx ];
+    }
+    return m_found;
 }
@@ -4,6 +4,7 @@
 
 // collection of virtual light sources present in the scene
 // used by the renderer to determine most suitable placement for actual light sources during render
+// light data is kept in separate arrays per attribute, and recalculated only for lights whose owners changed
 struct light_array {
 
 public:
@@ -34,10 +35,62 @@ public:
     // updates records in the collection
     void
         update();
+    // finds up to specified number of active lights most relevant for specified point, within specified range. returns: records of located lights, most relevant first
+    std::vector<light_record> const &
+        find( glm::dvec3 const &Point, std::size_t const Count, double const Range );
+    // provides number of records in the collection
+    std::size_t
+        size() const {
+            return m_owners.size(); }
+    // provides number of records recalculated during last update
+    std::size_t
+        updated() const {
+            return m_updatecount; }
+    // provides number of records with lights turned on
+    std::size_t
+        active() const {
+            return m_active.size(); }
 
+private:
 // types
-    typedef std::vector<light_record> lightrecord_array;
+    // owner data the light record was calculated from
+    struct source_data {
+        glm::dvec3 position;
+        glm::dvec3 front;
+        int lights { 0 };
+        bool powered { false };
+        bool dimmed { false };
+        bool is_valid { false };
+
+        bool
+            operator==( source_data const &Other ) const {
+                return ( ( is_valid == Other.is_valid )
+                      && ( lights == Other.lights )
+                      && ( powered == Other.powered )
+                      && ( dimmed == Other.dimmed )
+                      && ( position == Other.position )
+                      && ( front == Other.front ) ); }
+    };
+
+// methods
+    // calculates light parameters from provided owner data, for record with specified index
+    void
+        calculate( std::size_t const Index, source_data const &Source );
 
 // members
-    lightrecord_array data;
+    // light records, one item per array for each light
+    std::vector<TDynamicObject const *> m_owners;
+    std::vector<int> m_indices;
+    std::vector<glm::dvec3> m_positions;
+    std::vector<glm::vec3> m_directions;
+    std::vector<glm::vec3> m_colors;
+    std::vector<float> m_intensities;
+    std::vector<int> m_counts;
+    std::vector<glm::vec3> m_states;
+    std::vector<source_data> m_sources;
+    // helpers
+    std::vector<std::size_t> m_active; // records with non-zero intensity
+    std::vector<std::pair<double, std::size_t>> m_candidates; // scratchpad for queries
+    std::vector<light_record> m_found; // result of the last query
+    std::size_t m_updatecount { 0 };
 };
@@ -121,7 +121,7 @@ extern "C"
 	EXPORT TIsolated* scriptapi_isolated_find(const char* name)
 	{
 		std::string str(name);
-        TIsolated *isolated = TIsolated::Find(name);
+        TIsolated *isolated = simulation::Paths.isolated().find_or_insert(name);
 		if (isolated)
 			return isolated;
 		else
@@ -199,6 +199,13 @@ extern "C"
                          basic_event::flags::text | basic_event::flags::value1 | basic_event::flags::value2);
     }
 
+    EXPORT void scriptapi_memcell_subscribe(TMemCell *mc, basic_event *e)
+    {
+        if (!mc || !e)
+            return;
+        mc->subscribe(e);
+    }
+
     EXPORT void scriptapi_dynobj_putvalues(TDynamicObject *dyn, const char *str, double num1, double num2)
     {
         if (!dyn)
@@ -27,6 +27,7 @@ void scriptapi_dynobj_putvalues(TDynamicObject *dyn, const char *str, double num
 TMemCell* scriptapi_memcell_find(const char *name);
 memcell_values scriptapi_memcell_read(TMemCell *mc);
 void scriptapi_memcell_update(TMemCell *mc, const char *str, double num1, double num2);
+void scriptapi_memcell_subscribe(TMemCell *mc, TEvent *e);
 
 double scriptapi_random(double a, double b);
 void scriptapi_writelog(const char* txt);
@@ -87,6 +88,10 @@ end
 function module.memcell_update_n(a, b)
     ns.scriptapi_memcell_update(ns.scriptapi_memcell_find(a), b.str, b.num1, b.num2)
 end
+module.memcell_subscribe = ns.scriptapi_memcell_subscribe
+function module.memcell_subscribe_n(a, b)
+    ns.scriptapi_memcell_subscribe(ns.scriptapi_memcell_find(a), ns.scriptapi_event_find(b))
+end
 
 module.random = ns.scriptapi_random
 module.writelog = ns.scriptapi_writelog
@@ -197,6 +197,10 @@ OnCommandGet(multiplayer::DaneRozkaz *pRozkaz)
                 WyslijUszkodzenia( lookup->asName, lookup->MoverParameters->EngDmgFlag ); // zwrot informacji o pojeździe
             }
 			break;
+        case 14: // wysłanie informacji o odcinkach izolowanych zmienionych od poprzedniego raportu
+            CommLog(Now() + " " + to_string(pRozkaz->iComm) + " changed isolated" + " rcvd");
+            simulation::Paths.IsolatedBusyList( true );
+            break;
         default:
             break;
 		}
@@ -1,6 +1,5 @@
 #include "stdafx.h"
 #include "network/backend/asio.h"
-#include "sn_utils.h"
 #include "Logs.h"
 
 network::tcp::connection::connection(asio::io_context &io_ctx, bool client, size_t counter)
@@ -21,9 +20,27 @@ void network::tcp::connection::disconnect()
 	network::connection::disconnect();
 }
 
+std::shared_ptr<std::string> network::tcp::connection::acquire_buffer()
+{
+	if (m_send_buffers.empty())
+		return std::make_shared<std::string>();
+
+	auto buffer = m_send_buffers.back();
+	m_send_buffers.pop_back();
+	buffer->clear();
+
+	return buffer;
+}
+
 void network::tcp::connection::send_data(std::shared_ptr<std::string> buffer)
 {
-	asio::async_write(m_socket, asio::buffer(*buffer.get()), std::bind(&connection::send_complete, this, buffer));
+	asio::async_write(m_socket, asio::buffer(*buffer.get()), std::bind(&connection::handle_send, this, buffer));
+}
+
+void network::tcp::connection::handle_send(std::shared_ptr<std::string> buffer)
+{
+	m_send_buffers.push_back(buffer);
+	send_complete(buffer);
 }
 
 void network::tcp::connection::connected()
@@ -46,24 +63,25 @@ void network::tcp::connection::handle_header(const asio::error_code &err, size_t
 		return;
 	}
 
-	std::istringstream header(m_header_buffer);
 	if (m_header_buffer.size() != bytes_transferred) {
 		disconnect();
 		return;
 	}
 
-	uint32_t sig = sn_utils::ld_uint32(header);
+	packet_reader header(m_header_buffer.data(), m_header_buffer.size());
+
+	uint32_t sig = header.get_uint32();
 	if (sig != NETWORK_MAGIC) {
 		disconnect();
 		return;
 	}
 
-	uint32_t len = sn_utils::ld_uint32(header);
-	m_body_buffer.resize(len);
+	uint32_t len = header.get_uint32();
 	if (len > MAX_MSG_SIZE) {
 		disconnect();
 		return;
 	}
+	m_body_buffer.resize(len);
 
 	asio::async_read(m_socket, asio::buffer(m_body_buffer),
 	                 std::bind(&connection::handle_data, this, std::placeholders::_1, std::placeholders::_2));
@@ -81,32 +99,36 @@ void network::tcp::connection::handle_data(const asio::error_code &err, size_t b
 		return;
 	}
 
-	std::istringstream stream(m_body_buffer);
-	std::shared_ptr<message> msg = deserialize_message(stream);
+	packet_reader input(m_body_buffer.data(), m_body_buffer.size());
+	std::shared_ptr<message> msg = deserialize_message(input);
+	if (!msg) {
+		disconnect();
+		return;
+	}
+
 	if (message_handler)
 		message_handler(*msg);
 
 	read_header();
 }
 
-void network::tcp::connection::write_message(const message &msg, std::ostream &stream)
+void network::tcp::connection::write_message(const message &msg, std::string &buffer)
 {
-	size_t beg = (size_t)stream.tellp();
+	size_t beg = buffer.size();
 
-	sn_utils::ls_uint32(stream, NETWORK_MAGIC);
-	sn_utils::ls_uint32(stream, 0);
+	packet_writer output(buffer);
+	output.put_uint32(NETWORK_MAGIC);
+	output.put_uint32(0);
 
-	serialize_message(msg, stream);
+	serialize_message(msg, output);
 
-	size_t size = (size_t)stream.tellp() - beg - 8;
+	size_t size = buffer.size() - beg - 8;
 	if (size > MAX_MSG_SIZE) {
 		ErrorLog("net: message too big", logtype::net);
+		buffer.resize(beg);
 		return;
 	}
-	stream.seekp(beg + 4, std::ios_base::beg);
-	sn_utils::ls_uint32(stream, size);
-
-	stream.seekp(0, std::ios_base::end);
+	output.patch_uint32(beg + 4, size);
 }
 
 void network::tcp::connection::send_messages(const std::vector<std::shared_ptr<message> > &messages)
@@ -114,21 +136,20 @@ void network::tcp::connection::send_messages(const std::vector<std::shared_ptr<m
 	if (messages.size() == 0)
 		return;
 
-	std::ostringstream stream;
+	// whole batch goes out in a single write
+	auto buffer = acquire_buffer();
 	for (auto const &msg : messages)
-		write_message(*msg.get(), stream);
+		write_message(*msg.get(), *buffer.get());
 
-	stream.flush();
-	send_data(std::make_shared<std::string>(stream.str()));
+	send_data(buffer);
 }
 
 void network::tcp::connection::send_message(const message &msg)
 {
-	std::ostringstream stream;
-	write_message(msg, stream);
+	auto buffer = acquire_buffer();
+	write_message(msg, *buffer.get());
 
-	stream.flush();
-	send_data(std::make_shared<std::string>(stream.str()));
+	send_data(buffer);
 }
 
 // -----------------
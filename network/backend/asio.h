@@ -10,7 +10,6 @@
 namespace network::tcp
 {
     const uint32_t NETWORK_MAGIC = 0x37305545;
-	const uint32_t MAX_MSG_SIZE = 100000;
 
 	class connection : public network::connection
 	{
@@ -31,9 +30,14 @@ namespace network::tcp
 	private:
 		std::string m_header_buffer;
 		std::string m_body_buffer;
+		// send buffers returned after completed writes, reused to avoid per-message allocations
+		std::vector<std::shared_ptr<std::string>> m_send_buffers;
 
-		void write_message(const message &msg, std::ostream &stream);
+		// appends framed message to the buffer
+		void write_message(const message &msg, std::string &buffer);
+		std::shared_ptr<std::string> acquire_buffer();
 		void send_data(std::shared_ptr<std::string> buffer);
+		void handle_send(std::shared_ptr<std::string> buffer);
 		void read_header();
 		void handle_header(const asio::error_code &err, size_t bytes_transferred);
 		void handle_data(const asio::error_code &err, size_t bytes_transferred);
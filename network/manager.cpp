@@ -10,11 +10,13 @@ http://mozilla.org/MPL/2.0/.
 #include "stdafx.h"
 #include "network/manager.h"
 #include "simulation.h"
+#include "Globals.h"
 #include "Logs.h"
 
 network::server_manager::server_manager()
 {
 	backbuffer = std::make_shared<std::fstream>("backbuffer.bin", std::ios::out | std::ios::in | std::ios::trunc | std::ios::binary);
+	index = std::make_shared<backbuffer_index>();
 }
 
 command_queue::commands_map network::server_manager::pop_commands()
@@ -41,7 +43,52 @@ void network::server_manager::push_delta(double render_dt, double dt, double syn
 	for (auto srv : servers)
 		srv->push_delta(msg);
 
+	backbuffer->seekp(0, std::ios_base::end);
+	index->push(static_cast<size_t>(backbuffer->tellp()));
 	serialize_message(msg, *backbuffer.get());
+
+	if (!Global.network_recording.empty()) {
+		if (index->frame_count() == 1) {
+			// seed and starting time are settled by the time the first frame is produced
+			recording_header header;
+			header.seed = Global.random_seed;
+			header.timestamp = Global.starting_timestamp;
+			header.scenario = Global.SceneryFile;
+			recorder.open(Global.network_recording, header);
+		}
+		recorder.push(msg);
+	}
+}
+
+bool network::server_manager::keyframe_due() const
+{
+	return (index->state_due() || recorder.state_due()) && simulation::State.is_state_complete();
+}
+
+bool network::server_manager::push_keyframe(const std::string &state)
+{
+	if (!simulation::State.is_state_complete()) {
+		// clients and replays go through the frames instead, from the last complete state or from the start
+		return false;
+	}
+
+	backbuffer->seekp(0, std::ios_base::end);
+	index->push_state(static_cast<size_t>(backbuffer->tellp()));
+
+	state_keyframe msg;
+	msg.frame = static_cast<uint32_t>(index->frame_count());
+	msg.chunk_count = static_cast<uint32_t>(std::max<size_t>(1, (state.size() + state_keyframe::CHUNK_SIZE - 1) / state_keyframe::CHUNK_SIZE));
+	for (msg.chunk = 0; msg.chunk < msg.chunk_count; ++msg.chunk) {
+		msg.data = state.substr(msg.chunk * state_keyframe::CHUNK_SIZE, state_keyframe::CHUNK_SIZE);
+		serialize_message(msg, *backbuffer.get());
+	}
+	// session recording gets its own snapshots, at block boundaries
+	if (recorder.state_due())
+		recorder.push_state(state);
+
+	WriteLog("net: stored simulation state at frame " + std::to_string(msg.frame)
+	         + ", " + std::to_string(state.size()) + " bytes", logtype::net);
+	return true;
 }
 
 void network::server_manager::create_server(const std::string &backend, const std::string &conf)
@@ -52,7 +99,9 @@ void network::server_manager::create_server(const std::string &backend, const st
 		return;
 	}
 
-	servers.emplace_back(it->second->create_server(backbuffer, conf));
+	auto srv { it->second->create_server(backbuffer, conf) };
+	srv->set_index(index);
+	servers.emplace_back(srv);
 }
 
 network::manager::manager()
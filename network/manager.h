@@ -1,6 +1,7 @@
 #pragma once
 #include <memory>
 #include "network/network.h"
+#include "network/recording.h"
 #include "command.h"
 
 namespace network
@@ -10,11 +11,19 @@ namespace network
 	private:
 		std::vector<std::shared_ptr<server>> servers;
 		std::shared_ptr<std::fstream> backbuffer;
+		std::shared_ptr<backbuffer_index> index;
+		session_recorder recorder;
 
 	public:
 		server_manager();
 
 		void push_delta(double render_dt, double dt, double sync, const command_queue::commands_map &commands);
+		// returns true if simulation state should be stored in the backbuffer or the session recording after the most recent frame
+		// NOTE: never true while the simulation state can't be fully serialized
+		bool keyframe_due() const;
+		// stores provided simulation state in the backbuffer, for clients joining later, and in the session recording if it's due.
+		// returns: true if the state was stored, false if the simulation state can't be fully serialized at the moment
+		bool push_keyframe(const std::string &state);
 		command_queue::commands_map pop_commands();
 		void create_server(const std::string &backend, const std::string &conf);
 	};
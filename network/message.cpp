@@ -2,108 +2,342 @@
 #include "network/message.h"
 #include "sn_utils.h"
 
-void network::client_hello::serialize(std::ostream &stream) const
+// packet writer
+
+void network::packet_writer::put_uint8(uint8_t Value)
+{
+	m_buffer.push_back(static_cast<char>(Value));
+}
+
+void network::packet_writer::put_uint16(uint16_t Value)
+{
+	put_uint8(Value & 0xFF);
+	put_uint8(Value >> 8);
+}
+
+void network::packet_writer::put_uint32(uint32_t Value)
+{
+	for (int i = 0; i < 4; ++i)
+		put_uint8((Value >> (i * 8)) & 0xFF);
+}
+
+void network::packet_writer::put_int64(int64_t Value)
+{
+	auto const value { static_cast<uint64_t>(Value) };
+	for (int i = 0; i < 8; ++i)
+		put_uint8((value >> (i * 8)) & 0xFF);
+}
+
+void network::packet_writer::put_float32(float Value)
+{
+	uint32_t value;
+	std::memcpy(&value, &Value, sizeof(value));
+	put_uint32(value);
+}
+
+void network::packet_writer::put_float64(double Value)
+{
+	int64_t value;
+	std::memcpy(&value, &Value, sizeof(value));
+	put_int64(value);
+}
+
+void network::packet_writer::put_varint(uint64_t Value)
+{
+	while (Value >= 0x80) {
+		put_uint8(static_cast<uint8_t>(Value | 0x80));
+		Value >>= 7;
+	}
+	put_uint8(static_cast<uint8_t>(Value));
+}
+
+void network::packet_writer::put_svarint(int64_t Value)
+{
+	put_varint((static_cast<uint64_t>(Value) << 1) ^ static_cast<uint64_t>(Value >> 63));
+}
+
+void network::packet_writer::put_string(std::string const &Value)
+{
+	put_varint(Value.size());
+	m_buffer.append(Value);
+}
+
+void network::packet_writer::put_vec3(glm::vec3 const &Value)
+{
+	put_float32(Value.x);
+	put_float32(Value.y);
+	put_float32(Value.z);
+}
+
+void network::packet_writer::patch_uint32(size_t Offset, uint32_t Value)
+{
+	for (int i = 0; i < 4; ++i)
+		m_buffer[Offset + i] = static_cast<char>((Value >> (i * 8)) & 0xFF);
+}
+
+// --------------
+
+// packet reader
+
+void network::packet_reader::read(void *Output, size_t Size)
+{
+	if (m_size - m_position < Size) {
+		m_overrun = true;
+		m_position = m_size;
+		std::memset(Output, 0, Size);
+		return;
+	}
+
+	std::memcpy(Output, m_data + m_position, Size);
+	m_position += Size;
+}
+
+uint8_t network::packet_reader::get_uint8()
+{
+	uint8_t value;
+	read(&value, 1);
+	return value;
+}
+
+uint16_t network::packet_reader::get_uint16()
+{
+	uint8_t buf[2];
+	read(buf, 2);
+	return static_cast<uint16_t>(buf[0] | (buf[1] << 8));
+}
+
+uint32_t network::packet_reader::get_uint32()
+{
+	uint8_t buf[4];
+	read(buf, 4);
+	uint32_t value = 0;
+	for (int i = 0; i < 4; ++i)
+		value |= static_cast<uint32_t>(buf[i]) << (i * 8);
+	return value;
+}
+
+int64_t network::packet_reader::get_int64()
+{
+	uint8_t buf[8];
+	read(buf, 8);
+	uint64_t value = 0;
+	for (int i = 0; i < 8; ++i)
+		value |= static_cast<uint64_t>(buf[i]) << (i * 8);
+	return static_cast<int64_t>(value);
+}
+
+float network::packet_reader::get_float32()
+{
+	auto const bits { get_uint32() };
+	float value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+double network::packet_reader::get_float64()
+{
+	auto const bits { get_int64() };
+	double value;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+uint64_t network::packet_reader::get_varint()
+{
+	uint64_t value = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		auto const byte { get_uint8() };
+		value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+		if ((byte & 0x80) == 0)
+			return value;
+	}
+	// too long to be valid
+	m_overrun = true;
+	return 0;
+}
+
+int64_t network::packet_reader::get_svarint()
+{
+	auto const value { get_varint() };
+	return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+std::string network::packet_reader::get_string()
+{
+	auto const size { get_varint() };
+	if (m_size - m_position < size) {
+		m_overrun = true;
+		m_position = m_size;
+		return {};
+	}
+
+	std::string value(m_data + m_position, size);
+	m_position += size;
+	return value;
+}
+
+glm::vec3 network::packet_reader::get_vec3()
+{
+	glm::vec3 value;
+	value.x = get_float32();
+	value.y = get_float32();
+	value.z = get_float32();
+	return value;
+}
+
+// --------------
+
+// messages
+
+void network::client_hello::serialize(packet_writer &Output) const
 {
-	sn_utils::ls_int32(stream, version);
-	sn_utils::ls_uint32(stream, start_packet);
+	Output.put_uint32(static_cast<uint32_t>(version));
+	Output.put_uint32(start_packet);
+	Output.put_uint8(keyframe ? 1 : 0);
 }
 
-void network::client_hello::deserialize(std::istream &stream)
+void network::client_hello::deserialize(packet_reader &Input)
 {
-	version = sn_utils::ld_int32(stream);
-	start_packet = sn_utils::ld_uint32(stream);
+	version = static_cast<int32_t>(Input.get_uint32());
+	start_packet = Input.get_uint32();
+	keyframe = (Input.get_uint8() != 0);
 }
 
-void network::server_hello::serialize(std::ostream &stream) const
+void network::server_hello::serialize(packet_writer &Output) const
 {
-	sn_utils::ls_uint32(stream, seed);
-	sn_utils::ls_int64(stream, timestamp);
-    sn_utils::ls_int64(stream, config);
-    sn_utils::s_str(stream, scenario);
+	Output.put_uint32(seed);
+	Output.put_int64(timestamp);
+	Output.put_int64(config);
+	Output.put_string(scenario);
 }
 
-void network::server_hello::deserialize(std::istream &stream)
+void network::server_hello::deserialize(packet_reader &Input)
 {
-	seed = sn_utils::ld_uint32(stream);
-	timestamp = sn_utils::ld_int64(stream);
-    config = sn_utils::ld_int64(stream);
-    scenario = sn_utils::d_str(stream);
+	seed = Input.get_uint32();
+	timestamp = Input.get_int64();
+	config = Input.get_int64();
+	scenario = Input.get_string();
 }
 
-void ::network::request_command::serialize(std::ostream &stream) const
+namespace network {
+
+// fields of command_data stored in the packet. most commands carry only a few of them
+enum command_field : uint8_t {
+	field_param1 = 1 << 0,
+	field_param2 = 1 << 1,
+	field_timedelta = 1 << 2,
+	field_freefly = 1 << 3,
+	field_location = 1 << 4,
+	field_payload = 1 << 5
+};
+
+}
+
+void network::request_command::serialize(packet_writer &Output) const
 {
-	sn_utils::ls_uint32(stream, commands.size());
+	Output.put_varint(commands.size());
 	for (auto const &kv : commands)
 	{
-		sn_utils::ls_uint32(stream, kv.first);
-		sn_utils::ls_uint32(stream, kv.second.size());
+		Output.put_varint(kv.first);
+		Output.put_varint(kv.second.size());
 		for (command_data const &data : kv.second)
 		{
-			sn_utils::ls_uint32(stream, (uint32_t)data.command);
-			sn_utils::ls_int32(stream, data.action);
-			sn_utils::ls_float64(stream, data.param1);
-			sn_utils::ls_float64(stream, data.param2);
-			sn_utils::ls_float64(stream, data.time_delta);
+			uint8_t fields = 0;
+			if (data.param1 != 0.0)               { fields |= field_param1; }
+			if (data.param2 != 0.0)               { fields |= field_param2; }
+			if (data.time_delta != 0.0)           { fields |= field_timedelta; }
+			if (data.freefly)                     { fields |= field_freefly; }
+			if (data.location != glm::vec3(0.f)) { fields |= field_location; }
+			if (false == data.payload.empty())    { fields |= field_payload; }
 
-			sn_utils::s_bool(stream, data.freefly);
-			sn_utils::s_vec3(stream, data.location);
+			Output.put_varint(static_cast<uint32_t>(data.command));
+			Output.put_svarint(data.action);
+			Output.put_uint8(fields);
 
-			sn_utils::s_str(stream, data.payload);
+			if (fields & field_param1)    { Output.put_float64(data.param1); }
+			if (fields & field_param2)    { Output.put_float64(data.param2); }
+			if (fields & field_timedelta) { Output.put_float64(data.time_delta); }
+			if (fields & field_location)  { Output.put_vec3(data.location); }
+			if (fields & field_payload)   { Output.put_string(data.payload); }
 		}
 	}
 }
 
-void network::request_command::deserialize(std::istream &stream)
+void network::request_command::deserialize(packet_reader &Input)
 {
-	uint32_t commands_size = sn_utils::ld_uint32(stream);
-	for (uint32_t i = 0; i < commands_size; i++)
+	auto const commands_size { Input.get_varint() };
+	for (uint64_t i = 0; i < commands_size && Input.good(); i++)
 	{
-		uint32_t recipient = sn_utils::ld_uint32(stream);
-		uint32_t sequence_size = sn_utils::ld_uint32(stream);
+		auto const recipient { static_cast<uint32_t>(Input.get_varint()) };
+		auto const sequence_size { Input.get_varint() };
 
-		command_queue::commanddata_sequence sequence;
-		for (uint32_t i = 0; i < sequence_size; i++)
+		auto &sequence { commands[recipient] };
+		for (uint64_t j = 0; j < sequence_size && Input.good(); j++)
 		{
 			command_data data;
-			data.command = (user_command)sn_utils::ld_uint32(stream);
-			data.action = sn_utils::ld_int32(stream);
-			data.param1 = sn_utils::ld_float64(stream);
-			data.param2 = sn_utils::ld_float64(stream);
-			data.time_delta = sn_utils::ld_float64(stream);
+			data.command = static_cast<user_command>(Input.get_varint());
+			data.action = static_cast<int>(Input.get_svarint());
 
-			data.freefly = sn_utils::d_bool(stream);
-			data.location = sn_utils::d_vec3(stream);
+			auto const fields { Input.get_uint8() };
+			data.param1 = ((fields & field_param1) ? Input.get_float64() : 0.0);
+			data.param2 = ((fields & field_param2) ? Input.get_float64() : 0.0);
+			data.time_delta = ((fields & field_timedelta) ? Input.get_float64() : 0.0);
+			data.freefly = ((fields & field_freefly) != 0);
+			data.location = ((fields & field_location) ? Input.get_vec3() : glm::vec3(0.f));
+			if (fields & field_payload)
+				data.payload = Input.get_string();
 
-			data.payload = sn_utils::d_str(stream);
-
-			sequence.emplace_back(data);
+			sequence.emplace_back(std::move(data));
 		}
-
-		commands.emplace(recipient, sequence);
 	}
 }
 
-void network::frame_info::serialize(std::ostream &stream) const
+void network::frame_info::serialize(packet_writer &Output) const
+{
+	// render time step matches simulation time step unless the simulation is paused or time-scaled
+	auto const splitdt { render_dt != dt };
+
+	Output.put_uint8(splitdt ? 1 : 0);
+	Output.put_float64(dt);
+	if (splitdt)
+		Output.put_float64(render_dt);
+	Output.put_float64(sync);
+
+	request_command::serialize(Output);
+}
+
+void network::frame_info::deserialize(packet_reader &Input)
 {
-	sn_utils::ls_float64(stream, render_dt);
-	sn_utils::ls_float64(stream, dt);
-	sn_utils::ls_float64(stream, sync);
+	auto const splitdt { (Input.get_uint8() & 1) != 0 };
 
-	request_command::serialize(stream);
+	dt = Input.get_float64();
+	render_dt = (splitdt ? Input.get_float64() : dt);
+	sync = Input.get_float64();
+
+	request_command::deserialize(Input);
 }
 
-void network::frame_info::deserialize(std::istream &stream)
+void network::state_keyframe::serialize(packet_writer &Output) const
 {
-	render_dt = sn_utils::ld_float64(stream);
-	dt = sn_utils::ld_float64(stream);
-	sync = sn_utils::ld_float64(stream);
+	Output.put_uint32(frame);
+	Output.put_uint32(chunk);
+	Output.put_uint32(chunk_count);
+	Output.put_string(data);
+}
 
-	request_command::deserialize(stream);
+void network::state_keyframe::deserialize(packet_reader &Input)
+{
+	frame = Input.get_uint32();
+	chunk = Input.get_uint32();
+	chunk_count = Input.get_uint32();
+	data = Input.get_string();
 }
 
-std::shared_ptr<network::message> network::deserialize_message(std::istream &stream)
+// --------------
+
+std::shared_ptr<network::message> network::deserialize_message(packet_reader &Input)
 {
-	message::type_e type = (message::type_e)sn_utils::ld_uint16(stream);
+	message::type_e type = (message::type_e)Input.get_uint16();
 
 	std::shared_ptr<message> msg;
 
@@ -115,14 +349,64 @@ std::shared_ptr<network::message> network::deserialize_message(std::istream &str
 		msg = std::make_shared<frame_info>();
 	else if (type == message::REQUEST_COMMAND)
 		msg = std::make_shared<request_command>();
+	else if (type == message::STATE_KEYFRAME)
+		msg = std::make_shared<state_keyframe>();
+
+	if (!msg || !Input.good())
+		return nullptr;
+
+	msg->deserialize(Input);
 
-	msg->deserialize(stream);
+	if (!Input.good())
+		return nullptr;
 
 	return msg;
 }
 
+void network::serialize_message(const message &msg, packet_writer &Output)
+{
+	Output.put_uint16((uint16_t)msg.type);
+	msg.serialize(Output);
+}
+
+std::shared_ptr<network::message> network::deserialize_message(std::istream &stream)
+{
+	// scratch buffer retains its capacity between records
+	thread_local std::string buffer;
+
+	auto const size { sn_utils::ld_uint32(stream) };
+	if (!stream.good() || size > MAX_MSG_SIZE)
+		return nullptr;
+
+	buffer.resize(size);
+	stream.read(&buffer[0], buffer.size());
+	if (static_cast<size_t>(stream.gcount()) != buffer.size())
+		return nullptr;
+
+	packet_reader input(buffer.data(), buffer.size());
+	return deserialize_message(input);
+}
+
 void network::serialize_message(const message &msg, std::ostream &stream)
 {
-	sn_utils::ls_uint16(stream, (uint16_t)msg.type);
-	msg.serialize(stream);
+	thread_local std::string buffer;
+
+	buffer.clear();
+	packet_writer output(buffer);
+	serialize_message(msg, output);
+
+	sn_utils::ls_uint32(stream, buffer.size());
+	stream.write(buffer.data(), buffer.size());
+}
+
+network::message::type_e network::skip_message(std::istream &stream)
+{
+	auto const size { sn_utils::ld_uint32(stream) };
+	if (!stream.good() || size < 2)
+		return message::TYPE_MAX;
+
+	auto const type { sn_utils::ld_uint16(stream) };
+	stream.seekg(size - 2, std::ios_base::cur);
+
+	return (type < message::TYPE_MAX ? static_cast<message::type_e>(type) : message::TYPE_MAX);
 }
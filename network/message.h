@@ -5,6 +5,70 @@
 
 namespace network
 {
+// version of the message protocol, peers and session recordings of other versions are rejected
+const uint32_t EU07_NETWORK_VERSION = 4;
+// upper limit of encoded message size, records claiming more are treated as corrupted
+const uint32_t MAX_MSG_SIZE = 100000;
+
+// appends little endian binary data to caller-owned buffer, which can be reused between messages to avoid reallocations
+class packet_writer
+{
+public:
+	packet_writer(std::string &Buffer) : m_buffer(Buffer) {}
+
+	void put_uint8(uint8_t Value);
+	void put_uint16(uint16_t Value);
+	void put_uint32(uint32_t Value);
+	void put_int64(int64_t Value);
+	void put_float32(float Value);
+	void put_float64(double Value);
+	// unsigned LEB128 varint
+	void put_varint(uint64_t Value);
+	// zigzag-encoded signed varint
+	void put_svarint(int64_t Value);
+	// varint length followed by string data
+	void put_string(std::string const &Value);
+	void put_vec3(glm::vec3 const &Value);
+	// overwrites previously written 32 bit value at specified buffer offset
+	void patch_uint32(size_t Offset, uint32_t Value);
+
+	size_t size() const {
+		return m_buffer.size(); }
+
+private:
+	std::string &m_buffer;
+};
+
+// reads little endian binary data from memory block. reading past the end yields zeroes and marks the reader as failed
+class packet_reader
+{
+public:
+	packet_reader(char const *Data, size_t Size) : m_data(Data), m_size(Size) {}
+
+	uint8_t get_uint8();
+	uint16_t get_uint16();
+	uint32_t get_uint32();
+	int64_t get_int64();
+	float get_float32();
+	double get_float64();
+	uint64_t get_varint();
+	int64_t get_svarint();
+	std::string get_string();
+	glm::vec3 get_vec3();
+
+	bool good() const {
+		return false == m_overrun; }
+
+private:
+	// copies specified number of bytes from current position, or zeroes if there's not enough data left
+	void read(void *Output, size_t Size);
+
+	char const *m_data;
+	size_t m_size;
+	size_t m_position = 0;
+	bool m_overrun = false;
+};
+
 struct message
 {
 	enum type_e
@@ -13,25 +77,27 @@ struct message
 		SERVER_HELLO,
 		FRAME_INFO,
 		REQUEST_COMMAND,
+		STATE_KEYFRAME,
 		TYPE_MAX
 	};
 
 	type_e type;
 
 	message(type_e t) : type(t) {}
-	virtual void serialize(std::ostream &stream) const {}
-	virtual void deserialize(std::istream &stream) {}
+	virtual void serialize(packet_writer &Output) const {}
+	virtual void deserialize(packet_reader &Input) {}
 };
 
 struct client_hello : public message
 {
 	client_hello() : message(CLIENT_HELLO) {}
 
-	virtual void serialize(std::ostream &stream) const override;
-	virtual void deserialize(std::istream &stream) override;
+	virtual void serialize(packet_writer &Output) const override;
+	virtual void deserialize(packet_reader &Input) override;
 
 	int32_t version;
 	uint32_t start_packet;
+	bool keyframe; // fresh peer accepts state keyframe in place of the frames preceding it
 };
 
 struct server_hello : public message
@@ -43,8 +109,8 @@ struct server_hello : public message
     int64_t config;
     std::string scenario;
 
-	virtual void serialize(std::ostream &stream) const override;
-	virtual void deserialize(std::istream &stream) override;
+	virtual void serialize(packet_writer &Output) const override;
+	virtual void deserialize(packet_reader &Input) override;
 };
 
 struct request_command : public message
@@ -54,8 +120,8 @@ struct request_command : public message
 
 	command_queue::commands_map commands;
 
-	virtual void serialize(std::ostream &stream) const override;
-	virtual void deserialize(std::istream &stream) override;
+	virtual void serialize(packet_writer &Output) const override;
+	virtual void deserialize(packet_reader &Input) override;
 };
 
 struct frame_info : public request_command
@@ -66,10 +132,36 @@ struct frame_info : public request_command
 	double dt;
 	double sync;
 
-	virtual void serialize(std::ostream &stream) const override;
-	virtual void deserialize(std::istream &stream) override;
+	virtual void serialize(packet_writer &Output) const override;
+	virtual void deserialize(packet_reader &Input) override;
+};
+
+// part of full simulation state, stored in the backbuffer every few keyframes of the index.
+// state doesn't fit in a single message, so it's split in chunks sent one after another
+struct state_keyframe : public message
+{
+	// payload carried by single chunk, leaves room for the headers within MAX_MSG_SIZE
+	static const size_t CHUNK_SIZE = 65536;
+
+	state_keyframe() : message(STATE_KEYFRAME) {}
+
+	uint32_t frame; // number of frames preceding the keyframe
+	uint32_t chunk;
+	uint32_t chunk_count;
+	std::string data;
+
+	virtual void serialize(packet_writer &Output) const override;
+	virtual void deserialize(packet_reader &Input) override;
 };
 
+// decodes single message from memory block. returns null on malformed or truncated data
+std::shared_ptr<message> deserialize_message(packet_reader &Input);
+// encodes message type and payload into the buffer
+void serialize_message(const message &msg, packet_writer &Output);
+// stream variants store messages as length-prefixed records, for use with the backbuffer
+// returns null on truncated records and records exceeding MAX_MSG_SIZE
 std::shared_ptr<message> deserialize_message(std::istream &stream);
 void serialize_message(const message &msg, std::ostream &stream);
+// moves the stream past the next length-prefixed record without decoding it. returns type of the skipped message
+message::type_e skip_message(std::istream &stream);
 } // namespace network
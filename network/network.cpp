@@ -7,8 +7,6 @@
 #include "application.h"
 #include "Globals.h"
 
-std::uint32_t const EU07_NETWORK_VERSION = 2;
-
 namespace network {
 
 backend_list_t& backend_list() {
@@ -19,6 +17,76 @@ backend_list_t& backend_list() {
 }
 
 }
+// backbuffer index
+
+void network::backbuffer_index::push(size_t Offset)
+{
+	if (m_framecount % KEYFRAME_INTERVAL == 0)
+		m_offsets.push_back(Offset);
+
+	++m_framecount;
+}
+
+void network::backbuffer_index::push_state(size_t Offset)
+{
+	m_states.emplace_back(Offset, m_framecount);
+}
+
+std::pair<size_t, size_t> network::backbuffer_index::seek(size_t Frame) const
+{
+	if (m_offsets.empty())
+		return { 0, 0 };
+
+	auto const keyframe { std::min(Frame / KEYFRAME_INTERVAL, m_offsets.size() - 1) };
+
+	return { m_offsets[keyframe], keyframe * KEYFRAME_INTERVAL };
+}
+
+std::optional<std::pair<size_t, size_t>> network::backbuffer_index::latest_state() const
+{
+	if (m_states.empty())
+		return std::nullopt;
+
+	return m_states.back();
+}
+
+bool network::backbuffer_index::state_due() const
+{
+	return (m_framecount > 0
+	        && m_framecount % STATE_INTERVAL == 0
+	        && (m_states.empty() || m_states.back().second != m_framecount));
+}
+
+bool network::backbuffer_index::scan(std::istream &Input)
+{
+	m_offsets.clear();
+	m_states.clear();
+	m_framecount = 0;
+
+	Input.seekg(0, std::ios_base::beg);
+	auto laststate { false };
+	while (Input.peek() != EOF) {
+		auto const offset { static_cast<size_t>(Input.tellg()) };
+		auto const type { skip_message(Input) };
+		if (!Input.good())
+			return false;
+
+		if (type == message::FRAME_INFO)
+			push(offset);
+		else if (type == message::STATE_KEYFRAME && !laststate)
+			// state is stored as a run of chunks, the run starts with the first one
+			push_state(offset);
+
+		laststate = (type == message::STATE_KEYFRAME);
+	}
+	Input.clear();
+	Input.seekg(0, std::ios_base::end);
+
+	return true;
+}
+
+// --------------
+
 // connection
 
 void network::connection::disconnect() {
@@ -44,6 +112,7 @@ void network::connection::connected()
 		client_hello msg;
 		msg.version = EU07_NETWORK_VERSION;
 		msg.start_packet = packet_counter;
+		msg.keyframe = (request_keyframe && packet_counter == 0);
 		send_message(msg);
 	}
 }
@@ -62,14 +131,34 @@ void network::connection::catch_up()
 			return;
 		}
 
-		auto msg = deserialize_message(*backbuffer.get());
+		auto const position { backbuffer->tellg() };
+		auto const type { skip_message(*backbuffer.get()) };
 
-		if (packet_counter) {
-			packet_counter--;
-			i--; // TODO: it would be better to skip frames in chunks
+		if (type == message::STATE_KEYFRAME && !keyframe_pending) {
+			// peer has the state already, either from the frames or from the keyframe it started with
+			i--;
 			continue;
 		}
 
+		if (type == message::FRAME_INFO) {
+			keyframe_pending = false;
+
+			if (packet_counter) {
+				// remainder past the keyframe the connection was started from
+				packet_counter--;
+				i--;
+				continue;
+			}
+		}
+
+		backbuffer->seekg(position);
+		auto msg = deserialize_message(*backbuffer.get());
+		if (!msg) {
+			ErrorLog("net: corrupted backbuffer record", logtype::net);
+			disconnect();
+			return;
+		}
+
 		messages.push_back(msg);
 	}
 
@@ -94,6 +183,11 @@ network::server::server(std::shared_ptr<std::istream> buf) : backbuffer(buf)
 
 }
 
+void network::server::set_index(std::shared_ptr<backbuffer_index const> idx)
+{
+	index = idx;
+}
+
 void network::server::push_delta(const frame_info &msg)
 {
 	for (auto it = clients.begin(); it != clients.end(); ) {
@@ -140,12 +234,28 @@ void network::server::handle_message(std::shared_ptr<connection> conn, const mes
         reply.scenario = Global.SceneryFile;
 		conn->state = connection::CATCHING_UP;
 		conn->backbuffer = backbuffer;
-		conn->backbuffer_pos = 0;
-		conn->packet_counter = cmd.start_packet;
+
+		auto const state { (index && cmd.keyframe && cmd.start_packet == 0) ? index->latest_state() : std::nullopt };
+		if (state) {
+			// fresh client receives the most recent simulation state, followed by the frames past it
+			conn->backbuffer_pos = state->first;
+			conn->packet_counter = 0;
+			conn->keyframe_pending = true;
+		}
+		else {
+			// resuming client starts from the nearest keyframe and skips only the frames past it
+			auto const keyframe { index ? index->seek(cmd.start_packet) : std::pair<size_t, size_t>{ 0, 0 } };
+			conn->backbuffer_pos = keyframe.first;
+			conn->packet_counter = cmd.start_packet - keyframe.second;
+		}
 
 		conn->send_message(reply);
 
-		WriteLog("net: client accepted", logtype::net);
+		if (state)
+			WriteLog("net: client accepted, starting from state at frame " + std::to_string(state->second), logtype::net);
+		else
+			WriteLog("net: client accepted, resuming from frame " + std::to_string(cmd.start_packet - conn->packet_counter)
+			         + " with " + std::to_string(conn->packet_counter) + " frames to skip", logtype::net);
 	}
 	else if (msg.type == message::REQUEST_COMMAND) {
 		auto cmd = dynamic_cast<const request_command&>(msg);
@@ -165,7 +275,13 @@ void network::client::update()
 
 	if (!conn) {
 		if (!reconnect_delay) {
+			// partially received state is of no use to the new connection
+			keyframe_buffer.clear();
+			keyframe_chunks = 0;
+
 			connect();
+			if (conn)
+				conn->request_keyframe = !keyframes_rejected;
 			reconnect_delay = RECONNECT_DELAY_FRAMES;
 		}
 		reconnect_delay--;
@@ -232,6 +348,26 @@ void network::client::send_commands(command_queue::commands_map commands)
 	conn->send_message(msg);
 }
 
+std::optional<std::string> network::client::pop_keyframe()
+{
+	auto state { std::move(keyframe) };
+	keyframe.reset();
+	return state;
+}
+
+void network::client::reject_keyframe()
+{
+	WriteLog("net: state keyframe rejected, restarting from the first frame", logtype::net);
+
+	keyframes_rejected = true;
+	keyframe.reset();
+	std::queue<frame_info>().swap(delta_queue);
+	resume_frame_counter = 0;
+
+	if (conn)
+		conn->disconnect();
+}
+
 void network::client::handle_message(std::shared_ptr<connection> conn, const message &msg)
 {
 	if (msg.type >= message::TYPE_MAX)
@@ -270,6 +406,26 @@ void network::client::handle_message(std::shared_ptr<connection> conn, const mes
 		delta_queue.push(delta);
 		last_rcv = std::chrono::high_resolution_clock::now();
 	}
+	else if (msg.type == message::STATE_KEYFRAME) {
+		auto const &chunk = dynamic_cast<const state_keyframe&>(msg);
+
+		// state can only arrive ahead of any frames, as a complete run of chunks
+		if (resume_frame_counter != 0 || chunk.chunk != keyframe_chunks) {
+			ErrorLog("net: unexpected state keyframe", logtype::net);
+			conn->disconnect();
+			return;
+		}
+
+		keyframe_buffer.append(chunk.data);
+		if (++keyframe_chunks == chunk.chunk_count) {
+			keyframe = std::move(keyframe_buffer);
+			keyframe_buffer.clear();
+			keyframe_chunks = 0;
+			resume_frame_counter = chunk.frame;
+
+			WriteLog("net: state keyframe received, frame " + std::to_string(chunk.frame), logtype::net);
+		}
+	}
 }
 
 // --------------
@@ -9,6 +9,37 @@
 
 namespace network
 {
+	// index of frame positions in the backbuffer stream, recorded every KEYFRAME_INTERVAL frames.
+	// lets resuming peers seek straight to the nearest keyframe instead of skipping frames one by one.
+	// every STATE_INTERVAL frames the backbuffer also receives full simulation state, which lets fresh peers skip the frames altogether
+	class backbuffer_index
+	{
+	public:
+		static const size_t KEYFRAME_INTERVAL = 600;
+		static const size_t STATE_INTERVAL = 10 * KEYFRAME_INTERVAL;
+
+		// registers frame about to be written to the backbuffer at specified stream offset
+		void push(size_t Offset);
+		// registers simulation state about to be written to the backbuffer at specified stream offset, after current frame
+		void push_state(size_t Offset);
+		// returns stream offset and number of the nearest keyframe at or before specified frame
+		std::pair<size_t, size_t> seek(size_t Frame) const;
+		// returns stream offset of the most recent simulation state and number of frames preceding it, if there's any
+		std::optional<std::pair<size_t, size_t>> latest_state() const;
+		// returns true if simulation state should be stored after current frame
+		bool state_due() const;
+		// rebuilds the index from content of existing backbuffer. returns: true on success
+		bool scan(std::istream &Input);
+		// returns number of frames stored in the backbuffer
+		size_t frame_count() const {
+			return m_framecount; }
+
+	private:
+		std::vector<size_t> m_offsets; // stream offsets of frames 0, KEYFRAME_INTERVAL, 2*KEYFRAME_INTERVAL...
+		std::vector<std::pair<size_t, size_t>> m_states; // stream offsets of stored simulation states, and numbers of frames preceding them
+		size_t m_framecount = 0;
+	};
+
     //m7todo: separate client/server connection class?
     class connection
 	{
@@ -24,6 +55,7 @@ namespace network
 		std::shared_ptr<std::istream> backbuffer;
 		size_t backbuffer_pos;
 		size_t packet_counter;
+		bool keyframe_pending = false; // server: state keyframe at the start of the catch-up is yet to be sent
 
 		void send_complete(std::shared_ptr<std::string> buf);
 		void catch_up();
@@ -38,6 +70,8 @@ namespace network
 		connection(bool client = false, size_t counter = 0);
 		void set_handler(std::function<void(const message &msg)> handler);
 
+		bool request_keyframe = false; // client: fresh peer asks for state keyframe in place of the frames preceding it
+
 		virtual void disconnect() = 0;
 
 		enum peer_state {
@@ -53,6 +87,7 @@ namespace network
 	{
 	private:
 		std::shared_ptr<std::istream> backbuffer;
+		std::shared_ptr<backbuffer_index const> index;
 
 	protected:
 		void handle_message(std::shared_ptr<connection> conn, const message &msg);
@@ -63,6 +98,7 @@ namespace network
 
 	public:
 		server(std::shared_ptr<std::istream> buf);
+		void set_index(std::shared_ptr<backbuffer_index const> idx);
 		void push_delta(const frame_info &msg);
 		command_queue::commands_map pop_commands();
 	};
@@ -86,6 +122,11 @@ namespace network
 
 		std::queue<frame_info> delta_queue;
 
+		std::string keyframe_buffer; // state keyframe being assembled from received chunks
+		size_t keyframe_chunks = 0;
+		std::optional<std::string> keyframe; // complete state keyframe waiting to be applied
+		bool keyframes_rejected = false;
+
 		float last_target = 20.0f;
 		float jitteriness = 1.0f;
 		float consume_counter = 0.0f;
@@ -98,6 +139,10 @@ namespace network
 		void update();
 		std::tuple<double, double, command_queue::commands_map> get_next_delta(int counter);
 		void send_commands(command_queue::commands_map commands);
+		// returns complete state keyframe received from the server, if there's one waiting to be applied
+		std::optional<std::string> pop_keyframe();
+		// drops the connection and catches up from the first frame instead, for when received state can't be applied
+		void reject_keyframe();
 		int get_frame_counter() {
 			return resume_frame_counter;
 		}
@@ -0,0 +1,387 @@
+/*
+This Source Code Form is subject to the
+terms of the Mozilla Public License, v.
+2.0. If a copy of the MPL was not
+distributed with this file, You can
+obtain one at
+http://mozilla.org/MPL/2.0/.
+*/
+
+#include "stdafx.h"
+#include "network/recording.h"
+#include "sn_utils.h"
+#include "Logs.h"
+
+#include <zlib.h>
+
+namespace network {
+
+uint32_t const RECORDING_MAGIC = 0x52375545; // EU7R
+uint32_t const RECORDING_VERSION = 3;
+// block header: raw size, compressed size, frame count, start time, duration, state raw size, state compressed size
+size_t const BLOCK_HEADER_SIZE = 4 + 4 + 4 + 8 + 8 + 4 + 4;
+// footer: index offset, frame count, duration, magic
+size_t const FOOTER_SIZE = 8 + 8 + 8 + 4;
+
+// compresses provided data into target buffer. returns true on success
+bool compress_data(std::string const &Source, std::string &Target)
+{
+	auto compressedsize { compressBound(Source.size()) };
+	Target.resize(compressedsize);
+	if (compress2(reinterpret_cast<Bytef *>(&Target[0]), &compressedsize,
+	              reinterpret_cast<Bytef const *>(Source.data()), Source.size(), Z_BEST_SPEED) != Z_OK)
+		return false;
+
+	Target.resize(compressedsize);
+	return true;
+}
+
+}
+
+// session recorder
+
+network::session_recorder::~session_recorder()
+{
+	close();
+}
+
+bool network::session_recorder::open(std::string const &File, recording_header const &Header)
+{
+	close();
+
+	m_file.open(File, std::ios::out | std::ios::trunc | std::ios::binary);
+	if (!m_file.is_open()) {
+		ErrorLog("net: failed to create session recording \"" + File + "\"", logtype::net);
+		return false;
+	}
+
+	sn_utils::ls_uint32(m_file, RECORDING_MAGIC);
+	sn_utils::ls_uint32(m_file, RECORDING_VERSION);
+	sn_utils::ls_uint32(m_file, EU07_NETWORK_VERSION);
+	sn_utils::ls_uint32(m_file, Header.seed);
+	sn_utils::ls_int64(m_file, Header.timestamp);
+	sn_utils::s_str(m_file, Header.scenario);
+
+	m_block.clear();
+	m_state.clear();
+	m_blockframes = 0;
+	m_blocktime = 0.0;
+	m_time = 0.0;
+	m_framecount = 0;
+	m_index.clear();
+
+	WriteLog("net: recording session to \"" + File + "\"", logtype::net);
+	return true;
+}
+
+void network::session_recorder::push(frame_info const &Frame)
+{
+	if (!m_file.is_open())
+		return;
+
+	auto const beg { m_block.size() };
+	packet_writer output(m_block);
+	output.put_uint32(0);
+	serialize_message(Frame, output);
+	output.patch_uint32(beg, m_block.size() - beg - 4);
+
+	m_time += Frame.dt;
+	++m_blockframes;
+	++m_framecount;
+
+	if (m_blockframes >= BLOCK_FRAMES)
+		flush_block();
+}
+
+bool network::session_recorder::state_due() const
+{
+	// the first block starts with the scenario as loaded, there's no need for a snapshot
+	return m_file.is_open()
+	        && m_blockframes == 0
+	        && m_state.empty()
+	        && !m_index.empty()
+	        && m_index.size() % STATE_BLOCKS == 0;
+}
+
+void network::session_recorder::push_state(std::string const &State)
+{
+	if (!m_file.is_open() || m_blockframes != 0)
+		return;
+
+	m_state = State;
+}
+
+void network::session_recorder::flush_block()
+{
+	if (m_blockframes == 0)
+		return;
+
+	recording_keyframe keyframe;
+	keyframe.time = m_blocktime;
+	keyframe.frame = m_framecount - m_blockframes;
+	keyframe.offset = static_cast<uint64_t>(m_file.tellp());
+	keyframe.state = !m_state.empty();
+
+	std::string compressedstate;
+	if (!compress_data(m_state, compressedstate)
+	        || !compress_data(m_block, m_compressed)) {
+		ErrorLog("net: failed to compress session recording block", logtype::net);
+		m_file.close();
+		return;
+	}
+
+	sn_utils::ls_uint32(m_file, m_block.size());
+	sn_utils::ls_uint32(m_file, m_compressed.size());
+	sn_utils::ls_uint32(m_file, m_blockframes);
+	sn_utils::ls_float64(m_file, m_blocktime);
+	sn_utils::ls_float64(m_file, m_time - m_blocktime);
+	sn_utils::ls_uint32(m_file, m_state.size());
+	sn_utils::ls_uint32(m_file, keyframe.state ? compressedstate.size() : 0);
+	if (keyframe.state)
+		m_file.write(compressedstate.data(), compressedstate.size());
+	m_file.write(m_compressed.data(), m_compressed.size());
+	// keep the data on disk as we go, recordings are most valuable when the simulation crashes
+	m_file.flush();
+
+	m_index.push_back(keyframe);
+
+	m_block.clear();
+	m_state.clear();
+	m_blockframes = 0;
+	m_blocktime = m_time;
+}
+
+void network::session_recorder::close()
+{
+	if (!m_file.is_open())
+		return;
+
+	flush_block();
+
+	auto const indexoffset { static_cast<uint64_t>(m_file.tellp()) };
+	sn_utils::ls_uint32(m_file, m_index.size());
+	for (auto const &keyframe : m_index) {
+		sn_utils::ls_float64(m_file, keyframe.time);
+		sn_utils::ls_uint64(m_file, keyframe.frame);
+		sn_utils::ls_uint64(m_file, keyframe.offset);
+		sn_utils::s_bool(m_file, keyframe.state);
+	}
+	sn_utils::ls_uint64(m_file, indexoffset);
+	sn_utils::ls_uint64(m_file, m_framecount);
+	sn_utils::ls_float64(m_file, m_time);
+	sn_utils::ls_uint32(m_file, RECORDING_MAGIC);
+
+	m_file.close();
+}
+
+// --------------
+
+// session reader
+
+bool network::session_reader::open(std::string const &File)
+{
+	m_file.close();
+	m_file.clear();
+	m_file.open(File, std::ios::in | std::ios::binary);
+	if (!m_file.is_open()) {
+		ErrorLog("net: failed to open session recording \"" + File + "\"", logtype::net);
+		return false;
+	}
+
+	if (sn_utils::ld_uint32(m_file) != RECORDING_MAGIC
+	        || sn_utils::ld_uint32(m_file) != RECORDING_VERSION) {
+		ErrorLog("net: \"" + File + "\" is not a supported session recording", logtype::net);
+		m_file.close();
+		return false;
+	}
+	auto const networkversion { sn_utils::ld_uint32(m_file) };
+	if (networkversion != EU07_NETWORK_VERSION) {
+		// recorded frames are only meaningful to the protocol version which produced them
+		ErrorLog("net: session recording \"" + File + "\" was made with network version " + std::to_string(networkversion)
+		         + ", expected " + std::to_string(EU07_NETWORK_VERSION), logtype::net);
+		m_file.close();
+		return false;
+	}
+	m_header.seed = sn_utils::ld_uint32(m_file);
+	m_header.timestamp = sn_utils::ld_int64(m_file);
+	m_header.scenario = sn_utils::d_str(m_file);
+	if (!m_file) {
+		ErrorLog("net: session recording \"" + File + "\" is truncated", logtype::net);
+		m_file.close();
+		return false;
+	}
+	m_datastart = static_cast<uint64_t>(m_file.tellg());
+
+	m_index.clear();
+	m_framecount = 0;
+	m_duration = 0.0;
+
+	// use stored index if the recording was closed properly
+	m_file.seekg(0, std::ios_base::end);
+	auto const filesize { static_cast<uint64_t>(m_file.tellg()) };
+	auto indexed { false };
+	if (filesize >= m_datastart + FOOTER_SIZE) {
+		m_file.seekg(filesize - FOOTER_SIZE);
+		auto const indexoffset { sn_utils::ld_uint64(m_file) };
+		auto const framecount { sn_utils::ld_uint64(m_file) };
+		auto const duration { sn_utils::ld_float64(m_file) };
+		if (sn_utils::ld_uint32(m_file) == RECORDING_MAGIC
+		        && indexoffset >= m_datastart
+		        && indexoffset < filesize) {
+			m_file.seekg(indexoffset);
+			auto const keyframecount { sn_utils::ld_uint32(m_file) };
+			for (uint32_t i = 0; i < keyframecount && m_file; ++i) {
+				recording_keyframe keyframe;
+				keyframe.time = sn_utils::ld_float64(m_file);
+				keyframe.frame = sn_utils::ld_uint64(m_file);
+				keyframe.offset = sn_utils::ld_uint64(m_file);
+				keyframe.state = sn_utils::d_bool(m_file);
+				m_index.push_back(keyframe);
+			}
+			if (m_file) {
+				m_dataend = indexoffset;
+				m_framecount = framecount;
+				m_duration = duration;
+				indexed = true;
+			}
+		}
+	}
+	if (!indexed) {
+		WriteLog("net: session recording \"" + File + "\" has no index, scanning blocks", logtype::net);
+		scan_blocks(m_datastart);
+	}
+
+	m_file.clear();
+	m_file.seekg(m_datastart);
+	m_block.clear();
+	m_blockposition = 0;
+
+	return true;
+}
+
+void network::session_reader::scan_blocks(uint64_t Start)
+{
+	m_index.clear();
+	m_framecount = 0;
+	m_duration = 0.0;
+	m_dataend = Start;
+
+	m_file.clear();
+	m_file.seekg(0, std::ios_base::end);
+	auto const filesize { static_cast<uint64_t>(m_file.tellg()) };
+
+	auto offset { Start };
+	while (offset + BLOCK_HEADER_SIZE <= filesize) {
+		m_file.seekg(offset);
+		sn_utils::ld_uint32(m_file); // raw size
+		auto const compressedsize { sn_utils::ld_uint32(m_file) };
+		auto const framecount { sn_utils::ld_uint32(m_file) };
+		auto const time { sn_utils::ld_float64(m_file) };
+		auto const duration { sn_utils::ld_float64(m_file) };
+		sn_utils::ld_uint32(m_file); // state raw size
+		auto const statesize { sn_utils::ld_uint32(m_file) };
+		auto const blocksize { BLOCK_HEADER_SIZE + statesize + compressedsize };
+		if (!m_file || offset + blocksize > filesize)
+			break; // incomplete block, the recording was cut short while it was written
+
+		m_index.push_back({ time, m_framecount, offset, statesize > 0 });
+		m_framecount += framecount;
+		m_duration = time + duration;
+
+		offset += blocksize;
+		m_dataend = offset;
+	}
+}
+
+bool network::session_reader::read_block(std::string *State)
+{
+	if (!m_file.is_open()
+	        || static_cast<uint64_t>(m_file.tellg()) + BLOCK_HEADER_SIZE > m_dataend)
+		return false;
+
+	auto const rawsize { sn_utils::ld_uint32(m_file) };
+	auto const compressedsize { sn_utils::ld_uint32(m_file) };
+	sn_utils::ld_uint32(m_file); // frame count
+	sn_utils::ld_float64(m_file); // start time
+	sn_utils::ld_float64(m_file); // duration
+	auto const staterawsize { sn_utils::ld_uint32(m_file) };
+	auto const statesize { sn_utils::ld_uint32(m_file) };
+
+	if (State != nullptr && statesize > 0) {
+		m_compressed.resize(statesize);
+		m_file.read(&m_compressed[0], statesize);
+		if (!m_file || !uncompress_data(m_compressed, *State, staterawsize))
+			return false;
+	}
+	else {
+		// regular playback has no use for the snapshot
+		m_file.seekg(statesize, std::ios_base::cur);
+	}
+
+	m_compressed.resize(compressedsize);
+	m_file.read(&m_compressed[0], compressedsize);
+	if (!m_file || !uncompress_data(m_compressed, m_block, rawsize)) {
+		m_block.clear();
+		return false;
+	}
+	m_blockposition = 0;
+
+	return true;
+}
+
+bool network::session_reader::uncompress_data(std::string const &Source, std::string &Target, uint32_t const Size)
+{
+	Target.resize(Size);
+	uLongf targetsize { Size };
+	if (uncompress(reinterpret_cast<Bytef *>(&Target[0]), &targetsize,
+	               reinterpret_cast<Bytef const *>(Source.data()), Source.size()) != Z_OK
+	        || targetsize != Size) {
+		ErrorLog("net: corrupted session recording block", logtype::net);
+		return false;
+	}
+	return true;
+}
+
+std::optional<network::recording_keyframe> network::session_reader::seek(double Time, std::string &State)
+{
+	auto const lookup { std::find_if(m_index.rbegin(), m_index.rend(),
+		[Time](recording_keyframe const &Keyframe) {
+			return Keyframe.state && Keyframe.time <= Time; }) };
+	if (lookup == m_index.rend())
+		return std::nullopt;
+
+	m_file.clear();
+	m_file.seekg(lookup->offset);
+	if (!read_block(&State)) {
+		// leave the reader at the start of the recording, playback from there is still possible
+		m_file.clear();
+		m_file.seekg(m_datastart);
+		m_block.clear();
+		m_blockposition = 0;
+		return std::nullopt;
+	}
+	return *lookup;
+}
+
+bool network::session_reader::next(frame_info &Frame)
+{
+	while (m_blockposition + 4 > m_block.size()) {
+		if (!read_block())
+			return false;
+	}
+
+	packet_reader length(m_block.data() + m_blockposition, 4);
+	auto const size { length.get_uint32() };
+	if (m_blockposition + 4 + size > m_block.size())
+		return false;
+
+	packet_reader input(m_block.data() + m_blockposition + 4, size);
+	m_blockposition += 4 + size;
+
+	auto const msg { deserialize_message(input) };
+	if (!msg || msg->type != message::FRAME_INFO)
+		return false;
+
+	Frame = static_cast<frame_info const &>(*msg);
+	return true;
+}
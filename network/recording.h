@@ -0,0 +1,120 @@
+/*
+This Source Code Form is subject to the
+terms of the Mozilla Public License, v.
+2.0. If a copy of the MPL was not
+distributed with this file, You can
+obtain one at
+http://mozilla.org/MPL/2.0/.
+*/
+
+#pragma once
+
+#include <fstream>
+#include <optional>
+#include "network/message.h"
+
+namespace network
+{
+	// session recording file layout:
+	// header: magic, format version, network version, seed, starting timestamp, scenario
+	// blocks: block header (raw size, compressed size, frame count, simulation time of first frame, duration, raw and compressed
+	//   size of the state snapshot), zlib-compressed simulation state snapshot if there's one, and zlib-compressed
+	//   sequence of length-prefixed frame_info records
+	// index: simulation time, frame number, file offset and state snapshot flag of each block, followed by footer with the index offset.
+	// the index is written when the recording is closed; recordings cut short are indexed by scanning the block headers
+
+	struct recording_header
+	{
+		uint32_t seed = 0;
+		int64_t timestamp = 0;
+		std::string scenario;
+	};
+
+	// keyframe of the recording, start of a compressed block
+	struct recording_keyframe
+	{
+		double time = 0.0; // simulation time at the first frame of the block
+		uint64_t frame = 0; // number of the first frame of the block
+		uint64_t offset = 0; // file offset of the block header
+		bool state = false; // the block begins with snapshot of simulation state from before its first frame
+	};
+
+	// writes frame_info stream to compressed, indexed recording file
+	class session_recorder
+	{
+	public:
+		static const size_t BLOCK_FRAMES = 512;
+		// every STATE_BLOCKS blocks the recording also receives simulation state snapshot, which lets the reader skip preceding frames
+		static const size_t STATE_BLOCKS = 2;
+
+		~session_recorder();
+
+		// creates recording file with specified header. returns true on success
+		bool open(std::string const &File, recording_header const &Header);
+		// appends frame to the recording
+		void push(frame_info const &Frame);
+		// returns true if simulation state snapshot should be provided for the block which begins with the next frame
+		bool state_due() const;
+		// attaches provided simulation state snapshot to the block which begins with the next frame
+		void push_state(std::string const &State);
+		// writes pending data and the index, closes the file
+		void close();
+		bool is_open() const {
+			return m_file.is_open(); }
+
+	private:
+		// compresses and writes accumulated frames
+		void flush_block();
+
+		std::ofstream m_file;
+		std::string m_block; // serialized frames of current block, uncompressed
+		std::string m_compressed; // scratch buffer
+		std::string m_state; // simulation state snapshot of current block, uncompressed
+		size_t m_blockframes = 0;
+		double m_blocktime = 0.0; // simulation time at the start of current block
+		double m_time = 0.0; // simulation time after the last pushed frame
+		uint64_t m_framecount = 0;
+		std::vector<recording_keyframe> m_index;
+	};
+
+	// reads frames from recording file in sequence
+	class session_reader
+	{
+	public:
+		// opens recording file and loads its index. returns true on success
+		bool open(std::string const &File);
+		recording_header const &header() const {
+			return m_header; }
+		// total number of recorded frames
+		uint64_t frame_count() const {
+			return m_framecount; }
+		// simulation time covered by the recording, in seconds
+		double duration() const {
+			return m_duration; }
+		// retrieves next frame of the recording. returns false at the end of data
+		bool next(frame_info &Frame);
+		// moves to the latest block with state snapshot which begins at or before specified simulation time,
+		// and retrieves the snapshot. returns: the located block, or empty value if there's no suitable block
+		std::optional<recording_keyframe> seek(double Time, std::string &State);
+
+	private:
+		// reads and decompresses block at current file position, including its state snapshot if provided with a target for it.
+		// returns false if there's no valid block
+		bool read_block(std::string *State = nullptr);
+		// decompresses provided data into target buffer of specified size. returns true on success
+		bool uncompress_data(std::string const &Source, std::string &Target, uint32_t const Size);
+		// builds the index by walking block headers, for recordings without one
+		void scan_blocks(uint64_t Start);
+
+		std::ifstream m_file;
+		recording_header m_header;
+		std::vector<recording_keyframe> m_index;
+		uint64_t m_datastart = 0; // offset of the first block
+		uint64_t m_dataend = 0; // offset past the last block
+		uint64_t m_framecount = 0;
+		double m_duration = 0.0;
+		std::string m_block; // decompressed data of current block
+		std::string m_compressed; // scratch buffer
+		size_t m_blockposition = 0; // read position within m_block
+	};
+}
@@ -4261,6 +4261,9 @@ opengl_renderer::Update( double const Deltatime ) {
         }
     }
 
+    // textures decoded in the background
+    m_textures.upload();
+
     if( ( true == Global.ResourceSweep )
      && ( true == simulation::is_ready ) ) {
         // garbage collection
@@ -4296,39 +4299,15 @@ opengl_renderer::info_stats() const {
 
 void
 opengl_renderer::Update_Lights( light_array &Lights ) {
-    // arrange the light array from closest to farthest from current position of the camera
+    // pick the lights closest to current position of the camera, we don't care about lights past arbitrary limit of 1 km
     auto const camera = m_renderpass.camera.position();
-    std::sort(
-        std::begin( Lights.data ),
-        std::end( Lights.data ),
-        [&camera]( light_array::light_record const &Left, light_array::light_record const &Right ) {
-            // move lights which are off at the end...
-            if( Left.intensity  == 0.f ) { return false; }
-            if( Right.intensity == 0.f ) { return true; }
-            // ...otherwise prefer closer and/or brigher light sources
-            return ( glm::length2( camera - Left.position ) / Left.intensity ) < ( glm::length2( camera - Right.position ) / Right.intensity ); } );
-
-    size_t const count = std::min( m_lights.size(), Lights.data.size() );
-    if( count == 0 ) { return; }
+    auto const &scenelights { Lights.find( camera, m_lights.size(), 1000.0 ) };
 
     auto renderlight = m_lights.begin();
 
-    for( auto const &scenelight : Lights.data ) {
+    for( auto const &scenelight : scenelights ) {
 
-        if( renderlight == m_lights.end() ) {
-            // we ran out of lights to assign
-            break;
-        }
-        if( scenelight.intensity == 0.f ) {
-            // all lights past this one are bound to be off
-            break;
-        }
         auto const lightoffset = glm::vec3{ scenelight.position - camera };
-        if( glm::length( lightoffset ) > 1000.f ) {
-            // we don't care about lights past arbitrary limit of 1 km.
-            // but there could still be weaker lights which are closer, so keep looking
-            continue;
-        }
         // if the light passed tests so far, it's good enough
         renderlight->position = lightoffset;
         renderlight->direction = scenelight.direction;
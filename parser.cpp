@@ -31,11 +31,18 @@ cParser::cParser( std::string const &Stream, buffertype const Type, std::string
     if( Type == buffertype::buffer_FILE ) {
         mFile = Stream;
     }
-    // reset pointers and attach proper type of buffer
+    // acquire content of the source in its entirety, so the tokenizer can work directly on memory buffer
     switch (Type) {
         case buffer_FILE: {
             Path.append( Stream );
-			mStream = std::make_shared<std::ifstream>( Path, std::ios_base::binary );
+            std::ifstream file( Path, std::ios_base::binary | std::ios_base::ate );
+            if( true == file.is_open() ) {
+                auto const filesize { static_cast<std::size_t>( file.tellg() ) };
+                mBuffer.resize( filesize );
+                file.seekg( 0, std::ios_base::beg );
+                file.read( &mBuffer[ 0 ], filesize );
+                mGood = ( false == file.bad() );
+            }
             // content of *.inc files is potentially grouped together
             if( ( Stream.size() >= 4 )
              && ( ToLower( Stream.substr( Stream.size() - 4 ) ) == ".inc" ) ) {
@@ -45,7 +52,8 @@ cParser::cParser( std::string const &Stream, buffertype const Type, std::string
             break;
         }
         case buffer_TEXT: {
-            mStream = std::make_shared<std::istringstream>( Stream );
+            mBuffer = Stream;
+            mGood = true;
             break;
         }
         default: {
@@ -53,16 +61,12 @@ cParser::cParser( std::string const &Stream, buffertype const Type, std::string
         }
     }
     // calculate stream size
-    if (mStream)
-    {
-        if( true == mStream->fail() ) {
-            ErrorLog( "Failed to open file \"" + Path + "\"" );
-        }
-        else {
-            mSize = mStream->rdbuf()->pubseekoff( 0, std::ios_base::end );
-            mStream->rdbuf()->pubseekoff( 0, std::ios_base::beg );
-            mLine = 1;
-        }
+    if( false == mGood ) {
+        ErrorLog( "Failed to open file \"" + Path + "\"" );
+    }
+    else {
+        mSize = mBuffer.size();
+        mLine = 1;
     }
     // set parameter set if one was provided
     if( false == Parameters.empty() ) {
@@ -196,7 +200,30 @@ std::string cParser::readToken( bool ToLower, const char *Break ) {
         // get the token yourself if the delegation attempt failed
         char c { 0 };
         do {
-            while( mStream->peek() != EOF && strchr( Break, c = mStream->get() ) == NULL ) {
+            while( false == atEnd() ) {
+                // copy run of ordinary characters in one go
+                auto const runstart { mPosition };
+                while( ( mPosition < mBuffer.size() )
+                    && ( false == isSpecial( mBuffer[ mPosition ], Break ) ) ) {
+                    ++mPosition;
+                }
+                if( mPosition > runstart ) {
+                    auto const tokenstart { token.size() };
+                    token.append( mBuffer, runstart, mPosition - runstart );
+                    if( ToLower ) {
+                        std::transform(
+                            std::begin( token ) + tokenstart, std::end( token ),
+                            std::begin( token ) + tokenstart,
+                            []( char const Char ) { return static_cast<char>( tolower( Char ) ); } );
+                    }
+                    c = mBuffer[ mPosition - 1 ];
+                    continue;
+                }
+                // separators, quotes and potential comments are processed one at a time
+                c = mBuffer[ mPosition++ ];
+                if( std::strchr( Break, c ) != nullptr ) {
+                    break;
+                }
                 if( ToLower )
                     c = tolower( c );
                 token += c;
@@ -209,7 +236,7 @@ std::string cParser::readToken( bool ToLower, const char *Break ) {
                 // update line counter
                 ++mLine;
             }
-        } while( token == "" && mStream->peek() != EOF ); // double check in case of consecutive separators
+        } while( token == "" && false == atEnd() ); // double check in case of consecutive separators
     }
     // check the first token for potential presence of utf bom
     if( mFirstToken ) {
@@ -254,6 +281,10 @@ std::string cParser::readToken( bool ToLower, const char *Break ) {
                 WriteLog("including: " + includefile);
             mIncludeParser = std::make_shared<cParser>( includefile, buffer_FILE, mPath, LoadTraction, readParameters( *this ) );
             mIncludeParser->autoclear( m_autoclear );
+            if( mSources ) {
+                mIncludeParser->mSources = mSources;
+                mSources->emplace_back( mPath + includefile );
+            }
             if( mIncludeParser->mSize <= 0 ) {
                 ErrorLog( "Bad include: can't open file \"" + includefile + "\"" );
             }
@@ -277,6 +308,10 @@ std::string cParser::readToken( bool ToLower, const char *Break ) {
                 WriteLog("including: " + includefile);
             mIncludeParser = std::make_shared<cParser>( includefile, buffer_FILE, mPath, LoadTraction, readParameters( includeparser ) );
             mIncludeParser->autoclear( m_autoclear );
+            if( mSources ) {
+                mIncludeParser->mSources = mSources;
+                mSources->emplace_back( mPath + includefile );
+            }
             if( mIncludeParser->mSize <= 0 ) {
                 ErrorLog( "Bad include: can't open file \"" + includefile + "\"" );
             }
@@ -303,8 +338,8 @@ std::string cParser::readQuotes(char const Quote) { // read the stream until spe
     std::string token = "";
     char c { 0 };
 	bool escaped = false;
-	while( mStream->peek() != EOF ) { // get all chars until the quote mark
-		c = mStream->get();
+	while( false == atEnd() ) { // get all chars until the quote mark
+		c = mBuffer[ mPosition++ ];
 
 		if (escaped) {
 			escaped = false;
@@ -327,25 +362,18 @@ std::string cParser::readQuotes(char const Quote) { // read the stream until spe
 }
 
 void cParser::skipComment( std::string const &Endmark ) { // pobieranie znaków aż do znalezienia znacznika końca
-    std::string input = "";
-    char c { 0 };
-    auto const endmarksize = Endmark.size();
-    while( mStream->peek() != EOF ) {
-        // o ile nie koniec pliku
-        c = mStream->get(); // pobranie znaku
-        if( c == '\n' ) {
-            // update line counter
-            ++mLine;
-        }
-        input += c;
-        if( input == Endmark ) // szukanie znacznika końca
-            break;
-        if( input.size() >= endmarksize ) {
-            // keep the read text short, to avoid pointless string re-allocations on longer comments
-            input = input.substr( 1 );
-        }
+    auto const commentstart { mPosition };
+    auto const endmarkpos { mBuffer.find( Endmark, mPosition ) };
+    if( endmarkpos != std::string::npos ) {
+        mPosition = endmarkpos + Endmark.size();
     }
-    return;
+    else {
+        // unterminated comment takes the rest of the file
+        mPosition = mBuffer.size();
+        atEnd();
+    }
+    // update line counter
+    mLine += std::count( std::begin( mBuffer ) + commentstart, std::begin( mBuffer ) + mPosition, '\n' );
 }
 
 bool cParser::findQuotes( std::string &String ) {
@@ -383,12 +411,15 @@ void cParser::injectString(const std::string &str)
 	else {
 		mIncludeParser = std::make_shared<cParser>( str, buffer_TEXT, "", LoadTraction );
 		mIncludeParser->autoclear( m_autoclear );
+		mIncludeParser->mSources = mSources;
 	}
 }
 
 int cParser::getProgress() const
 {
-    return static_cast<int>( mStream->rdbuf()->pubseekoff(0, std::ios_base::cur) * 100 / mSize );
+    if( mSize <= 0 ) { return 100; }
+
+    return static_cast<int>( mPosition * 100 / mSize );
 }
 
 int cParser::getFullProgress() const {
@@ -419,6 +450,11 @@ std::size_t cParser::count() {
 void cParser::addCommentStyle( std::string const &Commentstart, std::string const &Commentend ) {
 
     mComments.insert( commentmap::value_type(Commentstart, Commentend) );
+    if( false == Commentstart.empty() ) {
+        // track both letter cases, the comment can be matched against lowercased token
+        mCommentMarks += static_cast<char>( tolower( Commentstart.back() ) );
+        mCommentMarks += static_cast<char>( toupper( Commentstart.back() ) );
+    }
 }
 
 // returns name of currently open file, or empty string for text type stream
@@ -440,3 +476,33 @@ cParser::Line() const {
 int cParser::LineMain() const {
 	return mIncludeParser ? -1 : mLine;
 }
+
+// starts recording names of files opened by the parser and its include parsers
+void
+cParser::recordSources() {
+
+    if( mSources ) { return; }
+
+    mSources = std::make_shared<std::vector<std::string>>();
+    if( false == mFile.empty() ) {
+        mSources->emplace_back( mPath + mFile );
+    }
+    if( mIncludeParser ) {
+        mIncludeParser->mSources = mSources;
+    }
+}
+
+// returns names of files opened so far by the parser and its include parsers, if recording was enabled
+std::vector<std::string>
+cParser::sources() const {
+
+    if( !mSources ) { return {}; }
+
+    auto sources { *mSources };
+    // the same file can be included multiple times, with different parameters
+    std::sort( std::begin( sources ), std::end( sources ) );
+    sources.erase(
+        std::unique( std::begin( sources ), std::end( sources ) ),
+        std::end( sources ) );
+    return sources;
+}
@@ -14,6 +14,9 @@ http://mozilla.org/MPL/2.0/.
 #include <fstream>
 #include <vector>
 #include <map>
+#include <cstring>
+#include <charconv>
+#include <type_traits>
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 // cParser -- generic class for parsing text data, either from file or provided string
@@ -53,11 +56,11 @@ class cParser //: public std::stringstream
     inline
     bool
         eof() {
-            return mStream->eof(); };
+            return mEof; };
     inline
     bool
         ok() {
-            return ( !mStream->fail() ); };
+            return mGood; };
     cParser &
         autoclear( bool const Autoclear );
     inline
@@ -90,6 +93,10 @@ class cParser //: public std::stringstream
     std::size_t Line() const;
 	// returns number of currently processed line in main file, -1 if inside include
 	int LineMain() const;
+    // starts recording names of files opened by the parser and its include parsers
+    void recordSources();
+    // returns names of files opened so far by the parser and its include parsers, if recording was enabled
+    std::vector<std::string> sources() const;
 	bool expandIncludes = true;
 
   private:
@@ -101,10 +108,27 @@ class cParser //: public std::stringstream
     bool findQuotes( std::string &String );
     bool trimComments( std::string &String );
     std::size_t count();
+    // returns true if the buffer is fully processed. sets end of file flag, the same way stream peek() does
+    inline
+    bool
+        atEnd() {
+            if( mPosition < mBuffer.size() ) { return false; }
+            mEof = true;
+            return true; }
+    // returns true if specified character requires individual processing during token retrieval
+    inline
+    bool
+        isSpecial( char const Character, char const *Break ) const {
+            return ( ( Character == '\"' )
+                  || ( mCommentMarks.find( Character ) != std::string::npos )
+                  || ( std::strchr( Break, Character ) != nullptr ) ); }
     // members:
     bool m_autoclear { true }; // unretrieved tokens are discarded when another read command is issued (legacy behaviour)
     bool LoadTraction { true }; // load traction?
-    std::shared_ptr<std::istream> mStream; // relevant kind of buffer is attached on creation.
+    std::string mBuffer; // complete content of processed file or text
+    std::size_t mPosition { 0 }; // current read position in the buffer
+    bool mGood { false }; // the content was successfully acquired
+    bool mEof { false }; // attempt was made to read past the end of the buffer
     std::string mFile; // name of the open file, if any
     std::string mPath; // path to open stream, for relative path lookups.
     std::streamoff mSize { 0 }; // size of open stream, for progress report.
@@ -115,7 +139,9 @@ class cParser //: public std::stringstream
     commentmap mComments {
         commentmap::value_type( "/*", "*/" ),
         commentmap::value_type( "//", "\n" ) };
+    std::string mCommentMarks { "*/" }; // last characters of comment start markers, used to quickly skip ordinary characters
     std::shared_ptr<cParser> mIncludeParser; // child class to handle include directives.
+    std::shared_ptr<std::vector<std::string>> mSources; // names of opened files, shared with include parsers. null if not recorded
     std::vector<std::string> parameters; // parameter list for included file.
     std::deque<std::string> tokens;
 };
@@ -132,8 +158,28 @@ cParser::operator>>( Type_ &Right ) {
 
     if( true == this->tokens.empty() ) { return *this; }
 
-    std::stringstream converter( this->tokens.front() );
-    converter >> Right;
+    auto const &token { this->tokens.front() };
+    auto conversionfailed { true };
+    if constexpr( ( std::is_arithmetic<Type_>::value )
+               && ( false == std::is_same<Type_, char>::value )
+               && ( false == std::is_same<Type_, signed char>::value )
+               && ( false == std::is_same<Type_, unsigned char>::value ) ) {
+        // fast path for numeric values, skipping the stream machinery
+        auto const *first { token.data() };
+        auto const *last { token.data() + token.size() };
+        if( ( first != last ) && ( *first == '+' ) ) {
+            // unlike the stream, from_chars doesn't accept explicit plus sign
+            ++first;
+        }
+        auto const result { std::from_chars( first, last, Right ) };
+        // partially converted tokens go through the stream as well, to retain its handling of malformed values
+        conversionfailed = ( ( result.ec != std::errc() ) || ( result.ptr != last ) );
+    }
+    if( true == conversionfailed ) {
+        // fallback for non-numeric types and values in formats not handled by from_chars
+        std::stringstream converter( token );
+        converter >> Right;
+    }
     this->tokens.pop_front();
 
     return *this;
@@ -57,6 +57,8 @@ scenarioloader_mode::update() {
 	}
 	catch (invalid_scenery_exception &e) {
 		ErrorLog( "Bad init: scenario loading failed" );
+		// release the partial deserialization context along with the resources it holds
+		state.reset();
 		Application.pop_mode();
 	}
 
@@ -17,6 +17,7 @@ http://mozilla.org/MPL/2.0/.
 #include "Event.h"
 #include "EvLaunch.h"
 #include "Timer.h"
+#include "simulationtime.h"
 #include "Logs.h"
 #include "sn_utils.h"
 #include "renderer.h"
@@ -26,7 +27,7 @@ namespace scene {
 
 std::string const EU07_FILEEXTENSION_REGION { ".sbt" };
 std::uint32_t const EU07_FILEHEADER { MAKE_ID4( 'E','U','0','7' ) };
-std::uint32_t const EU07_FILEVERSION_REGION { MAKE_ID4( 'S', 'B', 'T', 1 ) };
+std::uint32_t const EU07_FILEVERSION_REGION { MAKE_ID4( 'S', 'B', 'T', 2 ) };
 
 // potentially activates event handler with the same name as provided node, and within handler activation range
 void
@@ -41,113 +42,78 @@ basic_cell::on_click( TAnimModel const *Instance ) {
     }
 }
 
-// legacy method, finds and assigns traction piece to specified pantograph of provided vehicle
-void
-basic_cell::update_traction( TDynamicObject *Vehicle, int const Pantographindex ) {
-    // Winger 170204 - szukanie trakcji nad pantografami
-    auto const vFront = glm::make_vec3( Vehicle->VectorFront().getArray() ); // wektor normalny dla płaszczyzny ruchu pantografu
-    auto const vUp = glm::make_vec3( Vehicle->VectorUp().getArray() ); // wektor pionu pudła (pochylony od pionu na przechyłce)
-    auto const vLeft = glm::make_vec3( Vehicle->VectorLeft().getArray() ); // wektor odległości w bok (odchylony od poziomu na przechyłce)
-    auto const position = glm::dvec3 { Vehicle->GetPosition() }; // współrzędne środka pojazdu
-
-    auto pantograph = Vehicle->pants[ Pantographindex ].fParamPants;
-    auto const pantographposition = position + ( vLeft * pantograph->vPos.z ) + ( vUp * pantograph->vPos.y ) + ( vFront * pantograph->vPos.x );
-    
-    for( auto *traction : m_directories.traction ) {
-
-        // współczynniki równania parametrycznego
-        auto const paramfrontdot = glm::dot( traction->vParametric, vFront );
-        auto const fRaParam =
-            -( glm::dot( traction->pPoint1, vFront ) - glm::dot( pantographposition, vFront ) )
-            / ( paramfrontdot != 0.0 ?
-                    paramfrontdot :
-                    0.001 ); // div0 trap
-
-        if( ( fRaParam < -0.001 )
-         || ( fRaParam >  1.001 ) ) { continue; }
-        // jeśli tylko jest w przedziale, wyznaczyć odległość wzdłuż wektorów vUp i vLeft
-        // punkt styku płaszczyzny z drutem (dla generatora łuku el.)
-        auto const vStyk = traction->pPoint1 + fRaParam * traction->vParametric;
-        // wektor musi się mieścić w przedziale ruchu pantografu
-        auto const vGdzie = vStyk - pantographposition;
-        auto fVertical = glm::dot( vGdzie, vUp );
-        if( fVertical >= 0.0 ) {
-            // jeśli ponad pantografem (bo może łapać druty spod wiaduktu)
-            auto const fHorizontal = std::abs( glm::dot( vGdzie, vLeft ) ) - pantograph->fWidth;
-
-            if( ( Global.bEnableTraction )
-             && ( fVertical < pantograph->PantWys - 0.15 ) ) {
-                // jeśli drut jest niżej niż 15cm pod ślizgiem przełączamy w tryb połamania, o ile jedzie;
-                // (bEnableTraction) aby dało się jeździć na koślawych sceneriach
-                // i do tego jeszcze wejdzie pod ślizg
-                if( fHorizontal <= 0.0 ) {
-                    // 0.635 dla AKP-1 AKP-4E
-                    SetFlag( Vehicle->MoverParameters->DamageFlag, dtrain_pantograph );
-                    pantograph->PantWys = -1.0; // ujemna liczba oznacza połamanie
-                    pantograph->hvPowerWire = nullptr; // bo inaczej się zasila w nieskończoność z połamanego
-                    if( Vehicle->MoverParameters->EnginePowerSource.CollectorParameters.CollectorsNo > 0 ) {
-                        // liczba pantografów teraz będzie mniejsza
-                        --Vehicle->MoverParameters->EnginePowerSource.CollectorParameters.CollectorsNo;
-                    }
-                    ErrorLog( "Bad traction: " + Vehicle->name() + " broke pantograph at " + to_string( pantographposition ), logtype::traction );
-
-                }
-            }
-            else if( fVertical < pantograph->PantTraction ) {
-                // ale niżej, niż poprzednio znaleziony
-                if( fHorizontal <= 0.0 ) {
-                    // 0.635 dla AKP-1 AKP-4E
-                    // to się musi mieścić w przedziale zaleznym od szerokości pantografu
-                    pantograph->hvPowerWire = traction; // jakiś znaleziony
-                    pantograph->PantTraction = fVertical; // zapamiętanie nowej wysokości
-                }
-                else if( fHorizontal < pantograph->fWidthExtra ) {
-                    // czy zmieścił się w zakresie nabieżnika? problem jest, gdy nowy drut jest wyżej,
-                    // wtedy pantograf odłącza się od starego, a na podniesienie do nowego potrzebuje czasu
-                    // korekta wysokości o nabieżnik - drut nad nabieżnikiem jest geometrycznie jakby nieco wyżej
-                    fVertical += 0.15 * fHorizontal / pantograph->fWidthExtra;
-                    if( fVertical < pantograph->PantTraction ) {
-                        // gdy po korekcie jest niżej, niż poprzednio znaleziony
-                        // gdyby to wystarczyło, to możemy go uznać
-                        pantograph->hvPowerWire = traction; // może być
-                        pantograph->PantTraction = fVertical; // na razie liniowo na nabieżniku, dokładność poprawi się później
-                    }
-                }
-            }
-        }
-    }
-}
-
 // legacy method, updates sounds and polls event launchers within radius around specified point
 void
 basic_cell::update_events() {
 
     // event launchers
-    for( auto *launcher : m_eventlaunchers ) {
-        glm::dvec3 campos = Global.pCamera.Pos;
-        double radius = launcher->dRadius;
-        if (launcher->train_triggered && simulation::Train) {
-            campos = simulation::Train->Dynamic()->HeadPosition();
-            radius *= Timer::GetDeltaTime() * simulation::Train->Dynamic()->GetVelocity() * 0.277;
-        }
-
+    // launchers activated periodically
+    auto spentlauncher { false };
+    for( auto *launcher : m_periodiclaunchers ) {
         if( launcher->check_conditions()
-            && ( radius < 0.0
-                || glm::distance2( launcher->location(), campos ) < launcher->dRadius ) ) {
+         && is_in_range( launcher ) ) {
             if( launcher->check_activation() )
                 launch_event( launcher, true );
+        }
+        spentlauncher |= launcher->IsSpent();
+    }
+    if( true == spentlauncher ) {
+        // single activation launchers won't be activated by time again, no point to keep polling them
+        m_periodiclaunchers.erase(
+            std::remove_if(
+                std::begin( m_periodiclaunchers ), std::end( m_periodiclaunchers ),
+                []( TEventLauncher const *Launcher ) {
+                    return Launcher->IsSpent(); } ),
+            std::end( m_periodiclaunchers ) );
+    }
+    // launchers activated at specific time of day, only the ones scheduled for current minute are tested
+    if( false == m_scheduledlaunchers.empty() ) {
+        auto const &time { simulation::Time.data() };
+        auto const duelaunchers { m_scheduledlaunchers.due( time.wHour * 60 + time.wMinute ) };
+        for( auto launcheriter { duelaunchers.first }; launcheriter != duelaunchers.second; ++launcheriter ) {
+            auto *launcher { *launcheriter };
+            if( launcher->check_conditions()
+             && is_in_range( launcher ) ) {
+                if( launcher->check_activation() )
+                    launch_event( launcher, true );
+            }
+        }
+    }
+    // launchers activated by key press
+    for( auto *launcher : m_keylaunchers ) {
+        if( launcher->check_conditions()
+         && is_in_range( launcher ) ) {
             if( launcher->check_activation_key() )
                 launch_event( launcher, true );
         }
     }
 }
 
-// legacy method, updates sounds and polls event launchers within radius around specified point
+// checks whether specified launcher is within activation range. returns: true if the launcher can be activated
+bool
+basic_cell::is_in_range( TEventLauncher const *Launcher ) const {
+
+    glm::dvec3 campos = Global.pCamera.Pos;
+    double radius = Launcher->dRadius;
+    if (Launcher->train_triggered && simulation::Train) {
+        campos = simulation::Train->Dynamic()->HeadPosition();
+        radius *= Timer::GetDeltaTime() * simulation::Train->Dynamic()->GetVelocity() * 0.277;
+    }
+
+    return ( radius < 0.0
+          || glm::distance2( Launcher->location(), campos ) < Launcher->dRadius );
+}
+
+// legacy method, updates sounds which can be heard from specified point
 void
-basic_cell::update_sounds() {
+basic_cell::update_sounds( glm::dvec3 const &Location ) {
 
-    for( auto *sound : m_sounds ) {
-        sound->play_event();
+    auto const soundrange { m_area.radius + m_soundrange };
+    if( glm::length2( m_area.center - Location ) <= soundrange * soundrange ) {
+        // skip scenery sounds if none of them can reach the listener
+        for( auto *sound : m_sounds ) {
+            sound->play_event();
+        }
     }
     // TBD, TODO: move to sound renderer
     for( auto *path : m_paths ) {
@@ -384,6 +350,13 @@ basic_cell::insert( sound_source *Sound ) {
 
     m_sounds.emplace_back( Sound );
     // NOTE: sound sources are virtual 'points' hence they don't ever expand cell range
+    // but we keep track of their reach, to skip processing of cells with sounds which can't be heard
+    auto const range { Sound->range() };
+    m_soundrange = std::max(
+        m_soundrange,
+        ( range == -1 ?
+            std::numeric_limits<float>::max() : // unlimited range
+            std::min( 2750.f, std::abs( range * 5 ) ) ) ); // cutoff range used by the sound source
 }
 
 // adds provided sound instance to the cell
@@ -393,6 +366,16 @@ basic_cell::insert( TEventLauncher *Launcher ) {
     m_active = true;
 
     m_eventlaunchers.emplace_back( Launcher );
+    // sort the launcher into groups based on its activation triggers
+    if( true == Launcher->IsPeriodic() ) {
+        m_periodiclaunchers.emplace_back( Launcher );
+    }
+    if( Launcher->activation_minute() >= 0 ) {
+        m_scheduledlaunchers.insert( Launcher );
+    }
+    if( true == Launcher->IsKeyActivated() ) {
+        m_keylaunchers.emplace_back( Launcher );
+    }
     // re-calculate cell bounding area, in case launcher range extends outside the cell's boundaries
     enclose_area( Launcher );
 }
@@ -688,10 +671,10 @@ basic_section::on_click( TAnimModel const *Instance ) {
     cell( Instance->location() ).on_click( Instance );
 }
 
-// legacy method, finds and assigns traction piece(s) to pantographs of provided vehicle
-void
+// legacy method, finds and assigns traction piece(s) to pantographs of provided vehicle. returns: number of tested traction pieces
+std::size_t
 basic_section::update_traction( TDynamicObject *Vehicle, int const Pantographindex ) {
-
+    // Winger 170204 - szukanie trakcji nad pantografami
     auto const vFront = glm::make_vec3( Vehicle->VectorFront().getArray() ); // wektor normalny dla płaszczyzny ruchu pantografu
     auto const vUp = glm::make_vec3( Vehicle->VectorUp().getArray() ); // wektor pionu pudła (pochylony od pionu na przechyłce)
     auto const vLeft = glm::make_vec3( Vehicle->VectorLeft().getArray() ); // wektor odległości w bok (odchylony od poziomu na przechyłce)
@@ -700,12 +683,143 @@ basic_section::update_traction( TDynamicObject *Vehicle, int const Pantographind
     auto pantograph = Vehicle->pants[ Pantographindex ].fParamPants;
     auto const pantographposition = position + ( vLeft * pantograph->vPos.z ) + ( vUp * pantograph->vPos.y ) + ( vFront * pantograph->vPos.x );
 
-    auto const radius { EU07_CELLSIZE * 0.5 }; // redius around point of interest
+    if( true == m_tractionindex.is_dirty ) {
+        build_traction_index();
+    }
+    if( true == m_tractionindex.items.empty() ) { return 0; }
+    // only pieces stored in the grid bucket enclosing the pantograph can be located within its range
+    auto const gridorigin { m_area.center - glm::dvec3{ 0.5 * EU07_SECTIONSIZE + traction_index::border } };
+    auto const column { static_cast<int>( std::floor( ( pantographposition.x - gridorigin.x ) / traction_index::bucket_size ) ) };
+    auto const row { static_cast<int>( std::floor( ( pantographposition.z - gridorigin.z ) / traction_index::bucket_size ) ) };
+    if( ( column < 0 ) || ( column >= traction_index::grid_size )
+     || ( row < 0 ) || ( row >= traction_index::grid_size ) ) {
+        return 0;
+    }
+    auto const bucket { row * traction_index::grid_size + column };
+    auto const candidatesbegin { std::begin( m_tractionindex.items ) + m_tractionindex.bucket_offsets[ bucket ] };
+    auto const candidatesend { std::begin( m_tractionindex.items ) + m_tractionindex.bucket_offsets[ bucket + 1 ] };
+
+    for( auto candidate = candidatesbegin; candidate != candidatesend; ++candidate ) {
 
-    for( auto &cell : m_cells ) {
-        // we reject early cells which aren't within our area of interest
-        if( glm::length2( cell.area().center - pantographposition ) < ( ( cell.area().radius + radius ) * ( cell.area().radius + radius ) ) ) {
-            cell.update_traction( Vehicle, Pantographindex );
+        auto *traction { *candidate };
+        // współczynniki równania parametrycznego
+        auto const paramfrontdot = glm::dot( traction->vParametric, vFront );
+        auto const fRaParam =
+            -( glm::dot( traction->pPoint1, vFront ) - glm::dot( pantographposition, vFront ) )
+            / ( paramfrontdot != 0.0 ?
+                    paramfrontdot :
+                    0.001 ); // div0 trap
+
+        if( ( fRaParam < -0.001 )
+         || ( fRaParam >  1.001 ) ) { continue; }
+        // jeśli tylko jest w przedziale, wyznaczyć odległość wzdłuż wektorów vUp i vLeft
+        // punkt styku płaszczyzny z drutem (dla generatora łuku el.)
+        auto const vStyk = traction->pPoint1 + fRaParam * traction->vParametric;
+        // wektor musi się mieścić w przedziale ruchu pantografu
+        auto const vGdzie = vStyk - pantographposition;
+        auto fVertical = glm::dot( vGdzie, vUp );
+        if( fVertical >= 0.0 ) {
+            // jeśli ponad pantografem (bo może łapać druty spod wiaduktu)
+            auto const fHorizontal = std::abs( glm::dot( vGdzie, vLeft ) ) - pantograph->fWidth;
+
+            if( ( Global.bEnableTraction )
+             && ( fVertical < pantograph->PantWys - 0.15 ) ) {
+                // jeśli drut jest niżej niż 15cm pod ślizgiem przełączamy w tryb połamania, o ile jedzie;
+                // (bEnableTraction) aby dało się jeździć na koślawych sceneriach
+                // i do tego jeszcze wejdzie pod ślizg
+                if( fHorizontal <= 0.0 ) {
+                    // 0.635 dla AKP-1 AKP-4E
+                    SetFlag( Vehicle->MoverParameters->DamageFlag, dtrain_pantograph );
+                    pantograph->PantWys = -1.0; // ujemna liczba oznacza połamanie
+                    pantograph->hvPowerWire = nullptr; // bo inaczej się zasila w nieskończoność z połamanego
+                    if( Vehicle->MoverParameters->EnginePowerSource.CollectorParameters.CollectorsNo > 0 ) {
+                        // liczba pantografów teraz będzie mniejsza
+                        --Vehicle->MoverParameters->EnginePowerSource.CollectorParameters.CollectorsNo;
+                    }
+                    ErrorLog( "Bad traction: " + Vehicle->name() + " broke pantograph at " + to_string( pantographposition ), logtype::traction );
+
+                }
+            }
+            else if( fVertical < pantograph->PantTraction ) {
+                // ale niżej, niż poprzednio znaleziony
+                if( fHorizontal <= 0.0 ) {
+                    // 0.635 dla AKP-1 AKP-4E
+                    // to się musi mieścić w przedziale zaleznym od szerokości pantografu
+                    pantograph->hvPowerWire = traction; // jakiś znaleziony
+                    pantograph->PantTraction = fVertical; // zapamiętanie nowej wysokości
+                }
+                else if( fHorizontal < pantograph->fWidthExtra ) {
+                    // czy zmieścił się w zakresie nabieżnika? problem jest, gdy nowy drut jest wyżej,
+                    // wtedy pantograf odłącza się od starego, a na podniesienie do nowego potrzebuje czasu
+                    // korekta wysokości o nabieżnik - drut nad nabieżnikiem jest geometrycznie jakby nieco wyżej
+                    fVertical += 0.15 * fHorizontal / pantograph->fWidthExtra;
+                    if( fVertical < pantograph->PantTraction ) {
+                        // gdy po korekcie jest niżej, niż poprzednio znaleziony
+                        // gdyby to wystarczyło, to możemy go uznać
+                        pantograph->hvPowerWire = traction; // może być
+                        pantograph->PantTraction = fVertical; // na razie liniowo na nabieżniku, dokładność poprawi się później
+                    }
+                }
+            }
+        }
+    }
+
+    return std::distance( candidatesbegin, candidatesend );
+}
+
+// registers provided traction piece in the lookup directory of the section enclosing specified point, and in the traction search index
+void
+basic_section::register_node( TTraction *Node, glm::dvec3 const &Point ) {
+
+    cell( Point ).register_end( Node );
+    // pieces with both ends inside the section are registered twice, duplicates are filtered out when the index is built
+    m_tractionindex.pieces.emplace_back( Node );
+    m_tractionindex.is_dirty = true;
+}
+
+// (re)builds traction search index from registered traction pieces
+void
+basic_section::build_traction_index() {
+
+    auto &index { m_tractionindex };
+    index.is_dirty = false;
+
+    std::sort( std::begin( index.pieces ), std::end( index.pieces ) );
+    index.pieces.erase(
+        std::unique( std::begin( index.pieces ), std::end( index.pieces ) ),
+        std::end( index.pieces ) );
+
+    auto const gridorigin { m_area.center - glm::dvec3{ 0.5 * EU07_SECTIONSIZE + traction_index::border } };
+    // grid range covered by horizontal bounding box of a piece, expanded by search margin
+    auto const bucketrange = [&]( TTraction const *Traction ) {
+        auto const min { glm::min( Traction->pPoint1, Traction->pPoint2 ) - gridorigin - static_cast<double>( traction_index::margin ) };
+        auto const max { glm::max( Traction->pPoint1, Traction->pPoint2 ) - gridorigin + static_cast<double>( traction_index::margin ) };
+        // NOTE: pieces outside of the grid produce empty ranges
+        return glm::ivec4 {
+            clamp( static_cast<int>( std::floor( min.x / traction_index::bucket_size ) ), 0, traction_index::grid_size ),
+            clamp( static_cast<int>( std::floor( min.z / traction_index::bucket_size ) ), 0, traction_index::grid_size ),
+            clamp( static_cast<int>( std::floor( max.x / traction_index::bucket_size ) ), -1, traction_index::grid_size - 1 ),
+            clamp( static_cast<int>( std::floor( max.z / traction_index::bucket_size ) ), -1, traction_index::grid_size - 1 ) }; };
+    // two passes, first establishes size of each bucket, second fills them
+    index.bucket_offsets.assign( traction_index::grid_size * traction_index::grid_size + 1, 0 );
+    for( auto const *traction : index.pieces ) {
+        auto const range { bucketrange( traction ) };
+        for( auto row = range.y; row <= range.w; ++row ) {
+            for( auto column = range.x; column <= range.z; ++column ) {
+                ++index.bucket_offsets[ row * traction_index::grid_size + column + 1 ];
+            }
+        }
+    }
+    std::partial_sum( std::begin( index.bucket_offsets ), std::end( index.bucket_offsets ), std::begin( index.bucket_offsets ) );
+
+    index.items.resize( index.bucket_offsets.back() );
+    auto fillpoints { index.bucket_offsets };
+    for( auto *traction : index.pieces ) {
+        auto const range { bucketrange( traction ) };
+        for( auto row = range.y; row <= range.w; ++row ) {
+            for( auto column = range.x; column <= range.z; ++column ) {
+                index.items[ fillpoints[ row * traction_index::grid_size + column ]++ ] = traction;
+            }
         }
     }
 }
@@ -731,7 +845,7 @@ basic_section::update_sounds( glm::dvec3 const &Location, float const Radius ) {
 
         if( glm::length2( cell.area().center - Location ) < ( ( cell.area().radius + Radius ) * ( cell.area().radius + Radius ) ) ) {
             // we reject cells which aren't within our area of interest
-            cell.update_sounds();
+            cell.update_sounds( Location );
         }
     }
 }
@@ -1068,9 +1182,10 @@ basic_region::update_traction( TDynamicObject *Vehicle, int const Pantographinde
     auto const pant0 = position + ( vLeft * p->vPos.z ) + ( vUp * p->vPos.y ) + ( vFront * p->vPos.x );
     p->PantTraction = std::numeric_limits<double>::max(); // taka za duża wartość
 
+    ++m_tractionstats.searches;
     auto const &sectionlist = sections( pant0, EU07_CELLSIZE * 0.5 );
     for( auto *section : sectionlist ) {
-        section->update_traction( Vehicle, Pantographindex );
+        m_tractionstats.candidates += section->update_traction( Vehicle, Pantographindex );
     }
 }
 
@@ -1101,13 +1216,32 @@ basic_region::is_scene( std::string const &Scenariofile ) const {
         // wrong file type
         return false;
     }
+    // source files check; the region data is usable only if none of the files it was built from was modified
+    // content of a file is hashed only if its modification time changed, unchanged files cost a single stat call
+    auto sourcecount { sn_utils::ld_uint32( input ) };
+    while( sourcecount-- ) {
+        std::string sourcefile;
+        std::getline( input, sourcefile, '\0' );
+        auto const sourcesize { sn_utils::ld_uint64( input ) };
+        auto const sourcetime { sn_utils::ld_uint64( input ) };
+        auto const sourcehash { sn_utils::ld_uint64( input ) };
+        if( false == input.good() ) {
+            return false;
+        }
+        if( ( file_size( sourcefile ) != sourcesize )
+         || ( ( static_cast<std::uint64_t>( last_modified( sourcefile ) ) != sourcetime )
+           && ( content_hash( sourcefile ) != sourcehash ) ) ) {
+            WriteLog( "Region data file \"" + filename + "\" is out of date with source file \"" + sourcefile + "\"" );
+            return false;
+        }
+    }
 
     return true;
 }
 
 // stores content of the class in file with specified name
 void
-basic_region::serialize( std::string const &Scenariofile ) const {
+basic_region::serialize( std::string const &Scenariofile, std::vector<std::string> const &Sources ) const {
 
     auto filename { Scenariofile };
     while( filename[ 0 ] == '$' ) {
@@ -1120,10 +1254,18 @@ basic_region::serialize( std::string const &Scenariofile ) const {
 
     std::ofstream output { filename, std::ios::binary };
 
-    // region file version 1
+    // region file version 2
     // header: EU07SBT + version (0-255)
     sn_utils::ls_uint32( output, EU07_FILEHEADER );
     sn_utils::ls_uint32( output, EU07_FILEVERSION_REGION );
+    // source files: count, followed by file name, size, modification time and content hash for each file
+    sn_utils::ls_uint32( output, static_cast<std::uint32_t>( Sources.size() ) );
+    for( auto const &source : Sources ) {
+        sn_utils::s_str( output, source );
+        sn_utils::ls_uint64( output, file_size( source ) );
+        sn_utils::ls_uint64( output, static_cast<std::uint64_t>( last_modified( source ) ) );
+        sn_utils::ls_uint64( output, content_hash( source ) );
+    }
     // sections
     // TBD, TODO: build table of sections and file offsets, if we postpone section loading until they're within range
     std::uint32_t sectioncount { 0 };
@@ -1160,7 +1302,7 @@ basic_region::deserialize( std::string const &Scenariofile ) {
     if( false == FileExists( filename ) ) {
         return false;
     }
-    // region file version 1
+    // region file version 2
     // file type and version check
     std::ifstream input( filename, std::ios::binary );
 
@@ -1173,6 +1315,15 @@ basic_region::deserialize( std::string const &Scenariofile ) {
         WriteLog( "Bad file: \"" + filename + "\" is of either unrecognized type or version" );
         return false;
     }
+    // source files; validated by is_scene() check, skip them here
+    auto sourcecount { sn_utils::ld_uint32( input ) };
+    while( sourcecount-- ) {
+        std::string sourcefile;
+        std::getline( input, sourcefile, '\0' );
+        sn_utils::ld_uint64( input );
+        sn_utils::ld_uint64( input );
+        sn_utils::ld_uint64( input );
+    }
     // sections
     // TBD, TODO: build table of sections and file offsets, if we postpone section loading until they're within range
     // section count
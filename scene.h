@@ -21,6 +21,7 @@ http://mozilla.org/MPL/2.0/.
 #include "Track.h"
 #include "Traction.h"
 #include "sound.h"
+#include "EvLaunch.h"
 #include "command.h"
 
 class opengl_renderer;
@@ -37,6 +38,7 @@ struct scratch_data {
     struct binary_data {
 
         bool terrain{ false };
+        std::vector<std::string> sources; // files contributing to binary data, aside from scenario text files
     } binary;
 
     struct location_data {
@@ -61,6 +63,7 @@ struct scratch_data {
     std::string name;
     bool initialized { false };
 	bool time_initialized { false };
+    bool models_loadnow { true }; // false if models can be loaded in the background
 };
 
 // basic element of rudimentary partitioning scheme for the section. fixed size, no further subdivision
@@ -77,15 +80,12 @@ public:
     // potentially activates event handler with the same name as provided node, and within handler activation range
     void
         on_click( TAnimModel const *Instance );
-    // legacy method, finds and assigns traction piece to specified pantograph of provided vehicle
-    void
-        update_traction( TDynamicObject *Vehicle, int const Pantographindex );
     // legacy method, polls event launchers within radius around specified point
     void
         update_events();
-    // legacy method, updates sounds within radius around specified point
+    // legacy method, updates sounds which can be heard from specified point
     void
-        update_sounds();
+        update_sounds( glm::dvec3 const &Location );
     // legacy method, triggers radio-stop procedure for all vehicles located on paths in the cell
     void
         radio_stop();
@@ -180,6 +180,9 @@ private:
 // methods
     void
 	    launch_event(TEventLauncher *Launcher, bool local_only);
+    // checks whether specified launcher is within activation range. returns: true if the launcher can be activated
+    bool
+        is_in_range( TEventLauncher const *Launcher ) const;
     void
         enclose_area( scene::basic_node *Node );
 // members
@@ -193,7 +196,12 @@ private:
     instance_sequence m_instancetranslucent;
     traction_sequence m_traction;
     sound_sequence m_sounds;
+    float m_soundrange { 0.f }; // cutoff range of the farthest reaching sound in the cell
     eventlauncher_sequence m_eventlaunchers;
+    // event launchers grouped by activation trigger; launchers without any trigger are activated only on click
+    eventlauncher_sequence m_periodiclaunchers; // launchers activated in regular intervals, or once
+    launcher_schedule m_scheduledlaunchers; // launchers activated at specific time of day
+    eventlauncher_sequence m_keylaunchers; // launchers activated by key press
     memorycell_sequence m_memorycells;
     // search helpers
     struct lookup_data {
@@ -220,8 +228,8 @@ public:
     // potentially activates event handler with the same name as provided node, and within handler activation range
     void
         on_click( TAnimModel const *Instance );
-    // legacy method, finds and assigns traction piece to specified pantograph of provided vehicle
-    void
+    // legacy method, finds and assigns traction piece to specified pantograph of provided vehicle. returns: number of tested traction pieces
+    std::size_t
         update_traction( TDynamicObject *Vehicle, int const Pantographindex );
     // legacy method, updates sounds and polls event launchers within radius around specified point
     void
@@ -269,6 +277,9 @@ public:
     void
         register_node( Type_ *Node, glm::dvec3 const &Point ) {
             cell( Point ).register_end( Node ); }
+    // registers provided traction piece in the lookup directory of the section enclosing specified point, and in the traction search index
+    void
+        register_node( TTraction *Node, glm::dvec3 const &Point );
     // find a vehicle located nearest to specified point, within specified radius. reurns: located vehicle and distance
     std::tuple<TDynamicObject *, float>
         find( glm::dvec3 const &Point, float const Radius, bool const Onlycontrolled, bool const Findbycoupler );
@@ -304,16 +315,33 @@ private:
 // types
     using cell_array = std::array<basic_cell, (EU07_SECTIONSIZE / EU07_CELLSIZE) * (EU07_SECTIONSIZE / EU07_CELLSIZE)>;
     using shapenode_sequence = std::vector<shape_node>;
+    using traction_sequence = std::vector<TTraction *>;
+    // uniform grid of traction pieces, used to limit pantograph searches to wires in the vicinity of the pantograph
+    struct traction_index {
+        static int const bucket_size { 25 }; // edge of grid bucket, in metres
+        static int const border { EU07_CELLSIZE / 2 }; // extra coverage outside of section bounds, matches search radius of the region
+        static int const margin { 10 }; // horizontal slack added to wire spans, covers pantograph width and wire offset on canted track
+        static int const grid_size { ( EU07_SECTIONSIZE + 2 * border ) / bucket_size };
+
+        traction_sequence pieces; // registered traction pieces, source data for the grid
+        std::vector<std::uint32_t> bucket_offsets; // start of bucket content in the item table, with extra end marker
+        traction_sequence items; // content of all buckets, arranged sequentially
+        bool is_dirty { false };
+    };
 // methods
     // provides access to section enclosing specified point
     basic_cell &
 	    cell(glm::dvec3 const &Location, const glm::ivec2 &offset = glm::ivec2(0));
+    // (re)builds traction search index from registered traction pieces
+    void
+        build_traction_index();
 // members
     // placement and visibility
 
     scene::bounding_area m_area { glm::dvec3(), static_cast<float>( 0.5 * M_SQRT2 * EU07_SECTIONSIZE ) };
     // content
     cell_array m_cells; // partitioning scheme
+    traction_index m_tractionindex; // search helper for pantographs
     shapenode_sequence m_shapes; // large pieces of opaque geometry and (legacy) terrain
     // TODO: implement dedicated, higher fidelity, fixed resolution terrain mesh item
 	// gfx renderer data
@@ -330,6 +358,12 @@ class basic_region {
     friend opengl33_renderer;
 
 public:
+// types
+    // pantograph search counters
+    struct traction_statistics {
+        std::uint64_t searches { 0 }; // number of wire searches performed for pantographs without assigned wire
+        std::uint64_t candidates { 0 }; // number of traction pieces tested during these searches
+    };
 // constructors
     basic_region();
 // destructor
@@ -341,18 +375,22 @@ public:
     // legacy method, finds and assigns traction piece to specified pantograph of provided vehicle
     void
         update_traction( TDynamicObject *Vehicle, int const Pantographindex );
+    // provides access to pantograph search counters
+    traction_statistics const &
+        traction_stats() const {
+            return m_tractionstats; }
     // legacy method, polls event launchers around camera
     void
         update_events();
     // legacy method, updates sounds around camera
     void
         update_sounds();
-    // checks whether specified file is a valid region data file
+    // checks whether specified file is a valid region data file, up to date with its source files
     bool
         is_scene( std::string const &Scenariofile ) const;
-    // stores content of the class in file with specified name
+    // stores content of the class in file with specified name, along with content hashes of provided source files
     void
-        serialize( std::string const &Scenariofile ) const;
+        serialize( std::string const &Scenariofile, std::vector<std::string> const &Sources ) const;
     // restores content of the class from file with specified name. returns: true on success, false otherwise
     bool
         deserialize( std::string const &Scenariofile );
@@ -449,6 +487,7 @@ private:
 // members
     section_array m_sections;
     region_scratchpad m_scratchpad;
+    traction_statistics m_tractionstats;
 
 };
 
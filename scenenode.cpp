@@ -102,7 +102,7 @@ shape_node::shapenode_data::deserialize( std::istream &Input ) {
     translucent = sn_utils::d_bool( Input );
     auto const materialname { sn_utils::d_str( Input ) };
     if( false == materialname.empty() ) {
-        material = GfxRenderer->Fetch_Material( materialname );
+        material = GfxRenderer->Fetch_Material( materialname, false );
     }
     lighting.deserialize( Input );
     // geometry
@@ -192,7 +192,7 @@ shape_node::import( cParser &Input, scene::node_data const &Nodedata ) {
 
     // assigned material
 	replace_slashes(token);
-	m_data.material = GfxRenderer->Fetch_Material( token );
+	m_data.material = GfxRenderer->Fetch_Material( token, false );
 
     // determine way to proceed from the assigned diffuse texture
     // TBT, TODO: add methods to material manager to access these simpler
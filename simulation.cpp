@@ -11,6 +11,7 @@ http://mozilla.org/MPL/2.0/.
 #include "simulation.h"
 #include "simulationtime.h"
 #include "simulationenvironment.h"
+#include "simulationsounds.h"
 
 #include "Globals.h"
 #include "Event.h"
@@ -20,6 +21,7 @@ http://mozilla.org/MPL/2.0/.
 #include "TractionPower.h"
 #include "sound.h"
 #include "AnimModel.h"
+#include "MdlMngr.h"
 #include "DynObj.h"
 #include "lightarray.h"
 #include "particles.h"
@@ -72,6 +74,45 @@ state_manager::export_as_text( std::string const &Scenariofile ) const {
     return m_serializer.export_as_text( Scenariofile );
 }
 
+// sends dynamic state of the loaded scenario to provided stream, in binary format
+void
+state_manager::serialize_state( std::ostream &Output ) const {
+
+    return m_serializer.serialize_state( Output );
+}
+
+// restores dynamic state of the loaded scenario from provided stream. returns: true on success
+bool
+state_manager::deserialize_state( std::istream &Input ) {
+
+    return m_serializer.deserialize_state( Input );
+}
+
+// returns true if the dynamic state of the loaded scenario can be fully captured by serialize_state()
+bool
+state_manager::is_state_complete() const {
+
+    return m_serializer.is_state_complete();
+}
+
+// loads shared data tables used by the simulation
+void
+state_manager::init_data() {
+
+    // HACK: grab content of the first {} block in load_unit_weights using temporary parser, then parse it normally. on any error our weight list will be empty string
+    auto loadweights { cParser( cParser( "data/load_weights.txt", cParser::buffer_FILE ).getToken<std::string>( true, "{}" ), cParser::buffer_TEXT ) };
+    while( true == loadweights.getTokens( 2 ) ) {
+        std::pair<std::string, float> weightpair;
+        loadweights
+            >> weightpair.first
+            >> weightpair.second;
+        weightpair.first.erase( weightpair.first.end() - 1 ); // trim trailing ':' from the key
+        simulation::Weights.emplace( weightpair.first, weightpair.second );
+    }
+    cParser override_parser( "data/sound_overrides.txt", cParser::buffer_FILE );
+    deserialize_map( simulation::Sound_overrides,  override_parser);
+}
+
 void
 state_manager::init_scripting_interface() {
 
@@ -481,7 +522,32 @@ void state_manager::process_commands() {
 }
 
 TAnimModel * state_manager::create_model(const std::string &src, const std::string &name, const glm::dvec3 &position) {
-	return m_serializer.create_model(src, name, position);
+	auto *instance { m_serializer.create_model(src, name, position) };
+	if( ( instance != nullptr )
+	 && ( instance->Model() != nullptr )
+	 && ( true == instance->Model()->is_loading() ) ) {
+		// render phases of the instance depend on model data, so it'll be placed in the scene again once the model is ready
+		m_pendinginstances.emplace_back( instance );
+	}
+	return instance;
+}
+
+// completes setup of models loaded in the background, and adds instances waiting for them to the scene
+void state_manager::update_models() {
+
+	TModelsManager::update();
+
+	m_pendinginstances.erase(
+		std::remove_if(
+			std::begin( m_pendinginstances ), std::end( m_pendinginstances ),
+			[]( TAnimModel *Instance ) {
+				if( true == Instance->Model()->is_loading() ) {
+					return false;
+				}
+				Instance->BindLights();
+				Region->insert( Instance );
+				return true; } ),
+		std::end( m_pendinginstances ) );
 }
 
 TEventLauncher * state_manager::create_eventlauncher(const std::string &src, const std::string &name, const glm::dvec3 &position) {
@@ -489,6 +555,9 @@ TEventLauncher * state_manager::create_eventlauncher(const std::string &src, con
 }
 
 void state_manager::delete_model(TAnimModel *model) {
+	m_pendinginstances.erase(
+		std::remove( std::begin( m_pendinginstances ), std::end( m_pendinginstances ), model ),
+		std::end( m_pendinginstances ) );
 	Region->erase(model);
 	Instances.purge(model);
 }
@@ -25,6 +25,9 @@ class state_manager {
 
 public:
 // methods
+    // loads shared data tables used by the simulation
+    void
+        init_data();
     void
         init_scripting_interface();
     // legacy method, calculates changes in simulation state over specified time
@@ -37,6 +40,9 @@ public:
     // process input commands
     void
         process_commands();
+    // completes setup of models loaded in the background, and adds instances waiting for them to the scene
+    void
+        update_models();
  	// create model from node string
 	TAnimModel *
 	    create_model(const std::string &src, const std::string &name, const glm::dvec3 &position);
@@ -58,10 +64,20 @@ public:
     // stores class data in specified file, in legacy (text) format
     void
         export_as_text( std::string const &Scenariofile ) const;
+    // sends dynamic state of the loaded scenario to provided stream, in binary format
+    void
+        serialize_state( std::ostream &Output ) const;
+    // restores dynamic state of the loaded scenario from provided stream. returns: true on success
+    bool
+        deserialize_state( std::istream &Input );
+    // returns true if the dynamic state of the loaded scenario can be fully captured by serialize_state()
+    bool
+        is_state_complete() const;
 
 private:
 // members
     state_serializer m_serializer;
+    std::vector<TAnimModel *> m_pendinginstances; // instances waiting for their models to load
     struct {
         std::shared_ptr<TMemCell> weather, time, date;
     } m_scriptinginterface;
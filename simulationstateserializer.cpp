@@ -26,7 +26,10 @@ http://mozilla.org/MPL/2.0/.
 #include "TractionPower.h"
 #include "application.h"
 #include "renderer.h"
+#include "Timer.h"
 #include "Logs.h"
+#include "sn_utils.h"
+#include "utilities.h"
 
 namespace simulation {
 
@@ -53,6 +56,10 @@ state_serializer::deserialize_begin( std::string const &Scenariofile ) {
         // compilation to binary file isn't supported for rainsted-created overrides
         // NOTE: we postpone actual loading of the scene until we process time, season and weather data
 		state->scratchpad.binary.terrain = Region->is_scene( Scenariofile ) ;
+        if( false == state->scratchpad.binary.terrain ) {
+            // keep track of source files, so the binary version created from them can be validated on later runs
+            state->input.recordSources();
+        }
     }
 
     scene::Groups.create();
@@ -143,7 +150,11 @@ state_serializer::deserialize_continue(std::shared_ptr<deserializer_state> state
 	 && ( state->scenariofile != "$.scn" ) ) {
 		// if we didn't find usable binary version of the scenario files, create them now for future use
 		// as long as the scenario file wasn't rainsted-created base file override
-		Region->serialize( state->scenariofile );
+		auto sources { state->input.sources() };
+		sources.insert(
+			std::end( sources ),
+			std::begin( state->scratchpad.binary.sources ), std::end( state->scratchpad.binary.sources ) );
+		Region->serialize( state->scenariofile, sources );
 	}
 
 	return false;
@@ -153,12 +164,12 @@ void
 state_serializer::deserialize_area( cParser &Input, scene::scratch_data &Scratchpad ) {
     // first parameter specifies name of parent piece...
     auto token { Input.getToken<std::string>() };
-    auto *groupowner { TIsolated::Find( token ) };
+    auto *groupowner { simulation::Paths.isolated().find_or_insert( token ) };
     // ...followed by list of its children
     while( ( false == ( token = Input.getToken<std::string>() ).empty() )
         && ( token != "endarea" ) ) {
         // bind the children with their parent
-        auto *isolated { TIsolated::Find( token ) };
+        auto *isolated { simulation::Paths.isolated().find_or_insert( token ) };
         isolated->parent( groupowner );
     }
 }
@@ -472,6 +483,14 @@ state_serializer::deserialize_node( cParser &Input, scene::scratch_data &Scratch
                 auto *instance = deserialize_model( Input, Scratchpad, nodedata );
                 // model import can potentially fail
                 if( instance == nullptr ) { return; }
+                if( instance->Model() != nullptr ) {
+                    // terrain geometry ends up in the binary region file, so the model is one of its sources
+                    auto const modelfile { instance->Model()->NameGet() };
+                    Scratchpad.binary.sources.emplace_back(
+                        FileExists( modelfile + ".e3d" ) ?
+                            modelfile + ".e3d" :
+                            modelfile + ".t3d" );
+                }
                 // go through submodels, and import them as shapes
                 auto const cellcount = instance->TerrainCount() + 1; // zliczenie submodeli
                 for( auto i = 1; i < cellcount; ++i ) {
@@ -859,7 +878,7 @@ state_serializer::deserialize_model( cParser &Input, scene::scratch_data &Scratc
     auto *instance = new TAnimModel( Nodedata );
     instance->Angles( Scratchpad.location.rotation + rotation ); // dostosowanie do pochylania linii
 
-    if( instance->Load( &Input, false ) ) {
+    if( instance->Load( &Input, false, Scratchpad.models_loadnow ) ) {
         instance->location( transform( location, Scratchpad ) );
     }
     else {
@@ -1180,6 +1199,206 @@ state_serializer::export_nodes_to_stream(std::ostream &scmfile, bool Dirty) cons
 	}
 }
 
+std::uint32_t const EU07_FILEHEADER { MAKE_ID4( 'E','U','0','7' ) };
+std::uint32_t const EU07_FILEVERSION_STATE { MAKE_ID4( 'S', 'T', 'A', 1 ) };
+
+// sends dynamic state of the loaded scenario to provided stream, in binary format
+// NOTE: covers elements which change during the simulation; static content is provided by the scenario itself
+void
+state_serializer::serialize_state( std::ostream &Output ) const {
+
+    sn_utils::ls_uint32( Output, EU07_FILEHEADER );
+    sn_utils::ls_uint32( Output, EU07_FILEVERSION_STATE );
+    sn_utils::s_str( Output, Global.SceneryFile );
+    // clocks
+    sn_utils::ls_float64( Output, Timer::GetTime() );
+    std::ostringstream timestate;
+    Time.serialize_state( timestate );
+    sn_utils::s_str( Output, timestate.str() );
+    std::ostringstream randomstate;
+    randomstate << Global.random_engine;
+    sn_utils::s_str( Output, randomstate.str() );
+    // memory cells
+    std::vector<TMemCell const *> memorycells;
+    for( auto const *memorycell : Memory.sequence() ) {
+        if( memorycell != nullptr ) {
+            memorycells.emplace_back( memorycell );
+        }
+    }
+    sn_utils::ls_uint32( Output, static_cast<std::uint32_t>( memorycells.size() ) );
+    for( auto const *memorycell : memorycells ) {
+        sn_utils::s_str( Output, memorycell->name() );
+        sn_utils::s_str( Output, memorycell->Text() );
+        sn_utils::ls_float64( Output, memorycell->Value1() );
+        sn_utils::ls_float64( Output, memorycell->Value2() );
+    }
+    // switches
+    std::vector<TTrack *> switches;
+    for( auto *path : Paths.sequence() ) {
+        if( ( path != nullptr ) && ( path->eType == tt_Switch ) ) {
+            switches.emplace_back( path );
+        }
+    }
+    sn_utils::ls_uint32( Output, static_cast<std::uint32_t>( switches.size() ) );
+    for( auto *path : switches ) {
+        sn_utils::s_str( Output, path->name() );
+        sn_utils::ls_int32( Output, path->GetSwitchState() );
+    }
+    // vehicles
+    std::vector<TDynamicObject const *> vehicles;
+    for( auto const *vehicle : Vehicles.sequence() ) {
+        if( vehicle != nullptr ) {
+            vehicles.emplace_back( vehicle );
+        }
+    }
+    sn_utils::ls_uint32( Output, static_cast<std::uint32_t>( vehicles.size() ) );
+    for( auto const *vehicle : vehicles ) {
+        sn_utils::s_str( Output, vehicle->name() );
+        // vehicle data is stored as a block, so it can be set aside until the whole state is verified
+        std::ostringstream vehiclestate;
+        vehicle->serialize_state( vehiclestate );
+        for( int side = end::front; side <= end::rear; ++side ) {
+            auto const &coupler { vehicle->MoverParameters->Couplers[ side ] };
+            sn_utils::ls_int32( vehiclestate, coupler.CouplingFlag );
+            sn_utils::s_str( vehiclestate, ( coupler.Connected != nullptr ? coupler.Connected->Name : "" ) );
+            sn_utils::ls_int32( vehiclestate, coupler.ConnectedNr );
+        }
+        sn_utils::s_str( Output, vehiclestate.str() );
+    }
+    // events
+    Events.serialize_queue( Output );
+}
+
+// returns true if the dynamic state of the loaded scenario can be fully captured by serialize_state()
+// NOTE: internals of vehicle drivers (ai or not) and brake handles they operate, activation state of global launchers
+// and held continuous commands aren't serialized, so the state is only complete while none of these is in play
+bool
+state_serializer::is_state_complete() const {
+
+    for( auto const *vehicle : Vehicles.sequence() ) {
+        if( ( vehicle != nullptr )
+         && ( vehicle->Mechanik != nullptr ) ) {
+            return false;
+        }
+    }
+    if( true == Events.has_global_launchers() ) { return false; }
+    if( true == Commands.is_continuous_active() ) { return false; }
+
+    return true;
+}
+
+// restores dynamic state of the loaded scenario from provided stream. returns: true on success
+// NOTE: content of the stream is verified before any changes are made, so on failure the simulation is left as it was
+bool
+state_serializer::deserialize_state( std::istream &Input ) {
+
+    auto const headermain { sn_utils::ld_uint32( Input ) };
+    auto const headertype { sn_utils::ld_uint32( Input ) };
+    if( ( headermain != EU07_FILEHEADER )
+     || ( headertype != EU07_FILEVERSION_STATE ) ) {
+        ErrorLog( "Bad state: unsupported format of simulation state data" );
+        return false;
+    }
+    auto const scenario { sn_utils::d_str( Input ) };
+    if( scenario != Global.SceneryFile ) {
+        ErrorLog( "Bad state: simulation state data was made for scenario \"" + scenario + "\"" );
+        return false;
+    }
+    // clocks
+    auto const time { sn_utils::ld_float64( Input ) };
+    auto const timestate { sn_utils::d_str( Input ) };
+    auto const randomstate { sn_utils::d_str( Input ) };
+    // memory cells
+    std::vector<std::tuple<TMemCell *, std::string, double, double>> memorycells;
+    auto const memorycellcount { sn_utils::ld_uint32( Input ) };
+    for( std::uint32_t idx = 0; ( idx < memorycellcount ) && ( true == Input.good() ); ++idx ) {
+        auto const name { sn_utils::d_str( Input ) };
+        auto const text { sn_utils::d_str( Input ) };
+        auto const value1 { sn_utils::ld_float64( Input ) };
+        auto const value2 { sn_utils::ld_float64( Input ) };
+        auto *memorycell { Memory.find( name ) };
+        if( memorycell == nullptr ) {
+            ErrorLog( "Bad state: can't find memory cell \"" + name + "\"" );
+            return false;
+        }
+        memorycells.emplace_back( memorycell, text, value1, value2 );
+    }
+    // switches
+    std::vector<std::pair<TTrack *, int>> switches;
+    auto const switchcount { sn_utils::ld_uint32( Input ) };
+    for( std::uint32_t idx = 0; ( idx < switchcount ) && ( true == Input.good() ); ++idx ) {
+        auto const name { sn_utils::d_str( Input ) };
+        auto const state { sn_utils::ld_int32( Input ) };
+        auto *path { Paths.find( name ) };
+        if( path == nullptr ) {
+            ErrorLog( "Bad state: can't find track \"" + name + "\"" );
+            return false;
+        }
+        switches.emplace_back( path, state );
+    }
+    // vehicles
+    std::vector<std::pair<TDynamicObject *, std::string>> vehicles;
+    auto const vehiclecount { sn_utils::ld_uint32( Input ) };
+    for( std::uint32_t idx = 0; ( idx < vehiclecount ) && ( true == Input.good() ); ++idx ) {
+        auto const name { sn_utils::d_str( Input ) };
+        auto *vehicle { Vehicles.find( name ) };
+        if( vehicle == nullptr ) {
+            ErrorLog( "Bad state: can't find vehicle \"" + name + "\"" );
+            return false;
+        }
+        vehicles.emplace_back( vehicle, sn_utils::d_str( Input ) );
+    }
+    // events
+    auto const eventqueue { Events.read_queue( Input ) };
+    if( ( false == Input.good() )
+     || ( false == eventqueue.has_value() ) ) {
+        ErrorLog( "Bad state: simulation state data is incomplete" );
+        return false;
+    }
+
+    // all good, apply the state
+    Timer::set_time( time );
+    std::istringstream timestream { timestate };
+    Time.deserialize_state( timestream );
+    std::istringstream randomstream { randomstate };
+    randomstream >> Global.random_engine;
+    for( auto const &memorycell : memorycells ) {
+        std::get<TMemCell *>( memorycell )->UpdateValues(
+            std::get<1>( memorycell ), std::get<2>( memorycell ), std::get<3>( memorycell ),
+            basic_event::flags::text | basic_event::flags::value1 | basic_event::flags::value2 );
+    }
+    for( auto const &pathswitch : switches ) {
+        if( pathswitch.first->GetSwitchState() != pathswitch.second ) {
+            pathswitch.first->Switch( pathswitch.second );
+        }
+    }
+    for( auto const &vehicle : vehicles ) {
+        std::istringstream vehiclestate { vehicle.second };
+        if( false == vehicle.first->deserialize_state( vehiclestate ) ) {
+            ErrorLog( "Bad state: failed to restore vehicle \"" + vehicle.first->name() + "\"" );
+        }
+        // couplings are restored as they are, without the checks and side effects of the coupling operations
+        for( int side = end::front; side <= end::rear; ++side ) {
+            auto &coupler { vehicle.first->MoverParameters->Couplers[ side ] };
+            coupler.CouplingFlag = sn_utils::ld_int32( vehiclestate );
+            auto const connectedname { sn_utils::d_str( vehiclestate ) };
+            coupler.ConnectedNr = sn_utils::ld_int32( vehiclestate );
+            auto const *connected { (
+                connectedname.empty() ?
+                    nullptr :
+                    Vehicles.find( connectedname ) ) };
+            coupler.Connected = (
+                connected != nullptr ?
+                    connected->MoverParameters :
+                    nullptr );
+        }
+    }
+    // NOTE: the query is restored after the memory cells, replacing whatever the cell listeners put in it
+    Events.apply_queue( *eventqueue );
+
+    return true;
+}
+
 TAnimModel *state_serializer::create_model(const std::string &src, const std::string &name, const glm::dvec3 &position) {
 	cParser parser(src);
 	parser.getTokens(); // "node"
@@ -1193,6 +1412,8 @@ TAnimModel *state_serializer::create_model(const std::string &src, const std::st
 	nodedata.type = "model";
 
 	scene::scratch_data scratch;
+    // don't stall the running simulation, the instance will be shown once its model is ready
+    scratch.models_loadnow = false;
 
 	TAnimModel *cloned = deserialize_model(parser, scratch, nodedata);
 
@@ -41,6 +41,15 @@ public:
     // stores class data in specified file, in legacy (text) format
     void
         export_as_text( std::string const &Scenariofile ) const;
+    // sends dynamic state of the loaded scenario to provided stream, in binary format
+    void
+        serialize_state( std::ostream &Output ) const;
+    // restores dynamic state of the loaded scenario from provided stream. returns: true on success
+    bool
+        deserialize_state( std::istream &Input );
+    // returns true if the dynamic state of the loaded scenario can be fully captured by serialize_state()
+    bool
+        is_state_complete() const;
 	// create new model from node stirng
 	TAnimModel * create_model(std::string const &src, std::string const &name, const glm::dvec3 &position);
 	// create new eventlauncher from node stirng
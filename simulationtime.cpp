@@ -12,6 +12,7 @@ http://mozilla.org/MPL/2.0/.
 
 #include "Globals.h"
 #include "utilities.h"
+#include "sn_utils.h"
 
 namespace simulation {
 
@@ -192,6 +193,34 @@ void scenario_time::set_time(int yearday, int minute) {
 	m_time.wMinute = minute % 60;
 }
 
+// sends current time to provided stream
+void
+scenario_time::serialize_state( std::ostream &Output ) const {
+
+    for( auto const field : {
+        m_time.wYear, m_time.wMonth, m_time.wDayOfWeek, m_time.wDay,
+        m_time.wHour, m_time.wMinute, m_time.wSecond, m_time.wMilliseconds } ) {
+        sn_utils::ls_uint16( Output, field );
+    }
+    sn_utils::ls_float64( Output, m_milliseconds );
+    sn_utils::ls_int32( Output, m_yearday );
+    sn_utils::ls_float64( Output, m_timezonebias );
+}
+
+// restores current time from provided stream
+void
+scenario_time::deserialize_state( std::istream &Input ) {
+
+    for( auto *field : {
+        &m_time.wYear, &m_time.wMonth, &m_time.wDayOfWeek, &m_time.wDay,
+        &m_time.wHour, &m_time.wMinute, &m_time.wSecond, &m_time.wMilliseconds } ) {
+        *field = sn_utils::ld_uint16( Input );
+    }
+    m_milliseconds = sn_utils::ld_float64( Input );
+    m_yearday = sn_utils::ld_int32( Input );
+    m_timezonebias = sn_utils::ld_float64( Input );
+}
+
 // calculates day of week for provided date
 int
 scenario_time::day_of_week( int const Day, int const Month, int const Year ) const {
@@ -47,6 +47,12 @@ public:
             return m_timezonebias; }
 	void
 	    set_time(int yearday, int minute);
+    // sends current time to provided stream
+    void
+        serialize_state( std::ostream &Output ) const;
+    // restores current time from provided stream
+    void
+        deserialize_state( std::istream &Input );
 
     /** Returns std::string in format: `"mm:ss"`. */
     operator std::string();
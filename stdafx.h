@@ -69,6 +69,7 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <future>
 #include <typeinfo>
 #include <bitset>
 #include <chrono>
@@ -88,7 +88,7 @@ void ui_log_panel::render_contents()
 {
 	ImGui::PushFont(ui_layer::font_mono);
 
-    for (const std::string &s : log_scrollback)
+    for (const std::string &s : LogScrollback())
         ImGui::TextUnformatted(s.c_str());
     if (ImGui::GetScrollY() == ImGui::GetScrollMaxY())
 		ImGui::SetScrollHereY(1.0f);
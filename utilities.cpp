@@ -431,6 +431,36 @@ last_modified( std::string const &Filename ) {
 		return 0;
 }
 
+// returns size of specified file, or 0 if the file doesn't exist
+std::uint64_t
+file_size( std::string const &Filename ) {
+    struct stat filestat;
+    if( ::stat( Filename.c_str(), &filestat ) == 0 )
+		return static_cast<std::uint64_t>( filestat.st_size );
+    else
+		return 0;
+}
+
+// returns hash of the content of specified file, or 0 if the file can't be read
+std::uint64_t
+content_hash( std::string const &Filename ) {
+
+    std::ifstream file( Filename, std::ios::binary );
+    if( false == file.is_open() ) { return 0; }
+    // 64-bit FNV-1a
+    std::uint64_t hash { 0xcbf29ce484222325ULL };
+    std::array<char, 64 * 1024> buffer;
+    while( file ) {
+        file.read( buffer.data(), buffer.size() );
+        auto const size { file.gcount() };
+        for( std::streamsize idx = 0; idx < size; ++idx ) {
+            hash ^= static_cast<std::uint8_t>( buffer[ idx ] );
+            hash *= 0x100000001b3ULL;
+        }
+    }
+    return hash;
+}
+
 // potentially erases file extension from provided file name. returns: true if extension was removed, false otherwise
 bool
 erase_extension( std::string &Filename ) {
@@ -565,3 +595,124 @@ int count_trailing_zeros( uint32_t val )
 
     return r;
 }
+
+namespace threading {
+
+void
+worker_pool::start( int Workercount ) {
+
+    stop();
+
+    if( Workercount <= 0 ) {
+        // leave one core for the main thread
+        Workercount = std::max( 1, static_cast<int>( std::thread::hardware_concurrency() ) - 1 );
+    }
+    m_exit = false;
+    m_workers.reserve( Workercount );
+    for( int idx = 0; idx < Workercount; ++idx ) {
+        m_workers.emplace_back( &worker_pool::run, this );
+    }
+}
+
+void
+worker_pool::stop() {
+
+    {
+        std::lock_guard<std::mutex> lock( m_jobsmutex );
+        m_exit = true;
+    }
+    m_jobscondition.notify_all();
+    for( auto &worker : m_workers ) {
+        if( worker.joinable() ) {
+            worker.join();
+        }
+    }
+    m_workers.clear();
+}
+
+void
+worker_pool::push( job_type Job ) {
+
+    if( m_workers.empty() ) {
+        // no workers to pick the job up, do it ourselves
+        Job();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock( m_jobsmutex );
+        m_jobs.emplace_back( std::move( Job ) );
+    }
+    m_jobscondition.notify_one();
+}
+
+void
+worker_pool::parallel_for( std::size_t const Count, std::function<void( std::size_t )> const &Job ) {
+
+    if( Count == 0 ) { return; }
+
+    if( ( m_workers.empty() )
+     || ( Count == 1 ) ) {
+        for( std::size_t idx = 0; idx < Count; ++idx ) {
+            Job( idx );
+        }
+        return;
+    }
+
+    struct batch_state {
+        std::atomic<std::size_t> next { 0 };
+        std::size_t pending { 0 }; // helpers which didn't finish yet
+        std::mutex mutex;
+        std::condition_variable condition;
+    };
+    auto batch { std::make_shared<batch_state>() };
+    auto const helpercount { std::min<std::size_t>( m_workers.size(), Count - 1 ) };
+    batch->pending = helpercount;
+
+    auto const work = [ batch, Count, &Job ]() {
+        std::size_t idx;
+        while( ( idx = batch->next.fetch_add( 1 ) ) < Count ) {
+            Job( idx );
+        } };
+
+    for( std::size_t helper = 0; helper < helpercount; ++helper ) {
+        push(
+            [ batch, work ]() {
+                work();
+                {
+                    std::lock_guard<std::mutex> lock( batch->mutex );
+                    --batch->pending;
+                }
+                batch->condition.notify_one(); } );
+    }
+    // take part in the work, then wait for the helpers to wrap up
+    work();
+    std::unique_lock<std::mutex> lock( batch->mutex );
+    batch->condition.wait(
+        lock,
+        [ &batch ]() {
+            return batch->pending == 0; } );
+}
+
+void
+worker_pool::run() {
+
+    while( true ) {
+        job_type job;
+        {
+            std::unique_lock<std::mutex> lock( m_jobsmutex );
+            m_jobscondition.wait(
+                lock,
+                [ this ]() {
+                    return ( m_exit || ( false == m_jobs.empty() ) ); } );
+            if( m_jobs.empty() ) {
+                // exit requested and there's nothing left to do
+                return;
+            }
+            job = std::move( m_jobs.front() );
+            m_jobs.pop_front();
+        }
+        job();
+    }
+}
+
+} // threading
@@ -211,6 +211,12 @@ std::pair<std::string, std::string> FileExists( std::vector<std::string> const &
 // returns time of last modification for specified file
 std::time_t last_modified( std::string const &Filename );
 
+// returns size of specified file, or 0 if the file doesn't exist
+std::uint64_t file_size( std::string const &Filename );
+
+// returns hash of the content of specified file, or 0 if the file can't be read
+std::uint64_t content_hash( std::string const &Filename );
+
 // potentially erases file extension from provided file name. returns: true if extension was removed, false otherwise
 bool
 erase_extension( std::string &Filename );
@@ -451,6 +457,51 @@ private:
     bool m_spurious { true };
 };
 
+// fixed set of worker threads executing queued jobs
+// NOTE: jobs are executed in unspecified order, and must not throw
+class worker_pool {
+
+public:
+// types
+    using job_type = std::function<void()>;
+// constructors
+    worker_pool() = default;
+    worker_pool( worker_pool const & ) = delete;
+    worker_pool &operator=( worker_pool const & ) = delete;
+// destructor
+    ~worker_pool() {
+        stop(); }
+// methods
+    // launches specified number of worker threads. 0 picks count based on available hardware
+    void
+        start( int Workercount = 0 );
+    // finishes queued jobs and terminates worker threads
+    void
+        stop();
+    // adds provided job to the queue
+    void
+        push( job_type Job );
+    // executes Job for each index in range [0, Count), returns after all calls are completed
+    // NOTE: calling thread takes part in the work, if the pool isn't running all work is done by the caller
+    void
+        parallel_for( std::size_t const Count, std::function<void( std::size_t )> const &Job );
+    // number of active worker threads
+    int
+        size() const {
+            return static_cast<int>( m_workers.size() ); }
+
+private:
+// methods
+    void
+        run();
+// members
+    std::vector<std::thread> m_workers;
+    std::deque<job_type> m_jobs;
+    std::mutex m_jobsmutex;
+    std::condition_variable m_jobscondition;
+    bool m_exit { false };
+};
+
 } // threading
 
 //---------------------------------------------------------------------------
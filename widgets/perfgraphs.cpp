@@ -1,6 +1,9 @@
 #include "stdafx.h"
 #include "widgets/perfgraphs.h"
 #include "Timer.h"
+#include "simulation.h"
+#include "Train.h"
+#include "PyInt.h"
 
 perfgraph_panel::perfgraph_panel()
     : ui_panel(STR("Performance"), false)
@@ -59,4 +62,36 @@ void perfgraph_panel::render_contents() {
 
 	ImGui::SliderFloat(STR_C("Range"), &max, 0.1f, 250.0f);
 	ImGui::PlotLines("##timer", &history[0], history.size(), pos, label.c_str(), 0.0f, max, ImVec2(500, 200));
+
+	render_screens();
+}
+
+void perfgraph_panel::render_screens() {
+	if (!simulation::Train || simulation::Train->screens().empty())
+		return;
+
+	if (!ImGui::CollapsingHeader(STR_C("Python screens")))
+		return;
+
+	ImGui::Columns(6);
+	ImGui::TextUnformatted(STR_C("Screen")); ImGui::NextColumn();
+	ImGui::TextUnformatted(STR_C("Requests")); ImGui::NextColumn();
+	ImGui::TextUnformatted(STR_C("Renders")); ImGui::NextColumn();
+	ImGui::TextUnformatted(STR_C("Dropped")); ImGui::NextColumn();
+	ImGui::TextUnformatted(STR_C("Late")); ImGui::NextColumn();
+	ImGui::TextUnformatted(STR_C("Latency")); ImGui::NextColumn();
+	ImGui::Separator();
+
+	for (auto const &screen : simulation::Train->screens()) {
+		if (!screen.rt)
+			continue;
+		auto const &rt { *screen.rt };
+		ImGui::TextUnformatted((screen.target + " (" + screen.script + ")").c_str()); ImGui::NextColumn();
+		ImGui::Text("%u", rt.requests.load()); ImGui::NextColumn();
+		ImGui::Text("%u", rt.renders.load()); ImGui::NextColumn();
+		ImGui::Text("%u", rt.drops.load()); ImGui::NextColumn();
+		ImGui::Text("%u", rt.late.load()); ImGui::NextColumn();
+		ImGui::Text("%.1f / %.1f ms", rt.latency.load() * 1000.f, rt.peaklatency.load() * 1000.f); ImGui::NextColumn();
+	}
+	ImGui::Columns(1);
 }
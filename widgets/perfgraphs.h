@@ -42,4 +42,8 @@ class perfgraph_panel : public ui_panel
 	perfgraph_panel();
 
 	void render_contents() override;
+
+  private:
+	// per-screen scheduling statistics of the python renderers in the current cab
+	void render_screens();
 };